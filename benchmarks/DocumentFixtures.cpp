@@ -0,0 +1,96 @@
+// <copyright company="Scythe Studio Sp. z o.o.">
+//     This file contains proprietary code. Copyright (c) 2021. All rights reserved.
+// </copyright>
+
+#include "DocumentFixtures.h"
+#include "datasets/CsvReader.h"
+#include <QStringList>
+#include <QTemporaryFile>
+#include <QTextStream>
+
+#define DATE_FORMAT "d-M-yyyy"
+
+namespace {
+
+// lines are written to a temporary file and read back, so documents go through the same parser as imported files.
+template <typename Document>
+QList<Document> readDocuments(int count, QString (*line)(int),
+                              Document (*parseNormal)(const CsvReader &), Document (*parseRecurrent)(const CsvReader &))
+{
+    QList<Document> documents;
+    QTemporaryFile file;
+    if (!file.open()) {
+        return documents;
+    }
+
+    QTextStream out(&file);
+    for (int i = 0; i < count; ++i) {
+        out << line(i) << '\n';
+    }
+    out.flush();
+    file.close();
+
+    CsvReader reader(file.fileName());
+    if (!reader.open()) {
+        return documents;
+    }
+
+    documents.reserve(count);
+    for (int i = 0; reader.readRow(); ++i) {
+        documents << (parseRecurrent && i % 50 == 0 ? parseRecurrent(reader) : parseNormal(reader));
+    }
+    return documents;
+}
+
+} // namespace
+
+namespace DocumentFixtures {
+
+QString invoiceLine(int i)
+{
+    const QDate &date = FIRST_DATE.addDays(i % NUMBER_OF_DAYS);
+    return QStringList {
+        QString("INV-%1").arg(i), QString("Customer %1").arg(i % 500), STATUSES[i % 4],
+        date.toString(DATE_FORMAT), date.addDays(14).toString(DATE_FORMAT),
+        QString::number(100 + i % 10000), CURRENCIES[i % 4]
+    }.join(',');
+}
+
+QString expenseLine(int i)
+{
+    const QString &date = FIRST_DATE.addDays(i % NUMBER_OF_DAYS).toString(DATE_FORMAT);
+    const bool isRecurrent = i % 50 == 0;
+    return QStringList {
+        QString("E-%1").arg(i), "active", QString("Category %1").arg(i % 40), QString("Vendor %1").arg(i % 500),
+        isRecurrent ? "TRUE" : "FALSE", isRecurrent ? (i % 100 == 0 ? "weeks" : "months") : "",
+        date, isRecurrent ? date : "", QString::number(20 + i % 1000), CURRENCIES[i % 4]
+    }.join(',');
+}
+
+QString billLine(int i)
+{
+    const QDate &date = FIRST_DATE.addDays(i % NUMBER_OF_DAYS);
+    const bool isRecurrent = i % 50 == 0;
+    return QStringList {
+        QString("B-%1").arg(i), QString("Vendor %1").arg(i % 500), isRecurrent ? "TRUE" : "FALSE", "open",
+        isRecurrent ? "months" : "", date.toString(DATE_FORMAT), date.addDays(30).toString(DATE_FORMAT),
+        isRecurrent ? date.toString(DATE_FORMAT) : "", QString::number(50 + i % 5000), CURRENCIES[i % 4]
+    }.join(',');
+}
+
+QList<Invoice> makeInvoices(int count)
+{
+    return readDocuments<Invoice>(count, invoiceLine, &Invoice::parseInvoice, nullptr);
+}
+
+QList<Expense> makeExpenses(int count)
+{
+    return readDocuments<Expense>(count, expenseLine, &Expense::parseNormalExpense, &Expense::parseRecurrentExpense);
+}
+
+QList<Bill> makeBills(int count)
+{
+    return readDocuments<Bill>(count, billLine, &Bill::parseNormalBill, &Bill::parseRecurringBill);
+}
+
+} // namespace DocumentFixtures
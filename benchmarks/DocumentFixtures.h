@@ -0,0 +1,64 @@
+// <copyright company="Scythe Studio Sp. z o.o.">
+//     This file contains proprietary code. Copyright (c) 2021. All rights reserved.
+// </copyright>
+
+#ifndef DOCUMENTFIXTURES_H
+#define DOCUMENTFIXTURES_H
+
+#include <QDate>
+#include <QList>
+#include <QString>
+#include "datasets/Bill.h"
+#include "datasets/Expense.h"
+#include "datasets/Invoice.h"
+
+/*!
+ * \brief Documents shared by the benchmarks. Every document depends only on its index: two years of documents,
+ * every 50th expense and bill is recurrent. Lines are in the layout of the CSV files bundled with the application.
+ */
+namespace DocumentFixtures {
+
+const char *const CURRENCIES[] = {"PLN", "EUR", "USD", "GBP"};
+const char *const STATUSES[] = {"paid", "overdue", "sent", "draft"};
+const QDate FIRST_DATE(2020, 1, 1);
+const int NUMBER_OF_DAYS = 730;
+
+/*!
+ * \brief Returns a line of invoices.csv.
+ * \param int i -- index of the invoice.
+ */
+QString invoiceLine(int i);
+
+/*!
+ * \brief Returns a line of expenses in the columns of normalExpenses.csv and recurrentExpenses.csv.
+ * \param int i -- index of the expense.
+ */
+QString expenseLine(int i);
+
+/*!
+ * \brief Returns a line of bills in the columns of normalBills.csv and recurrentBills.csv.
+ * \param int i -- index of the bill.
+ */
+QString billLine(int i);
+
+/*!
+ * \brief Returns invoices read through CsvReader, the same way the application imports them.
+ * \param int count -- number of invoices.
+ */
+QList<Invoice> makeInvoices(int count);
+
+/*!
+ * \brief Returns expenses read through CsvReader, the same way the application imports them.
+ * \param int count -- number of expenses.
+ */
+QList<Expense> makeExpenses(int count);
+
+/*!
+ * \brief Returns bills read through CsvReader, the same way the application imports them.
+ * \param int count -- number of bills.
+ */
+QList<Bill> makeBills(int count);
+
+} // namespace DocumentFixtures
+
+#endif // DOCUMENTFIXTURES_H
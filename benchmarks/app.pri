@@ -0,0 +1,75 @@
+# <copyright company="Scythe Studio Sp. z o.o.">
+#     This file contains proprietary code. Copyright (c) 2021. All rights reserved.
+#</copyright>
+
+# Sources of the application engine, without main window and widgets.
+
+QT += core gui widgets charts network concurrent
+
+CONFIG += c++11
+
+SRC_DIR = $$PWD/../src
+INCLUDEPATH += $$SRC_DIR
+
+SOURCES += \
+    $$SRC_DIR/datasets/Bill.cpp \
+    $$SRC_DIR/datasets/ColumnKernels.cpp \
+    $$SRC_DIR/datasets/CompactFields.cpp \
+    $$SRC_DIR/datasets/CsvReader.cpp \
+    $$SRC_DIR/datasets/Expense.cpp \
+    $$SRC_DIR/datasets/Invoice.cpp \
+    $$SRC_DIR/datasets/Recurrence.cpp \
+    $$SRC_DIR/datasets/TransactionStore.cpp \
+    $$SRC_DIR/LogicController.cpp \
+    $$SRC_DIR/Settings.cpp \
+    $$SRC_DIR/SnapshotStore.cpp \
+    $$SRC_DIR/WebClient.cpp \
+    $$SRC_DIR/models/BillsModel.cpp \
+    $$SRC_DIR/models/DisplayStringCache.cpp \
+    $$SRC_DIR/models/ExpensesModel.cpp \
+    $$SRC_DIR/models/FilteredTotal.cpp \
+    $$SRC_DIR/models/ForecastingModel.cpp \
+    $$SRC_DIR/models/InvoicesModel.cpp \
+    $$SRC_DIR/models/SearchIndex.cpp \
+    $$SRC_DIR/models/SortKeyCache.cpp \
+    $$SRC_DIR/plotting/CashFlowChart.cpp \
+    $$SRC_DIR/plotting/Downsampler.cpp \
+    $$SRC_DIR/plotting/ForecastEngine.cpp \
+    $$SRC_DIR/plotting/PeriodEngine.cpp
+
+HEADERS += \
+    $$SRC_DIR/datasets/Bill.h \
+    $$SRC_DIR/datasets/ColumnKernels.h \
+    $$SRC_DIR/datasets/CompactFields.h \
+    $$SRC_DIR/datasets/CsvReader.h \
+    $$SRC_DIR/datasets/DocumentRange.h \
+    $$SRC_DIR/datasets/Expense.h \
+    $$SRC_DIR/datasets/Invoice.h \
+    $$SRC_DIR/datasets/JsonFields.h \
+    $$SRC_DIR/datasets/Recurrence.h \
+    $$SRC_DIR/datasets/TransactionStore.h \
+    $$SRC_DIR/LogicController.h \
+    $$SRC_DIR/Settings.h \
+    $$SRC_DIR/SnapshotStore.h \
+    $$SRC_DIR/WebClient.h \
+    $$SRC_DIR/models/BillsModel.h \
+    $$SRC_DIR/models/DisplayStringCache.h \
+    $$SRC_DIR/models/ExpensesModel.h \
+    $$SRC_DIR/models/FilteredTotal.h \
+    $$SRC_DIR/models/ForecastingModel.h \
+    $$SRC_DIR/models/InvoicesModel.h \
+    $$SRC_DIR/models/SearchIndex.h \
+    $$SRC_DIR/models/SortKeyCache.h \
+    $$SRC_DIR/plotting/CashFlowChart.h \
+    $$SRC_DIR/plotting/Downsampler.h \
+    $$SRC_DIR/plotting/ForecastEngine.h \
+    $$SRC_DIR/plotting/PeriodEngine.h
+
+# Documents shared by the benchmarks.
+INCLUDEPATH += $$PWD
+
+SOURCES += \
+    $$PWD/DocumentFixtures.cpp
+
+HEADERS += \
+    $$PWD/DocumentFixtures.h
@@ -0,0 +1,13 @@
+# <copyright company="Scythe Studio Sp. z o.o.">
+#     This file contains proprietary code. Copyright (c) 2021. All rights reserved.
+#</copyright>
+
+TEMPLATE = subdirs
+
+SUBDIRS += \
+    chartbuild \
+    datasetgenerator \
+    fetchthroughput \
+    jsondecoding \
+    pipeline \
+    zohostandin
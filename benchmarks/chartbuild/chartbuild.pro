@@ -0,0 +1,13 @@
+# <copyright company="Scythe Studio Sp. z o.o.">
+#     This file contains proprietary code. Copyright (c) 2021. All rights reserved.
+#</copyright>
+
+include(../app.pri)
+
+CONFIG += console
+CONFIG -= app_bundle
+
+TARGET = chartbuild
+
+SOURCES += \
+    main.cpp
@@ -0,0 +1,78 @@
+// <copyright company="Scythe Studio Sp. z o.o.">
+//     This file contains proprietary code. Copyright (c) 2021. All rights reserved.
+// </copyright>
+
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QTextStream>
+
+#include "DocumentFixtures.h"
+#include "LogicController.h"
+#include "plotting/CashFlowChart.h"
+
+#define DEFAULT_NUMBER_OF_DOCUMENTS 50000
+#define NUMBER_OF_RUNS 5
+
+using namespace DocumentFixtures;
+
+namespace {
+
+// amounts are used as if they were paid in Polish Zlote, so the chart doesn't wait for exchange rates.
+template <typename Document>
+QList<Document> withPlnTotals(QList<Document> documents)
+{
+    for (Document &document : documents) {
+        document.setPlnTotal(document.total());
+    }
+    return documents;
+}
+
+} // namespace
+
+/*!
+ * \brief Measures building income, expenses and cash flow series of the chart.
+ * Number of documents can be passed as the first argument, 50k is used by default. Documents are split 2:2:1 into invoices, expenses and bills.
+ */
+int main(int argc, char *argv[])
+{
+    QApplication app(argc, argv);
+
+    int count = DEFAULT_NUMBER_OF_DOCUMENTS;
+    if (app.arguments().size() > 1) {
+        count = qMax(5, app.arguments().at(1).toInt());
+    }
+
+    const QList<Invoice> &invoices = withPlnTotals(makeInvoices(count * 2 / 5));
+    const QList<Expense> &expenses = withPlnTotals(makeExpenses(count * 2 / 5));
+    const QList<Bill> &bills = withPlnTotals(makeBills(count - count * 4 / 5));
+    const QList<ForecastingModel::Forecast> forecasts;
+
+    LogicController logicController;
+    logicController.setFirstDate(FIRST_DATE);
+    logicController.setLastDate(FIRST_DATE.addDays(NUMBER_OF_DAYS));
+    logicController.setFromDate(FIRST_DATE);
+    logicController.setToDate(FIRST_DATE.addDays(NUMBER_OF_DAYS));
+
+    CashFlowChart chart(&logicController);
+    qint64 bestNanoseconds = -1;
+    for (int run = 0; run < NUMBER_OF_RUNS; ++run) {
+        chart.resetYAxeRanges();
+        chart.setDates(FIRST_DATE, FIRST_DATE.addDays(NUMBER_OF_DAYS));
+
+        QElapsedTimer timer;
+        timer.start();
+        chart.prepareIncomeSeries(invoices, forecasts);
+        chart.prepareExpensesSeries(expenses, bills, forecasts);
+        const qint64 elapsed = timer.nsecsElapsed();
+
+        if (bestNanoseconds < 0 || elapsed < bestNanoseconds) {
+            bestNanoseconds = elapsed;
+        }
+    }
+
+    QTextStream out(stdout);
+    out << "Building chart from " << count << " documents, best of " << NUMBER_OF_RUNS << " runs: "
+        << QString::number(bestNanoseconds / 1e6, 'f', 2) << " ms\n";
+
+    return 0;
+}
@@ -0,0 +1,357 @@
+// <copyright company="Scythe Studio Sp. z o.o.">
+//     This file contains proprietary code. Copyright (c) 2021. All rights reserved.
+// </copyright>
+
+#include "DatasetGenerator.h"
+#include <QStringList>
+#include <QtMath>
+#include <climits>
+
+#define CSV_DATE_FORMAT "d-M-yyyy"
+#define JSON_DATE_FORMAT "yyyy-MM-dd"
+#define PER_MILLE 1000
+#define INVOICE_ID_BASE 1000000000LL
+#define BILL_ID_BASE 2000000000LL
+#define RECURRING_BILL_ID_BASE 3000000000LL
+
+namespace {
+
+// share of every kind of documents in a dataset, in per mille. Invoices take the rest.
+const int SHARES[DatasetGenerator::KindCount] = {400, 250, 50, 250, 50};
+
+struct Weighted {
+    const char *value;
+    int weight;
+};
+
+// most of the documents are in Zlote, foreign ones follow typical mix of a Polish company.
+const Weighted CURRENCIES[] = {{"PLN", 55}, {"EUR", 25}, {"USD", 15}, {"GBP", 5}};
+const char *const CURRENCY_SYMBOLS[] = {"zł", "€", "$", "£"};
+
+const Weighted INVOICE_STATUSES[] = {{"paid", 60}, {"sent", 20}, {"overdue", 15}, {"draft", 5}};
+const Weighted EXPENSE_STATUSES[] = {{"nonbillable", 60}, {"unbilled", 25}, {"invoiced", 15}};
+const Weighted BILL_STATUSES[] = {{"paid", 65}, {"open", 25}, {"overdue", 10}};
+const Weighted RECURRENT_STATUSES[] = {{"active", 85}, {"stopped", 10}, {"expired", 5}};
+const Weighted FREQUENCIES[] = {{"weeks", 20}, {"months", 65}, {"years", 15}};
+const Weighted REPEATS[] = {{"1", 80}, {"2", 15}, {"3", 5}};
+
+const char *const NAME_PREFIXES[] = {"Northern", "Blue", "Golden", "Central", "Silver", "Green", "Bright", "Royal",
+                                     "Boston", "Baltic", "Villager", "Mayflower", "Red brick", "Summit", "Harbor", "Vistula"};
+const char *const NAME_SUFFIXES[] = {"Hospital", "Logistics", "Bakery", "Studio", "Systems", "Motors", "Foods", "Media",
+                                     "Consulting", "Software", "Telecom", "Energy", "Pharma", "Print", "Travel", "Hotels"};
+const char *const COMPANY_FORMS[] = {"Ltd", "Inc", "S.A.", "Sp. z o.o.", "GmbH"};
+const char *const CATEGORIES[] = {"Office rent", "Internet", "Salaries", "Software", "Travel", "Marketing",
+                                  "Utilities", "Insurance", "Equipment", "Taxes", "Training", "Fuel"};
+const int DUE_DAYS[] = {7, 14, 30, 60};
+
+/*!
+ * \brief splitmix64 sequence. Every document starts its own sequence, so it doesn't depend on the previous ones.
+ */
+class Random
+{
+public:
+    Random(quint64 seed, int kind, int index)
+        : m_state(seed ^ (quint64(kind) << 56) ^ (quint64(index) * 0x9E3779B97F4A7C15ULL))
+    {
+    }
+
+    quint64 next()
+    {
+        quint64 value = (m_state += 0x9E3779B97F4A7C15ULL);
+        value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+        return value ^ (value >> 31);
+    }
+
+    int bounded(int limit)
+    {
+        return int(next() % quint64(limit));
+    }
+
+    double uniform()
+    {
+        return (next() >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    // popular parties appear more often than the rest.
+    int skewed(int limit)
+    {
+        return bounded(bounded(limit) + 1);
+    }
+
+    // amounts spread evenly over orders of magnitude, rounded to grosze.
+    double amount(double minimum, double maximum)
+    {
+        return qRound64(minimum * qPow(maximum / minimum, uniform()) * 100) / 100.0;
+    }
+
+    template <int N>
+    int weighted(const Weighted (&values)[N])
+    {
+        int sum = 0;
+        for (const Weighted &value : values) {
+            sum += value.weight;
+        }
+        int pick = bounded(sum);
+        for (int i = 0; i < N; ++i) {
+            if (pick < values[i].weight) {
+                return i;
+            }
+            pick -= values[i].weight;
+        }
+        return N - 1;
+    }
+
+private:
+    quint64 m_state;
+};
+
+template <int N>
+const char *pick(Random &random, const char *const (&values)[N])
+{
+    return values[random.bounded(N)];
+}
+
+QString csvDate(const QDate &date)
+{
+    return date.isValid() ? date.toString(CSV_DATE_FORMAT) : QString();
+}
+
+QString jsonDate(const QDate &date)
+{
+    return date.isValid() ? date.toString(JSON_DATE_FORMAT) : QString();
+}
+
+} // namespace
+
+DatasetGenerator::DatasetGenerator(quint64 seed, const QDate &firstDate, int numberOfDays)
+    : m_seed(seed)
+    , m_firstDate(firstDate)
+    , m_numberOfDays(qMax(1, numberOfDays))
+{
+}
+
+int DatasetGenerator::count(Kind kind, int numberOfRows)
+{
+    if (kind != Invoices) {
+        return int(qint64(numberOfRows) * SHARES[kind] / PER_MILLE);
+    }
+
+    int rest = numberOfRows;
+    for (int other = NormalExpenses; other < KindCount; ++other) {
+        rest -= count(Kind(other), numberOfRows);
+    }
+    return rest;
+}
+
+QString DatasetGenerator::csvFileName(Kind kind)
+{
+    switch (kind) {
+    case Invoices:
+        return "invoices.csv";
+    case NormalExpenses:
+        return "normalExpenses.csv";
+    case RecurrentExpenses:
+        return "recurrentExpenses.csv";
+    case NormalBills:
+        return "normalBills.csv";
+    default:
+        return "recurrentBills.csv";
+    }
+}
+
+QString DatasetGenerator::csvHeader(Kind kind)
+{
+    switch (kind) {
+    case Invoices:
+        return "Number,Party,Status,Date,Due date,Amount,Currency";
+    case NormalExpenses:
+    case RecurrentExpenses:
+        return "Id,Status,Category,Party,Recurrent,Recurrence Frequency,Date,Next expense date,Amount,Currency";
+    default:
+        return "Number,Party,Recurrent,Status,Recurrence Frequency,Date,Due date,Next bill date,Amount,Currency";
+    }
+}
+
+QString DatasetGenerator::endpoint(Kind kind)
+{
+    switch (kind) {
+    case Invoices:
+        return "invoices";
+    case NormalExpenses:
+        return "expenses";
+    case RecurrentExpenses:
+        return "recurringexpenses";
+    case NormalBills:
+        return "bills";
+    default:
+        return "recurringbills";
+    }
+}
+
+QString DatasetGenerator::listKey(Kind kind)
+{
+    switch (kind) {
+    case Invoices:
+        return "invoices";
+    case NormalExpenses:
+        return "expenses";
+    case RecurrentExpenses:
+        return "recurring_expenses";
+    case NormalBills:
+        return "bills";
+    default:
+        return "recurring_bills";
+    }
+}
+
+int DatasetGenerator::indexOf(Kind kind, const QString &id)
+{
+    bool valid = false;
+    qint64 index = -1;
+    switch (kind) {
+    case Invoices:
+        index = id.toLongLong(&valid) - INVOICE_ID_BASE;
+        break;
+    case NormalExpenses:
+    case RecurrentExpenses:
+        // ids are numbered from 1 after "NE" or "RE" prefix.
+        if (id.startsWith(kind == NormalExpenses ? "NE" : "RE")) {
+            index = id.mid(2).toLongLong(&valid) - 1;
+        }
+        break;
+    case NormalBills:
+        index = id.toLongLong(&valid) - BILL_ID_BASE;
+        break;
+    default:
+        index = id.toLongLong(&valid) - RECURRING_BILL_ID_BASE;
+        break;
+    }
+    return valid && index >= 0 && index <= INT_MAX ? int(index) : -1;
+}
+
+QString DatasetGenerator::csvLine(Kind kind, int index) const
+{
+    const Document &generated = document(kind, index);
+    const QString &total = QString::number(generated.total, 'f', 2);
+    switch (kind) {
+    case Invoices:
+        return QStringList {generated.number, generated.party, generated.status, csvDate(generated.date),
+                            csvDate(generated.dueDate), total, generated.currencyCode}.join(',');
+    case NormalExpenses:
+    case RecurrentExpenses:
+        return QStringList {generated.id, generated.status, generated.category, generated.party,
+                            kind == RecurrentExpenses ? "TRUE" : "FALSE", generated.recurrenceFrequency,
+                            csvDate(generated.date), csvDate(generated.nextDate), total, generated.currencyCode}.join(',');
+    default:
+        return QStringList {generated.number, generated.party, kind == RecurrentBills ? "TRUE" : "FALSE", generated.status,
+                            generated.recurrenceFrequency, csvDate(generated.date), csvDate(generated.dueDate),
+                            csvDate(generated.nextDate), total, generated.currencyCode}.join(',');
+    }
+}
+
+QJsonObject DatasetGenerator::jsonObject(Kind kind, int index) const
+{
+    const Document &generated = document(kind, index);
+    QJsonObject object;
+    object.insert("status", generated.status);
+    object.insert("currency_code", generated.currencyCode);
+    object.insert("total", generated.total);
+
+    switch (kind) {
+    case Invoices:
+        object.insert("invoice_id", generated.id);
+        object.insert("invoice_number", generated.number);
+        object.insert("customer_name", generated.party);
+        break;
+    case NormalExpenses:
+    case RecurrentExpenses:
+        object.insert(kind == NormalExpenses ? "expense_id" : "recurring_expense_id", generated.id);
+        object.insert("account_name", generated.category);
+        object.insert("vendor_name", generated.party);
+        break;
+    default:
+        object.insert(kind == NormalBills ? "bill_id" : "recurring_bill_id", generated.id);
+        object.insert("bill_number", generated.number);
+        object.insert("vendor_name", generated.party);
+        object.insert("currency_symbol", generated.currencySymbol);
+        break;
+    }
+
+    // recurrent documents have only the next date.
+    if (generated.date.isValid()) {
+        object.insert("date", jsonDate(generated.date));
+    }
+    if (generated.dueDate.isValid()) {
+        object.insert("due_date", jsonDate(generated.dueDate));
+    }
+
+    if (kind == RecurrentExpenses || kind == RecurrentBills) {
+        object.insert("recurrence_frequency", generated.recurrenceFrequency);
+        object.insert("repeat_every", generated.repeatEvery);
+        object.insert(kind == RecurrentExpenses ? "next_expense_date" : "next_bill_date", jsonDate(generated.nextDate));
+        if (generated.endDate.isValid()) {
+            object.insert("end_date", jsonDate(generated.endDate));
+        }
+    }
+    return object;
+}
+
+DatasetGenerator::Document DatasetGenerator::document(Kind kind, int index) const
+{
+    Random random(m_seed, kind, index);
+    Document generated;
+    generated.repeatEvery = 1;
+
+    const int currency = random.weighted(CURRENCIES);
+    generated.currencyCode = CURRENCIES[currency].value;
+    generated.currencySymbol = CURRENCY_SYMBOLS[currency];
+
+    const int prefix = random.skewed(int(sizeof(NAME_PREFIXES) / sizeof(NAME_PREFIXES[0])));
+    const int suffix = random.skewed(int(sizeof(NAME_SUFFIXES) / sizeof(NAME_SUFFIXES[0])));
+    generated.party = QString("%1 %2 %3").arg(NAME_PREFIXES[prefix], NAME_SUFFIXES[suffix], pick(random, COMPANY_FORMS));
+
+    const QDate &date = m_firstDate.addDays(random.bounded(m_numberOfDays));
+    const QDate &dueDate = date.addDays(DUE_DAYS[random.bounded(4)]);
+
+    switch (kind) {
+    case Invoices:
+        generated.id = QString::number(INVOICE_ID_BASE + index);
+        generated.number = QString("INV-%1").arg(index + 1, 7, 10, QChar('0'));
+        generated.status = INVOICE_STATUSES[random.weighted(INVOICE_STATUSES)].value;
+        generated.date = date;
+        generated.dueDate = dueDate;
+        generated.total = random.amount(500, 50000);
+        break;
+    case NormalExpenses:
+        generated.id = QString("NE%1").arg(index + 1);
+        generated.status = EXPENSE_STATUSES[random.weighted(EXPENSE_STATUSES)].value;
+        generated.category = pick(random, CATEGORIES);
+        generated.date = date;
+        generated.total = random.amount(20, 5000);
+        break;
+    case NormalBills:
+        generated.id = QString::number(BILL_ID_BASE + index);
+        generated.number = QString("NB%1").arg(index + 1);
+        generated.status = BILL_STATUSES[random.weighted(BILL_STATUSES)].value;
+        generated.date = date;
+        generated.dueDate = dueDate;
+        generated.total = random.amount(100, 20000);
+        break;
+    default:
+        // recurrent documents are rents, salaries and subscriptions, a part of them ends within the dataset.
+        generated.id = kind == RecurrentExpenses ? QString("RE%1").arg(index + 1) : QString::number(RECURRING_BILL_ID_BASE + index);
+        generated.number = QString("RB%1").arg(index + 1);
+        generated.category = pick(random, CATEGORIES);
+        generated.status = RECURRENT_STATUSES[random.weighted(RECURRENT_STATUSES)].value;
+        generated.recurrenceFrequency = FREQUENCIES[random.weighted(FREQUENCIES)].value;
+        generated.repeatEvery = QString(REPEATS[random.weighted(REPEATS)].value).toInt();
+        generated.nextDate = date;
+        if (random.bounded(10) < 3) {
+            generated.endDate = date.addDays(random.bounded(m_numberOfDays));
+        }
+        generated.total = random.amount(300, 15000);
+        break;
+    }
+    return generated;
+}
@@ -0,0 +1,119 @@
+// <copyright company="Scythe Studio Sp. z o.o.">
+//     This file contains proprietary code. Copyright (c) 2021. All rights reserved.
+// </copyright>
+
+#ifndef DATASETGENERATOR_H
+#define DATASETGENERATOR_H
+
+#include <QDate>
+#include <QJsonObject>
+#include <QString>
+
+/*!
+ * \brief Class generating realistic invoices, expenses and bills in the layouts of the CSV files bundled with
+ * the application and of Zoho API responses. Every document depends only on the seed, its kind and its index,
+ * so the same dataset is produced on every run and any document can be generated without the previous ones.
+ */
+class DatasetGenerator
+{
+public:
+
+    /*!
+     * \brief Kind of generated documents, each of them has its own file and Zoho endpoint.
+     */
+    enum Kind {
+        Invoices,
+        NormalExpenses,
+        RecurrentExpenses,
+        NormalBills,
+        RecurrentBills,
+        KindCount
+    };
+
+    /*!
+     * \brief Constructor.
+     * \param quint64 seed -- seed the whole dataset is derived from.
+     * \param const QDate &firstDate -- first date documents are issued at.
+     * \param int numberOfDays -- number of days documents are spread over.
+     */
+    DatasetGenerator(quint64 seed, const QDate &firstDate, int numberOfDays);
+
+    /*!
+     * \brief Returns number of documents of the given kind in a dataset of the given size.
+     * \param Kind kind -- kind of documents.
+     * \param int numberOfRows -- number of documents of all kinds.
+     */
+    static int count(Kind kind, int numberOfRows);
+
+    /*!
+     * \brief Returns name of the CSV file LogicController reads documents of the given kind from.
+     * \param Kind kind -- kind of documents.
+     */
+    static QString csvFileName(Kind kind);
+
+    /*!
+     * \brief Returns the first line of the CSV file with documents of the given kind.
+     * \param Kind kind -- kind of documents.
+     */
+    static QString csvHeader(Kind kind);
+
+    /*!
+     * \brief Returns name of the Zoho endpoint listing documents of the given kind, i.e. "recurringbills".
+     * \param Kind kind -- kind of documents.
+     */
+    static QString endpoint(Kind kind);
+
+    /*!
+     * \brief Returns key of the array of documents in Zoho responses, i.e. "recurring_bills".
+     * \param Kind kind -- kind of documents.
+     */
+    static QString listKey(Kind kind);
+
+    /*!
+     * \brief Returns index of the document with the given id, or -1 if no document can have such id.
+     * \param Kind kind -- kind of the document.
+     * \param const QString &id -- id of the document, as in "invoice_id" or "recurring_bill_id" fields.
+     */
+    static int indexOf(Kind kind, const QString &id);
+
+    /*!
+     * \brief Returns a line of the CSV file with a single document.
+     * \param Kind kind -- kind of the document.
+     * \param int index -- index of the document.
+     */
+    QString csvLine(Kind kind, int index) const;
+
+    /*!
+     * \brief Returns a single document in the shape used by Zoho API.
+     * \param Kind kind -- kind of the document.
+     * \param int index -- index of the document.
+     */
+    QJsonObject jsonObject(Kind kind, int index) const;
+
+private:
+    // fields of a single document, shared by both layouts.
+    struct Document {
+        QString id;
+        QString number;
+        QString party;
+        QString category;
+        QString status;
+        QDate date;
+        QDate dueDate;
+        QDate nextDate;
+        QString recurrenceFrequency;
+        int repeatEvery;
+        QDate endDate;
+        QString currencyCode;
+        QString currencySymbol;
+        double total;
+    };
+
+    Document document(Kind kind, int index) const;
+
+    quint64 m_seed = 0;
+    QDate m_firstDate;
+    int m_numberOfDays = 0;
+};
+
+#endif // DATASETGENERATOR_H
@@ -0,0 +1,13 @@
+# <copyright company="Scythe Studio Sp. z o.o.">
+#     This file contains proprietary code. Copyright (c) 2021. All rights reserved.
+#</copyright>
+
+# Synthetic dataset generator, shared by tools that need Zoho-like documents.
+
+INCLUDEPATH += $$PWD
+
+SOURCES += \
+    $$PWD/DatasetGenerator.cpp
+
+HEADERS += \
+    $$PWD/DatasetGenerator.h
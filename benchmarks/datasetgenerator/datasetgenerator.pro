@@ -0,0 +1,16 @@
+# <copyright company="Scythe Studio Sp. z o.o.">
+#     This file contains proprietary code. Copyright (c) 2021. All rights reserved.
+#</copyright>
+
+QT += core
+QT -= gui
+
+CONFIG += c++11 console
+CONFIG -= app_bundle
+
+TARGET = datasetgenerator
+
+include(datasetgenerator.pri)
+
+SOURCES += \
+    main.cpp
@@ -0,0 +1,123 @@
+// <copyright company="Scythe Studio Sp. z o.o.">
+//     This file contains proprietary code. Copyright (c) 2021. All rights reserved.
+// </copyright>
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QJsonDocument>
+#include <QTextStream>
+
+#include "DatasetGenerator.h"
+
+#define DATE_FORMAT "yyyy-MM-dd"
+#define DEFAULT_NUMBER_OF_ROWS "10000"
+#define DEFAULT_SEED "1"
+#define DEFAULT_FIRST_DATE "2020-01-01"
+#define DEFAULT_NUMBER_OF_DAYS "1095"
+
+namespace {
+
+QTextStream &err()
+{
+    static QTextStream stream(stderr);
+    return stream;
+}
+
+bool writeCsv(const DatasetGenerator &generator, DatasetGenerator::Kind kind, int count, const QDir &directory)
+{
+    QFile file(directory.filePath(DatasetGenerator::csvFileName(kind)));
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate)) {
+        err() << "Cannot write " << file.fileName() << ": " << file.errorString() << endl;
+        return false;
+    }
+
+    QTextStream stream(&file);
+    stream.setCodec("UTF-8");
+    stream << DatasetGenerator::csvHeader(kind) << '\n';
+    for (int i = 0; i < count; ++i) {
+        stream << generator.csvLine(kind, i) << '\n';
+    }
+    stream.flush();
+    return file.error() == QFileDevice::NoError;
+}
+
+// documents are written one by one, so a response with millions of them is never kept in memory.
+bool writeJson(const DatasetGenerator &generator, DatasetGenerator::Kind kind, int count, const QDir &directory)
+{
+    QFile file(directory.filePath(DatasetGenerator::endpoint(kind) + ".json"));
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        err() << "Cannot write " << file.fileName() << ": " << file.errorString() << endl;
+        return false;
+    }
+
+    file.write("{\"code\":0,\"message\":\"success\",\"" + DatasetGenerator::listKey(kind).toUtf8() + "\":[");
+    for (int i = 0; i < count; ++i) {
+        if (i > 0) {
+            file.write(",");
+        }
+        file.write(QJsonDocument(generator.jsonObject(kind, i)).toJson(QJsonDocument::Compact));
+    }
+    file.write("],\"page_context\":{\"page\":1,\"per_page\":" + QByteArray::number(count) + ",\"has_more_page\":false}}");
+    return file.error() == QFileDevice::NoError;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("datasetgenerator");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Generates a synthetic Zoho Books dataset as CSV files read by the application "
+                                     "and as JSON responses of Zoho API.");
+    parser.addHelpOption();
+    parser.addOptions({
+        {"rows", "Number of documents of all kinds.", "rows", DEFAULT_NUMBER_OF_ROWS},
+        {"seed", "Seed the dataset is derived from, equal seeds give equal datasets.", "seed", DEFAULT_SEED},
+        {"output", "Directory the files are written to.", "directory", "."},
+        {"format", "Output format: csv, json or both (default).", "format", "both"},
+        {"start", "First date documents are issued at.", "yyyy-MM-dd", DEFAULT_FIRST_DATE},
+        {"days", "Number of days documents are spread over.", "days", DEFAULT_NUMBER_OF_DAYS}
+    });
+    parser.process(app);
+
+    bool rowsValid = false;
+    bool seedValid = false;
+    bool daysValid = false;
+    const int rows = parser.value("rows").toInt(&rowsValid);
+    const quint64 seed = parser.value("seed").toULongLong(&seedValid);
+    const int days = parser.value("days").toInt(&daysValid);
+    const QDate &firstDate = QDate::fromString(parser.value("start"), DATE_FORMAT);
+    const QString format = parser.value("format").toLower();
+
+    if (!rowsValid || rows < 1 || !seedValid || !daysValid || days < 1 || !firstDate.isValid()) {
+        err() << "--rows and --days have to be positive numbers, --seed a non-negative number "
+                 "and --start a date in yyyy-MM-dd format." << endl;
+        return 1;
+    }
+    if (format != "csv" && format != "json" && format != "both") {
+        err() << "Unknown format: " << format << endl;
+        return 1;
+    }
+
+    QDir directory(parser.value("output"));
+    if (!directory.mkpath(".")) {
+        err() << "Cannot create " << directory.path() << endl;
+        return 1;
+    }
+
+    const DatasetGenerator generator(seed, firstDate, days);
+    for (int kind = 0; kind < DatasetGenerator::KindCount; ++kind) {
+        const DatasetGenerator::Kind documentKind = DatasetGenerator::Kind(kind);
+        const int count = DatasetGenerator::count(documentKind, rows);
+        if ((format != "json" && !writeCsv(generator, documentKind, count, directory))
+                || (format != "csv" && !writeJson(generator, documentKind, count, directory))) {
+            return 1;
+        }
+        err() << DatasetGenerator::endpoint(documentKind) << ": " << count << endl;
+    }
+    return 0;
+}
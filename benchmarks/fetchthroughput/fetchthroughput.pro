@@ -0,0 +1,38 @@
+# <copyright company="Scythe Studio Sp. z o.o.">
+#     This file contains proprietary code. Copyright (c) 2021. All rights reserved.
+#</copyright>
+
+QT += core network concurrent
+QT -= gui
+
+CONFIG += c++11 console
+CONFIG -= app_bundle
+
+TARGET = fetchthroughput
+
+include(../zohostandin/zohostandin.pri)
+
+SRC_DIR = $$PWD/../../src
+INCLUDEPATH += $$SRC_DIR
+
+SOURCES += \
+    main.cpp \
+    $$SRC_DIR/datasets/Bill.cpp \
+    $$SRC_DIR/datasets/CompactFields.cpp \
+    $$SRC_DIR/datasets/CsvReader.cpp \
+    $$SRC_DIR/datasets/Expense.cpp \
+    $$SRC_DIR/datasets/Invoice.cpp \
+    $$SRC_DIR/datasets/Recurrence.cpp \
+    $$SRC_DIR/Settings.cpp \
+    $$SRC_DIR/WebClient.cpp
+
+HEADERS += \
+    $$SRC_DIR/datasets/Bill.h \
+    $$SRC_DIR/datasets/CompactFields.h \
+    $$SRC_DIR/datasets/CsvReader.h \
+    $$SRC_DIR/datasets/Expense.h \
+    $$SRC_DIR/datasets/Invoice.h \
+    $$SRC_DIR/datasets/JsonFields.h \
+    $$SRC_DIR/datasets/Recurrence.h \
+    $$SRC_DIR/Settings.h \
+    $$SRC_DIR/WebClient.h
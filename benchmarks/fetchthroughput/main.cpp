@@ -0,0 +1,156 @@
+// <copyright company="Scythe Studio Sp. z o.o.">
+//     This file contains proprietary code. Copyright (c) 2021. All rights reserved.
+// </copyright>
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QTextStream>
+#include <QThread>
+#include <QTimer>
+#include <algorithm>
+
+#include "StandInServer.h"
+#include "WebClient.h"
+
+#define DEFAULT_NUMBER_OF_ROWS "20000"
+#define DEFAULT_LATENCY "30"
+#define DEFAULT_JITTER "20"
+#define DEFAULT_CONCURRENCY "1,2,4,6,12"
+#define DEFAULT_NUMBER_OF_RUNS "3"
+#define FETCH_TIMEOUT 600000 // ms
+#define ACCESS_TOKEN "stand-in-access-token"
+
+namespace {
+
+struct Run {
+    qint64 milliseconds;
+    int numberOfDocuments;
+    bool finished;
+};
+
+// fetches all the endpoints once, with a fresh client, so no page is skipped thanks to sync watermarks.
+Run fetchAll(const QString &apiAddress, int maxConcurrentRequests)
+{
+    WebClient webClient;
+    webClient.setApiAddress(apiAddress);
+    webClient.setMaxConcurrentRequests(maxConcurrentRequests);
+
+    int numberOfDocuments = 0;
+    QObject::connect(&webClient, &WebClient::invoicesReceived, [&](QList<Invoice> &invoices) {
+        numberOfDocuments += invoices.size();
+    });
+    QObject::connect(&webClient, &WebClient::normalExpensesReceived, [&](QList<Expense> &expenses) {
+        numberOfDocuments += expenses.size();
+    });
+    QObject::connect(&webClient, &WebClient::recurringExpensesReceived, [&](QList<Expense> &expenses) {
+        numberOfDocuments += expenses.size();
+    });
+    QObject::connect(&webClient, &WebClient::normalBillsReceived, [&](QList<Bill> &bills) {
+        numberOfDocuments += bills.size();
+    });
+    QObject::connect(&webClient, &WebClient::recurringBillsReceived, [&](QList<Bill> &bills) {
+        numberOfDocuments += bills.size();
+    });
+
+    QEventLoop loop;
+    bool finished = false;
+    QObject::connect(&webClient, &WebClient::allDataReceived, &loop, [&]() {
+        finished = true;
+        loop.quit();
+    });
+    QTimer::singleShot(FETCH_TIMEOUT, &loop, &QEventLoop::quit);
+
+    QElapsedTimer timer;
+    timer.start();
+    webClient.getInvoicesRequest(ACCESS_TOKEN);
+    webClient.getBillsRequest(ACCESS_TOKEN);
+    webClient.getRecurringBillsRequest(ACCESS_TOKEN);
+    webClient.getExpensesRequest(ACCESS_TOKEN);
+    webClient.getRecurringExpensesRequest(ACCESS_TOKEN);
+    loop.exec();
+
+    return {timer.elapsed(), numberOfDocuments, finished};
+}
+
+} // namespace
+
+/*!
+ * \brief Measures fetching all the documents through WebClient from a local stand-in server running on its own thread.
+ * Every concurrency limit is run a few times, the median run is reported with latency percentiles of the server.
+ */
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Measures throughput and tail latency of fetching documents from a stand-in Zoho server.");
+    parser.addHelpOption();
+    parser.addOptions({
+        {"rows", "Number of documents of all kinds.", "rows", DEFAULT_NUMBER_OF_ROWS},
+        {"seed", "Seed of the dataset, latency jitter and injected errors.", "seed", "1"},
+        {"page-size", "Maximal number of documents on a page.", "documents", "200"},
+        {"latency", "Fixed delay of every response.", "ms", DEFAULT_LATENCY},
+        {"jitter", "Upper bound of the random delay added to every response.", "ms", DEFAULT_JITTER},
+        {"error-rate", "Percent of requests answered with an error.", "percent", "0"},
+        {"concurrency", "Comma separated limits of requests in flight to measure.", "limits", DEFAULT_CONCURRENCY},
+        {"runs", "Number of runs of every limit.", "runs", DEFAULT_NUMBER_OF_RUNS}
+    });
+    parser.process(app);
+
+    StandInServer *server = new StandInServer;
+    server->setDataset(parser.value("seed").toULongLong(), parser.value("rows").toInt());
+    server->setMaxPageSize(parser.value("page-size").toInt());
+    server->setLatency(parser.value("latency").toInt(), parser.value("jitter").toInt());
+    server->setErrorRate(parser.value("error-rate").toDouble(), 500);
+
+    // the server has its own thread, so decoding pages in the client doesn't delay responses.
+    QThread serverThread;
+    server->moveToThread(&serverThread);
+    QObject::connect(&serverThread, &QThread::finished, server, &QObject::deleteLater);
+    serverThread.start();
+
+    // the address is read on the server thread as well, QTcpServer is not thread-safe.
+    bool listening = false;
+    QString apiAddress;
+    QMetaObject::invokeMethod(server, [&]() {
+        listening = server->listen();
+        if (listening) {
+            apiAddress = server->apiAddress();
+        }
+    }, Qt::BlockingQueuedConnection);
+
+    QTextStream out(stdout);
+    if (!listening) {
+        QTextStream(stderr) << "Cannot start the stand-in server." << endl;
+        serverThread.quit();
+        serverThread.wait();
+        return 1;
+    }
+
+    const int numberOfRuns = qMax(1, parser.value("runs").toInt());
+    out << "concurrency,documents,median_ms,documents_per_s,requests,errors,p50_ms,p95_ms,p99_ms,finished" << endl;
+    for (const QString &value : parser.value("concurrency").split(',', Qt::SkipEmptyParts)) {
+        const int concurrency = qMax(1, value.toInt());
+        QVector<Run> runs;
+        server->resetStatistics();
+        for (int i = 0; i < numberOfRuns; ++i) {
+            runs << fetchAll(apiAddress, concurrency);
+        }
+
+        std::sort(runs.begin(), runs.end(), [](const Run &left, const Run &right) {
+            return left.milliseconds < right.milliseconds;
+        });
+        const Run &median = runs.at(runs.size() / 2);
+        out << concurrency << ',' << median.numberOfDocuments << ',' << median.milliseconds << ','
+            << QString::number(median.numberOfDocuments * 1000.0 / qMax<qint64>(1, median.milliseconds), 'f', 0) << ','
+            << server->numberOfRequests() << ',' << server->numberOfErrors() << ','
+            << server->latencyPercentile(50) / 1000.0 << ',' << server->latencyPercentile(95) / 1000.0 << ','
+            << server->latencyPercentile(99) / 1000.0 << ',' << (median.finished ? "true" : "false") << endl;
+    }
+
+    serverThread.quit();
+    serverThread.wait();
+    return 0;
+}
@@ -0,0 +1,165 @@
+// <copyright company="Scythe Studio Sp. z o.o.">
+//     This file contains proprietary code. Copyright (c) 2021. All rights reserved.
+// </copyright>
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTextStream>
+
+#include "datasets/Bill.h"
+#include "datasets/Expense.h"
+#include "datasets/Invoice.h"
+
+#define DEFAULT_NUMBER_OF_RECORDS 100000
+#define NUMBER_OF_RUNS 5
+
+namespace {
+
+const char *const CURRENCIES[] = {"PLN", "EUR", "USD", "GBP"};
+const char *const STATUSES[] = {"paid", "overdue", "sent", "draft"};
+
+QByteArray makeInvoicesResponse(int count)
+{
+    const QDate &firstDate = QDate(2020, 1, 1);
+    QJsonArray invoices;
+    for (int i = 0; i < count; ++i) {
+        QJsonObject invoice;
+        invoice.insert("invoice_id", QString::number(1000000 + i));
+        invoice.insert("status", STATUSES[i % 4]);
+        invoice.insert("invoice_number", QString("INV-%1").arg(i, 6, 10, QChar('0')));
+        invoice.insert("customer_name", QString("Customer %1").arg(i % 500));
+        invoice.insert("date", firstDate.addDays(i % 1000).toString(Qt::ISODate));
+        invoice.insert("due_date", firstDate.addDays(i % 1000 + 14).toString(Qt::ISODate));
+        invoice.insert("currency_code", CURRENCIES[i % 4]);
+        invoice.insert("total", 100.0 + (i % 10000) * 1.25);
+        invoices.append(invoice);
+    }
+    return QJsonDocument(QJsonObject{{"invoices", invoices}}).toJson(QJsonDocument::Compact);
+}
+
+QByteArray makeBillsResponse(int count)
+{
+    const QDate &firstDate = QDate(2020, 1, 1);
+    QJsonArray bills;
+    for (int i = 0; i < count; ++i) {
+        QJsonObject bill;
+        bill.insert("bill_id", QString::number(2000000 + i));
+        bill.insert("bill_number", QString("BILL-%1").arg(i, 6, 10, QChar('0')));
+        bill.insert("vendor_name", QString("Vendor %1").arg(i % 500));
+        bill.insert("status", STATUSES[i % 4]);
+        bill.insert("date", firstDate.addDays(i % 1000).toString(Qt::ISODate));
+        bill.insert("due_date", firstDate.addDays(i % 1000 + 30).toString(Qt::ISODate));
+        bill.insert("currency_code", CURRENCIES[i % 4]);
+        bill.insert("currency_symbol", CURRENCIES[i % 4]);
+        bill.insert("total", 50.0 + (i % 10000) * 0.75);
+        bills.append(bill);
+    }
+    return QJsonDocument(QJsonObject{{"bills", bills}}).toJson(QJsonDocument::Compact);
+}
+
+QByteArray makeExpensesResponse(int count)
+{
+    const QDate &firstDate = QDate(2020, 1, 1);
+    QJsonArray expenses;
+    for (int i = 0; i < count; ++i) {
+        QJsonObject expense;
+        expense.insert("expense_id", QString::number(3000000 + i));
+        expense.insert("status", STATUSES[i % 4]);
+        expense.insert("account_name", QString("Category %1").arg(i % 40));
+        expense.insert("vendor_name", QString("Vendor %1").arg(i % 500));
+        expense.insert("date", firstDate.addDays(i % 1000).toString(Qt::ISODate));
+        expense.insert("currency_code", CURRENCIES[i % 4]);
+        expense.insert("total", 20.0 + (i % 10000) * 0.5);
+        expenses.append(expense);
+    }
+    return QJsonDocument(QJsonObject{{"expenses", expenses}}).toJson(QJsonDocument::Compact);
+}
+
+template <typename T, typename Decode>
+double measure(const QByteArray &response, const char *arrayName, Decode decode)
+{
+    qint64 bestNanoseconds = -1;
+    int decodedRecords = 0;
+
+    for (int run = 0; run < NUMBER_OF_RUNS; ++run) {
+        QElapsedTimer timer;
+        timer.start();
+
+        const QJsonDocument &jsonResponse = QJsonDocument::fromJson(response);
+        const QJsonArray &jsonArray = jsonResponse[arrayName].toArray();
+        QList<T> records;
+        records.reserve(jsonArray.size());
+        for (const auto &jsonValue : jsonArray) {
+            records << decode(jsonValue);
+        }
+
+        const qint64 elapsed = timer.nsecsElapsed();
+        if (bestNanoseconds < 0 || elapsed < bestNanoseconds) {
+            bestNanoseconds = elapsed;
+        }
+        decodedRecords = records.size();
+    }
+
+    return bestNanoseconds > 0 ? decodedRecords * 1e9 / bestNanoseconds : 0.0;
+}
+
+void report(QTextStream &out, const QString &name, double variantRate, double typedRate)
+{
+    out << name.leftJustified(10)
+        << QString::number(variantRate, 'f', 0).rightJustified(16)
+        << QString::number(typedRate, 'f', 0).rightJustified(16)
+        << QString::number(variantRate > 0 ? typedRate / variantRate : 0.0, 'f', 2).rightJustified(10) << "x\n";
+}
+
+} // namespace
+
+/*!
+ * \brief Compares decoding Zoho list responses through QVariantMap with reading QJsonObject fields directly.
+ * Number of records can be passed as the first argument, 100k is used by default. Both paths include QJsonDocument parsing.
+ */
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    int count = DEFAULT_NUMBER_OF_RECORDS;
+    if (app.arguments().size() > 1) {
+        count = qMax(1, app.arguments().at(1).toInt());
+    }
+
+    QTextStream out(stdout);
+    out << "Decoding " << count << " records per response, best of " << NUMBER_OF_RUNS << " runs (records/s)\n";
+    out << QString("Response").leftJustified(10) << QString("QVariantMap").rightJustified(16)
+        << QString("QJsonObject").rightJustified(16) << QString("Speedup").rightJustified(11) << "\n";
+
+    const QByteArray &invoices = makeInvoicesResponse(count);
+    report(out, "invoices",
+           measure<Invoice>(invoices, "invoices", [](const QJsonValue &value) {
+               return Invoice::parseInvoice(value.toVariant().toMap());
+           }),
+           measure<Invoice>(invoices, "invoices", [](const QJsonValue &value) {
+               return Invoice::parseInvoice(value.toObject());
+           }));
+
+    const QByteArray &bills = makeBillsResponse(count);
+    report(out, "bills",
+           measure<Bill>(bills, "bills", [](const QJsonValue &value) {
+               return Bill::parseNormalBill(value.toVariant().toMap());
+           }),
+           measure<Bill>(bills, "bills", [](const QJsonValue &value) {
+               return Bill::parseNormalBill(value.toObject());
+           }));
+
+    const QByteArray &expenses = makeExpensesResponse(count);
+    report(out, "expenses",
+           measure<Expense>(expenses, "expenses", [](const QJsonValue &value) {
+               return Expense::parseNormalExpense(value.toVariant().toMap());
+           }),
+           measure<Expense>(expenses, "expenses", [](const QJsonValue &value) {
+               return Expense::parseNormalExpense(value.toObject());
+           }));
+
+    return 0;
+}
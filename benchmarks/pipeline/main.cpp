@@ -0,0 +1,467 @@
+// <copyright company="Scythe Studio Sp. z o.o.">
+//     This file contains proprietary code. Copyright (c) 2021. All rights reserved.
+// </copyright>
+
+#include <QtTest>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+
+#include "DocumentFixtures.h"
+#include "LogicController.h"
+#include "WebClient.h"
+#include "datasets/ColumnKernels.h"
+#include "models/BillsModel.h"
+#include "plotting/CashFlowChart.h"
+
+#define NUMBER_OF_RANGE_QUERIES 100
+#define PROCESSING_TIMEOUT 600000
+#define SCALING_NUMBER_OF_INVOICES 1000000
+
+using namespace DocumentFixtures;
+
+namespace {
+
+const int SIZES[] = {100, 1000, 10000, 100000, 1000000};
+const char *const KINDS[] = {"invoices", "expenses", "bills"};
+
+// writes the file read by LogicController for the given kind of documents.
+bool writeCsvFile(const QString &directory, const QString &kind, int count)
+{
+    const QString &name = kind == "invoices" ? "invoices.csv" : kind == "expenses" ? "normalExpenses.csv" : "normalBills.csv";
+    QFile file(directory + "/" + name);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        return false;
+    }
+
+    QTextStream out(&file);
+    out << "header\n";
+    for (int i = 0; i < count; ++i) {
+        out << (kind == "invoices" ? invoiceLine(i) : kind == "expenses" ? expenseLine(i) : billLine(i)) << '\n';
+    }
+    return true;
+}
+
+// response in the shape returned by Zoho API for the given kind of documents.
+QByteArray makeResponse(const QString &kind, int count)
+{
+    QJsonArray documents;
+    for (int i = 0; i < count; ++i) {
+        const QDate &date = FIRST_DATE.addDays(i % NUMBER_OF_DAYS);
+        QJsonObject document;
+        document.insert("status", STATUSES[i % 4]);
+        document.insert("date", date.toString(Qt::ISODate));
+        document.insert("currency_code", CURRENCIES[i % 4]);
+        document.insert("total", 20.0 + (i % 10000) * 0.5);
+        if (kind == "invoices") {
+            document.insert("invoice_id", QString::number(1000000 + i));
+            document.insert("invoice_number", QString("INV-%1").arg(i));
+            document.insert("customer_name", QString("Customer %1").arg(i % 500));
+            document.insert("due_date", date.addDays(14).toString(Qt::ISODate));
+        } else if (kind == "expenses") {
+            document.insert("expense_id", QString::number(3000000 + i));
+            document.insert("account_name", QString("Category %1").arg(i % 40));
+            document.insert("vendor_name", QString("Vendor %1").arg(i % 500));
+        } else {
+            document.insert("bill_id", QString::number(2000000 + i));
+            document.insert("bill_number", QString("BILL-%1").arg(i));
+            document.insert("vendor_name", QString("Vendor %1").arg(i % 500));
+            document.insert("due_date", date.addDays(30).toString(Qt::ISODate));
+        }
+        documents.append(document);
+    }
+    return QJsonDocument(QJsonObject {{kind, documents}}).toJson(QJsonDocument::Compact);
+}
+
+void addSizes()
+{
+    QTest::addColumn<int>("size");
+    for (int size : SIZES) {
+        QTest::newRow(QByteArray::number(size)) << size;
+    }
+}
+
+// 1, 2, 4... threads up to the number of cores.
+void addThreadCounts()
+{
+    QTest::addColumn<int>("threads");
+    const int idealThreadCount = QThread::idealThreadCount();
+    for (int threads = 1; threads < idealThreadCount; threads *= 2) {
+        QTest::newRow(QByteArray::number(threads)) << threads;
+    }
+    QTest::newRow(QByteArray::number(idealThreadCount)) << idealThreadCount;
+}
+
+void addKindsAndSizes()
+{
+    QTest::addColumn<QString>("kind");
+    QTest::addColumn<int>("size");
+    for (const char *kind : KINDS) {
+        for (int size : SIZES) {
+            QTest::newRow(QByteArray(kind) + "/" + QByteArray::number(size)) << QString(kind) << size;
+        }
+    }
+}
+
+} // namespace
+
+/*!
+ * \brief Benchmarks of the data pipeline and the chart, from reading documents to building series.
+ * Every benchmark runs on 100 to 1M documents, a single size can be picked with i.e. 'chartBuilding:10000'.
+ * csvImportScaling parses 1M invoices on 1 thread up to all the cores.
+ */
+class PipelineBenchmark : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void csvParsing_data() { addKindsAndSizes(); }
+    void csvParsing();
+    void csvImportScaling_data() { addThreadCounts(); }
+    void csvImportScaling();
+    void jsonParsing_data() { addKindsAndSizes(); }
+    void jsonParsing();
+    void documentProcessing_data() { addKindsAndSizes(); }
+    void documentProcessing();
+    void rangeQueries_data() { addSizes(); }
+    void rangeQueries();
+    void rangeTotals_data() { addSizes(); }
+    void rangeTotals();
+    void columnKernels_data();
+    void columnKernels();
+    void recurrenceWindow_data();
+    void recurrenceWindow();
+    void proxyFiltering_data() { addSizes(); }
+    void proxyFiltering();
+    void proxySorting_data() { addSizes(); }
+    void proxySorting();
+    void chartBuilding_data() { addSizes(); }
+    void chartBuilding();
+
+private:
+    QTemporaryDir m_scalingDirectory; // the same file is parsed with every number of threads.
+    bool m_scalingFileWritten = false;
+};
+
+void PipelineBenchmark::csvParsing()
+{
+    QFETCH(QString, kind);
+    QFETCH(int, size);
+
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    QVERIFY(writeCsvFile(directory.path(), kind, size));
+
+    LogicController logicController;
+    logicController.setDataDirectory(directory.path());
+    // parsed documents are only counted, so their processing doesn't run in the background.
+    WebClient *webClient = logicController.m_webClient;
+    QObject::disconnect(webClient, nullptr, &logicController, nullptr);
+    int parsed = 0;
+    connect(webClient, &WebClient::invoicesReceived, this, [&](QList<Invoice> &invoices) { parsed = invoices.size(); });
+    connect(webClient, &WebClient::normalExpensesReceived, this, [&](QList<Expense> &expenses) { parsed = expenses.size(); });
+    connect(webClient, &WebClient::normalBillsReceived, this, [&](QList<Bill> &bills) { parsed = bills.size(); });
+
+    QBENCHMARK {
+        if (kind == "invoices") {
+            logicController.readInvoicesFile();
+        } else if (kind == "expenses") {
+            logicController.readNormalExpensesFile();
+        } else {
+            logicController.readNormalBillsFile();
+        }
+    }
+    QCOMPARE(parsed, size);
+}
+
+void PipelineBenchmark::csvImportScaling()
+{
+    QFETCH(int, threads);
+
+    if (!m_scalingFileWritten) {
+        QVERIFY(m_scalingDirectory.isValid());
+        QVERIFY(writeCsvFile(m_scalingDirectory.path(), "invoices", SCALING_NUMBER_OF_INVOICES));
+        m_scalingFileWritten = true;
+    }
+
+    LogicController logicController;
+    logicController.setDataDirectory(m_scalingDirectory.path());
+    logicController.setImportThreadCount(threads);
+    WebClient *webClient = logicController.m_webClient;
+    QObject::disconnect(webClient, nullptr, &logicController, nullptr);
+    int parsed = 0;
+    connect(webClient, &WebClient::invoicesReceived, this, [&](QList<Invoice> &invoices) { parsed = invoices.size(); });
+
+    QBENCHMARK {
+        logicController.readInvoicesFile();
+    }
+    QCOMPARE(parsed, SCALING_NUMBER_OF_INVOICES);
+}
+
+void PipelineBenchmark::jsonParsing()
+{
+    QFETCH(QString, kind);
+    QFETCH(int, size);
+
+    const QByteArray &response = makeResponse(kind, size);
+    int parsed = 0;
+    QBENCHMARK {
+        const QJsonDocument &document = QJsonDocument::fromJson(response);
+        if (kind == "invoices") {
+            parsed = WebClient::parseGetInvoicesResponse(document).size();
+        } else if (kind == "expenses") {
+            parsed = WebClient::parseGetExpensesResponse(document).size();
+        } else {
+            parsed = WebClient::parseGetBillsResponse(document).size();
+        }
+    }
+    QCOMPARE(parsed, size);
+}
+
+void PipelineBenchmark::documentProcessing()
+{
+    QFETCH(QString, kind);
+    QFETCH(int, size);
+
+    // documents are converted to PLN, merged with stored ones and sorted on a worker thread.
+    LogicController logicController;
+    logicController.prepareFakeRates();
+    const QList<Invoice> &invoices = kind == "invoices" ? makeInvoices(size) : QList<Invoice>();
+    const QList<Expense> &expenses = kind == "expenses" ? makeExpenses(size) : QList<Expense>();
+    const QList<Bill> &bills = kind == "bills" ? makeBills(size) : QList<Bill>();
+
+    QSignalSpy invoicesSpy(&logicController, &LogicController::invoicesReady);
+    QSignalSpy expensesSpy(&logicController, &LogicController::expensesReady);
+    QSignalSpy billsSpy(&logicController, &LogicController::billsReady);
+    QBENCHMARK {
+        logicController.clearContainers();
+        if (kind == "invoices") {
+            QList<Invoice> received = invoices;
+            logicController.addInvoices(received);
+            logicController.finishInvoices();
+            QVERIFY(invoicesSpy.wait(PROCESSING_TIMEOUT));
+        } else if (kind == "expenses") {
+            QList<Expense> received = expenses;
+            logicController.addExpenses(received);
+            logicController.m_normalExpensesArrived = true;
+            logicController.m_recurrentExpensesArrived = true;
+            logicController.finishExpenses();
+            QVERIFY(expensesSpy.wait(PROCESSING_TIMEOUT));
+        } else {
+            QList<Bill> received = bills;
+            logicController.addBills(received);
+            logicController.m_normalBillsArrived = true;
+            logicController.m_recurrentBillsArrived = true;
+            logicController.finishBills();
+            QVERIFY(billsSpy.wait(PROCESSING_TIMEOUT));
+        }
+    }
+    QCOMPARE(logicController.invoices().size() + logicController.expenses().size() + logicController.bills().size(), size);
+}
+
+void PipelineBenchmark::rangeQueries()
+{
+    QFETCH(int, size);
+
+    LogicController logicController;
+    logicController.setBills(makeBills(size));
+
+    int found = 0;
+    QBENCHMARK {
+        found = 0;
+        for (int i = 0; i < NUMBER_OF_RANGE_QUERIES; ++i) {
+            const QDate &fromDate = FIRST_DATE.addDays(i * 7 % NUMBER_OF_DAYS);
+            logicController.setFromDate(fromDate);
+            logicController.setToDate(fromDate.addDays(30));
+            found += logicController.rangedBills().count();
+        }
+    }
+    QVERIFY(found > 0);
+}
+
+void PipelineBenchmark::rangeTotals()
+{
+    QFETCH(int, size);
+
+    // bills are converted to PLN the way synchronized ones are, so the totals aren't sums of zeros.
+    LogicController logicController;
+    logicController.prepareFakeRates();
+    QSignalSpy billsSpy(&logicController, &LogicController::billsReady);
+    QList<Bill> received = makeBills(size);
+    logicController.addBills(received);
+    logicController.m_normalBillsArrived = true;
+    logicController.m_recurrentBillsArrived = true;
+    logicController.finishBills();
+    QVERIFY(billsSpy.wait(PROCESSING_TIMEOUT));
+
+    // totals of all, of normal and of recurrent bills, as shown in the bills tab.
+    double sum = 0;
+    QBENCHMARK {
+        sum = 0;
+        for (int i = 0; i < NUMBER_OF_RANGE_QUERIES; ++i) {
+            const QDate &fromDate = FIRST_DATE.addDays(i * 7 % NUMBER_OF_DAYS);
+            logicController.setFromDate(fromDate);
+            logicController.setToDate(fromDate.addDays(30));
+            const DocumentRange<Bill> range = logicController.rangedBills();
+            const TransactionColumns &bills = logicController.transactions().bills();
+            sum += bills.plnSum(range.offset(), range.offset() + range.size());
+            sum += bills.plnSum(range.offset(), range.offset() + range.size(), TransactionColumns::Recurrent, 0);
+            sum += bills.plnSum(range.offset(), range.offset() + range.size(), TransactionColumns::Recurrent, TransactionColumns::Recurrent);
+        }
+    }
+    QVERIFY(sum > 0);
+}
+
+void PipelineBenchmark::columnKernels_data()
+{
+    // vectorized loops take 2 or 4 values at once, the remainders are summed up by the scalar loops.
+    QTest::addColumn<int>("count");
+    for (int count : {0, 1, 2, 3, 5, 6, 7, 9, 13, 1001}) {
+        QTest::newRow(QByteArray::number(count)) << count;
+    }
+}
+
+void PipelineBenchmark::columnKernels()
+{
+    QFETCH(int, count);
+
+    // quarters are summed up exactly in any order, so the kernels have to give exactly the scalar results.
+    const double rates[] = {1.0, 4.25, 3.75, 5.5};
+    QVector<double> values(count);
+    QVector<quint16> currencies(count);
+    QVector<quint8> flags(count);
+    for (int i = 0; i < count; ++i) {
+        values[i] = (i % 97) * 0.25 - 8;
+        currencies[i] = quint16(i % 4);
+        flags[i] = quint8(i % 3 == 0 ? TransactionColumns::Recurrent : 0) | quint8(i % 5 == 0 ? 0x80 : 0);
+    }
+
+    QVector<double> converted(count);
+    ColumnKernels::convert(values.constData(), currencies.constData(), rates, converted.data(), count);
+    for (int i = 0; i < count; ++i) {
+        QCOMPARE(converted.at(i), values.at(i) * rates[currencies.at(i)]);
+    }
+
+    double total = 0;
+    double recurrentTotal = 0;
+    double normalTotal = 0;
+    double taggedTotal = 0;
+    for (int i = 0; i < count; ++i) {
+        total += converted.at(i);
+        recurrentTotal += (flags.at(i) & TransactionColumns::Recurrent) == TransactionColumns::Recurrent ? converted.at(i) : 0.0;
+        normalTotal += (flags.at(i) & TransactionColumns::Recurrent) == 0 ? converted.at(i) : 0.0;
+        taggedTotal += flags.at(i) == (0x80 | TransactionColumns::Recurrent) ? converted.at(i) : 0.0;
+    }
+    QCOMPARE(ColumnKernels::sum(converted.constData(), count), total);
+    QCOMPARE(ColumnKernels::maskedSum(converted.constData(), flags.constData(), TransactionColumns::Recurrent,
+                                      TransactionColumns::Recurrent, count), recurrentTotal);
+    QCOMPARE(ColumnKernels::maskedSum(converted.constData(), flags.constData(), TransactionColumns::Recurrent, 0, count), normalTotal);
+    QCOMPARE(ColumnKernels::maskedSum(converted.constData(), flags.constData(), 0xff, 0x80 | TransactionColumns::Recurrent, count),
+             taggedTotal);
+    QCOMPARE(ColumnKernels::maskedSum(converted.constData(), flags.constData(), 0, 0, count), total);
+}
+
+void PipelineBenchmark::recurrenceWindow_data()
+{
+    QTest::addColumn<QDate>("startDate");
+    QTest::addColumn<int>("frequency");
+    QTest::addColumn<int>("interval");
+    QTest::addColumn<QDate>("from");
+    QTest::addColumn<QDate>("to");
+    QTest::addColumn<QVector<QDate>>("expected");
+
+    const QDate &from = FIRST_DATE.addDays(10);
+    const QDate &to = FIRST_DATE.addDays(40);
+    const int once = Recurrence::NoFrequency;
+    QTest::newRow("one-off before") << FIRST_DATE << once << 1 << from << to << QVector<QDate>();
+    QTest::newRow("one-off after") << to.addDays(1) << once << 1 << from << to << QVector<QDate>();
+    QTest::newRow("one-off on from") << from << once << 1 << from << to << QVector<QDate> {from};
+    QTest::newRow("one-off on to") << to << once << 1 << from << to << QVector<QDate> {to};
+    QTest::newRow("every 2 weeks across from") << FIRST_DATE << int(Recurrence::Weeks) << 2 << from << to
+                                               << QVector<QDate> {FIRST_DATE.addDays(14), FIRST_DATE.addDays(28)};
+}
+
+void PipelineBenchmark::recurrenceWindow()
+{
+    QFETCH(QDate, startDate);
+    QFETCH(int, frequency);
+    QFETCH(int, interval);
+    QFETCH(QDate, from);
+    QFETCH(QDate, to);
+    QFETCH(QVector<QDate>, expected);
+
+    const Recurrence recurrence(startDate, Recurrence::Frequency(frequency), interval);
+    QCOMPARE(recurrence.occurrences(from, to), expected);
+}
+
+void PipelineBenchmark::proxyFiltering()
+{
+    QFETCH(int, size);
+
+    LogicController logicController;
+    logicController.setFromDate(FIRST_DATE);
+    logicController.setToDate(FIRST_DATE.addDays(NUMBER_OF_DAYS + 30));
+    logicController.setBills(makeBills(size));
+    BillsModel model(&logicController);
+    BillsProxyModel proxyModel;
+    proxyModel.setSourceModel(&model);
+
+    // every run filters with another pattern, so the filter is evaluated again.
+    int run = 0;
+    QBENCHMARK {
+        proxyModel.setFilteringPattern(QString("Vendor %1").arg(run++ % 500));
+        proxyModel.rowCount();
+    }
+}
+
+void PipelineBenchmark::proxySorting()
+{
+    QFETCH(int, size);
+
+    LogicController logicController;
+    logicController.setFromDate(FIRST_DATE);
+    logicController.setToDate(FIRST_DATE.addDays(NUMBER_OF_DAYS + 30));
+    logicController.setBills(makeBills(size));
+    BillsModel model(&logicController);
+    BillsProxyModel proxyModel;
+    proxyModel.setSourceModel(&model);
+
+    // every run reverses the order, so the rows are sorted again.
+    Qt::SortOrder order = Qt::AscendingOrder;
+    QBENCHMARK {
+        proxyModel.sort(BillsModel::PlnTotalColumn, order);
+        order = order == Qt::AscendingOrder ? Qt::DescendingOrder : Qt::AscendingOrder;
+    }
+    QCOMPARE(proxyModel.rowCount(), size);
+}
+
+void PipelineBenchmark::chartBuilding()
+{
+    QFETCH(int, size);
+
+    // documents are split 2:2:1 into invoices, expenses and bills.
+    const QList<Invoice> &invoices = makeInvoices(size * 2 / 5);
+    const QList<Expense> &expenses = makeExpenses(size * 2 / 5);
+    const QList<Bill> &bills = makeBills(size - size * 4 / 5);
+    const QList<ForecastingModel::Forecast> forecasts;
+
+    LogicController logicController;
+    logicController.setFirstDate(FIRST_DATE);
+    logicController.setLastDate(FIRST_DATE.addDays(NUMBER_OF_DAYS));
+    logicController.setFromDate(FIRST_DATE);
+    logicController.setToDate(FIRST_DATE.addDays(NUMBER_OF_DAYS));
+
+    CashFlowChart chart(&logicController);
+    QBENCHMARK {
+        chart.resetYAxeRanges();
+        chart.setDates(FIRST_DATE, FIRST_DATE.addDays(NUMBER_OF_DAYS));
+        chart.prepareIncomeSeries(invoices, forecasts);
+        chart.prepareExpensesSeries(expenses, bills, forecasts);
+    }
+}
+
+QTEST_MAIN(PipelineBenchmark)
+
+#include "main.moc"
@@ -0,0 +1,15 @@
+# <copyright company="Scythe Studio Sp. z o.o.">
+#     This file contains proprietary code. Copyright (c) 2021. All rights reserved.
+#</copyright>
+
+include(../app.pri)
+
+QT += testlib
+
+CONFIG += console
+CONFIG -= app_bundle
+
+TARGET = pipeline
+
+SOURCES += \
+    main.cpp
@@ -0,0 +1,381 @@
+// <copyright company="Scythe Studio Sp. z o.o.">
+//     This file contains proprietary code. Copyright (c) 2021. All rights reserved.
+// </copyright>
+
+#include "StandInServer.h"
+#include <QHostAddress>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTimer>
+#include <QtMath>
+#include <algorithm>
+
+#define API_PREFIX "/api/v3/"
+#define ACCOUNTS_PREFIX "/oauth/v2/"
+#define HEADERS_END "\r\n\r\n"
+#define DEFAULT_SEED 1
+#define DEFAULT_FIRST_DATE QDate(2020, 1, 1)
+#define DEFAULT_NUMBER_OF_DAYS 1095
+#define DEFAULT_PAGE_SIZE 200 // the same limit as of Zoho Books API.
+#define DEFAULT_ERROR_STATUS 500
+#define ORGANIZATION_ID "20077575557"
+
+namespace {
+
+struct Currency {
+    const char *id;
+    const char *code;
+    double rate;
+};
+
+// currencies besides the base one, Zloty.
+const Currency CURRENCIES[] = {{"1", "EUR", 4.55}, {"2", "USD", 4.02}, {"3", "GBP", 5.21}};
+
+QByteArray reasonPhrase(int status)
+{
+    switch (status) {
+    case 200:
+        return "OK";
+    case 400:
+        return "Bad Request";
+    case 404:
+        return "Not Found";
+    case 429:
+        return "Too Many Requests";
+    case 503:
+        return "Service Unavailable";
+    default:
+        return status >= 500 ? "Internal Server Error" : "Error";
+    }
+}
+
+QByteArray toJson(const QJsonObject &object)
+{
+    return QJsonDocument(object).toJson(QJsonDocument::Compact);
+}
+
+} // namespace
+
+StandInServer::StandInServer(QObject *parent)
+    : QObject(parent)
+    , m_server(new QTcpServer(this))
+    , m_generator(DEFAULT_SEED, DEFAULT_FIRST_DATE, DEFAULT_NUMBER_OF_DAYS)
+    , m_maxPageSize(DEFAULT_PAGE_SIZE)
+    , m_errorStatus(DEFAULT_ERROR_STATUS)
+    , m_random(DEFAULT_SEED)
+{
+    connect(m_server, &QTcpServer::newConnection, this, &StandInServer::onNewConnection);
+}
+
+bool StandInServer::listen(quint16 port)
+{
+    return m_server->listen(QHostAddress::LocalHost, port);
+}
+
+quint16 StandInServer::port() const
+{
+    return m_server->serverPort();
+}
+
+QString StandInServer::apiAddress() const
+{
+    return QString("http://127.0.0.1:%1" API_PREFIX).arg(port());
+}
+
+QString StandInServer::accountsAddress() const
+{
+    return QString("http://127.0.0.1:%1" ACCOUNTS_PREFIX).arg(port());
+}
+
+void StandInServer::setDataset(quint64 seed, int numberOfRows)
+{
+    m_generator = DatasetGenerator(seed, DEFAULT_FIRST_DATE, DEFAULT_NUMBER_OF_DAYS);
+    m_numberOfRows = qMax(0, numberOfRows);
+    // latency jitter and injected errors repeat with the dataset.
+    m_random.seed(quint32(seed));
+}
+
+void StandInServer::setMaxPageSize(int value)
+{
+    m_maxPageSize = qMax(1, value);
+}
+
+void StandInServer::setLatency(int milliseconds, int jitterMilliseconds)
+{
+    m_latency = qMax(0, milliseconds);
+    m_jitter = qMax(0, jitterMilliseconds);
+}
+
+void StandInServer::setErrorRate(double percent, int status)
+{
+    m_errorPercent = qBound(0.0, percent, 100.0);
+    m_errorStatus = status;
+}
+
+int StandInServer::numberOfRequests() const
+{
+    QMutexLocker locker(&m_statisticsMutex);
+    return m_latencies.size();
+}
+
+int StandInServer::numberOfErrors() const
+{
+    QMutexLocker locker(&m_statisticsMutex);
+    return m_numberOfErrors;
+}
+
+qint64 StandInServer::latencyPercentile(double percentile) const
+{
+    QVector<qint64> latencies;
+    {
+        QMutexLocker locker(&m_statisticsMutex);
+        latencies = m_latencies;
+    }
+    if (latencies.isEmpty()) {
+        return 0;
+    }
+
+    const int rank = qBound(0, int(qCeil(percentile / 100.0 * latencies.size())) - 1, latencies.size() - 1);
+    std::nth_element(latencies.begin(), latencies.begin() + rank, latencies.end());
+    return latencies.at(rank);
+}
+
+void StandInServer::resetStatistics()
+{
+    QMutexLocker locker(&m_statisticsMutex);
+    m_latencies.clear();
+    m_numberOfErrors = 0;
+}
+
+void StandInServer::onNewConnection()
+{
+    while (QTcpSocket *socket = m_server->nextPendingConnection()) {
+        m_connections.insert(socket, Connection());
+        connect(socket, &QTcpSocket::readyRead, this, [=]() {
+            m_connections[socket].buffer += socket->readAll();
+            processBuffer(socket);
+        });
+        connect(socket, &QTcpSocket::disconnected, this, [=]() {
+            m_connections.remove(socket);
+            socket->deleteLater();
+        });
+    }
+}
+
+void StandInServer::processBuffer(QTcpSocket *socket)
+{
+    Connection &connection = m_connections[socket];
+    Request request;
+    if (connection.busy || !takeRequest(connection.buffer, request)) {
+        return;
+    }
+
+    connection.busy = true;
+    QElapsedTimer timer;
+    timer.start();
+    const int delay = m_latency + (m_jitter > 0 ? int(m_random.bounded(m_jitter + 1)) : 0);
+    // the socket is the context, so the response is dropped together with a closed connection.
+    QTimer::singleShot(delay, socket, [=]() {
+        respond(socket, request, timer);
+    });
+}
+
+bool StandInServer::takeRequest(QByteArray &buffer, Request &request) const
+{
+    const int headersEnd = buffer.indexOf(HEADERS_END);
+    if (headersEnd == -1) {
+        return false;
+    }
+
+    const QList<QByteArray> &lines = buffer.left(headersEnd).split('\n');
+    const QList<QByteArray> &requestLine = lines.first().trimmed().split(' ');
+    int contentLength = 0;
+    bool keepAlive = requestLine.value(2) != "HTTP/1.0";
+    for (int i = 1; i < lines.size(); ++i) {
+        const int colon = lines.at(i).indexOf(':');
+        const QByteArray &name = lines.at(i).left(colon).trimmed().toLower();
+        const QByteArray &value = lines.at(i).mid(colon + 1).trimmed().toLower();
+        if (name == "content-length") {
+            contentLength = value.toInt();
+        } else if (name == "connection") {
+            keepAlive = value == "keep-alive";
+        }
+    }
+
+    const int requestSize = headersEnd + int(qstrlen(HEADERS_END)) + contentLength;
+    if (buffer.size() < requestSize) {
+        return false;
+    }
+
+    const QUrl url(QString::fromLatin1(requestLine.value(1)));
+    request.method = requestLine.value(0);
+    request.path = url.path();
+    request.query = QUrlQuery(url);
+    request.keepAlive = keepAlive;
+    buffer.remove(0, requestSize);
+    return true;
+}
+
+void StandInServer::respond(QTcpSocket *socket, const Request &request, const QElapsedTimer &timer)
+{
+    if (!m_connections.contains(socket)) {
+        return;
+    }
+
+    const bool injectError = m_errorPercent > 0 && m_random.bounded(100.0) < m_errorPercent;
+    const Response &response = injectError ? errorResponse(m_errorStatus, 1, "Error injected by the stand-in server.")
+                                           : route(request);
+
+    QByteArray head = "HTTP/1.1 " + QByteArray::number(response.status) + ' ' + reasonPhrase(response.status) + "\r\n";
+    head += "Content-Type: application/json;charset=UTF-8\r\n";
+    head += "Content-Length: " + QByteArray::number(response.body.size()) + "\r\n";
+    head += request.keepAlive ? "Connection: keep-alive\r\n\r\n" : "Connection: close\r\n\r\n";
+    socket->write(head);
+    socket->write(response.body);
+
+    {
+        QMutexLocker locker(&m_statisticsMutex);
+        m_latencies << timer.nsecsElapsed() / 1000;
+        if (injectError) {
+            ++m_numberOfErrors;
+        }
+    }
+
+    if (!request.keepAlive) {
+        socket->disconnectFromHost();
+        return;
+    }
+    m_connections[socket].busy = false;
+    processBuffer(socket);
+}
+
+StandInServer::Response StandInServer::route(const Request &request) const
+{
+    if (request.path.startsWith(ACCOUNTS_PREFIX)) {
+        if (request.method != "POST" || request.path.mid(int(qstrlen(ACCOUNTS_PREFIX))) != "token") {
+            return errorResponse(404, 5, "Invalid URL Passed");
+        }
+        QJsonObject tokens;
+        tokens.insert("access_token", "stand-in-access-token");
+        tokens.insert("refresh_token", "stand-in-refresh-token");
+        tokens.insert("expires_in", 3600);
+        return {200, toJson(tokens)};
+    }
+
+    if (!request.path.startsWith(API_PREFIX) || request.method != "GET") {
+        return errorResponse(404, 5, "Invalid URL Passed");
+    }
+
+    const QStringList &parts = request.path.mid(int(qstrlen(API_PREFIX))).split('/', Qt::SkipEmptyParts);
+    if (parts == QStringList {"organizations"}) {
+        QJsonObject organization;
+        organization.insert("organization_id", ORGANIZATION_ID);
+        organization.insert("name", "Stand-in organization");
+        QJsonObject response;
+        response.insert("code", 0);
+        response.insert("message", "success");
+        response.insert("organizations", QJsonArray {organization});
+        return {200, toJson(response)};
+    }
+    if (parts == QStringList {"settings", "currencies"}) {
+        return currenciesResponse();
+    }
+    if (parts.size() == 4 && parts.at(0) == "settings" && parts.at(1) == "currencies" && parts.at(3) == "exchangerates") {
+        return exchangeRatesResponse(parts.at(2));
+    }
+    if (parts.size() == 2 && parts.at(0) == DatasetGenerator::endpoint(DatasetGenerator::RecurrentBills)) {
+        return recurringBillResponse(parts.at(1));
+    }
+    if (parts.size() == 1) {
+        for (int kind = 0; kind < DatasetGenerator::KindCount; ++kind) {
+            if (parts.first() == DatasetGenerator::endpoint(DatasetGenerator::Kind(kind))) {
+                return listResponse(DatasetGenerator::Kind(kind), request.query);
+            }
+        }
+    }
+    return errorResponse(404, 5, "Invalid URL Passed");
+}
+
+StandInServer::Response StandInServer::listResponse(DatasetGenerator::Kind kind, const QUrlQuery &query) const
+{
+    const int page = qMax(1, query.queryItemValue("page").toInt());
+    const int requestedPageSize = query.queryItemValue("per_page").toInt();
+    const int pageSize = requestedPageSize > 0 ? qMin(requestedPageSize, m_maxPageSize) : m_maxPageSize;
+    const int count = DatasetGenerator::count(kind, m_numberOfRows);
+    const qint64 first = qint64(page - 1) * pageSize;
+    const int last = int(qMin<qint64>(count, first + pageSize));
+
+    // documents are written one by one, just like Zoho does, instead of building the whole array first.
+    QByteArray body = "{\"code\":0,\"message\":\"success\",\"" + DatasetGenerator::listKey(kind).toUtf8() + "\":[";
+    for (qint64 index = first; index < last; ++index) {
+        if (index > first) {
+            body += ',';
+        }
+        body += toJson(m_generator.jsonObject(kind, int(index)));
+    }
+    body += "],\"page_context\":{\"page\":" + QByteArray::number(page)
+            + ",\"per_page\":" + QByteArray::number(pageSize)
+            + ",\"has_more_page\":" + (last < count ? "true" : "false") + "}}";
+    return {200, body};
+}
+
+StandInServer::Response StandInServer::recurringBillResponse(const QString &id) const
+{
+    const int index = DatasetGenerator::indexOf(DatasetGenerator::RecurrentBills, id);
+    if (index == -1 || index >= DatasetGenerator::count(DatasetGenerator::RecurrentBills, m_numberOfRows)) {
+        return errorResponse(404, 1002, "Recurring bill does not exist.");
+    }
+
+    QJsonObject response;
+    response.insert("code", 0);
+    response.insert("message", "success");
+    response.insert("recurring_bill", m_generator.jsonObject(DatasetGenerator::RecurrentBills, index));
+    return {200, toJson(response)};
+}
+
+StandInServer::Response StandInServer::currenciesResponse() const
+{
+    QJsonArray currencies;
+    for (const Currency &currency : CURRENCIES) {
+        QJsonObject object;
+        object.insert("currency_id", currency.id);
+        object.insert("currency_code", currency.code);
+        object.insert("is_base_currency", false);
+        currencies << object;
+    }
+
+    QJsonObject response;
+    response.insert("code", 0);
+    response.insert("message", "success");
+    response.insert("currencies", currencies);
+    return {200, toJson(response)};
+}
+
+StandInServer::Response StandInServer::exchangeRatesResponse(const QString &currencyId) const
+{
+    for (const Currency &currency : CURRENCIES) {
+        if (currencyId == currency.id) {
+            QJsonObject rate;
+            rate.insert("currency_code", currency.code);
+            rate.insert("rate", currency.rate);
+            rate.insert("effective_date", DEFAULT_FIRST_DATE.toString("yyyy-MM-dd"));
+
+            QJsonObject response;
+            response.insert("code", 0);
+            response.insert("message", "success");
+            response.insert("exchange_rates", QJsonArray {rate});
+            return {200, toJson(response)};
+        }
+    }
+    return errorResponse(404, 1002, "Currency does not exist.");
+}
+
+StandInServer::Response StandInServer::errorResponse(int status, int code, const QString &message)
+{
+    QJsonObject response;
+    response.insert("code", code);
+    response.insert("message", message);
+    return {status, toJson(response)};
+}
@@ -0,0 +1,153 @@
+// <copyright company="Scythe Studio Sp. z o.o.">
+//     This file contains proprietary code. Copyright (c) 2021. All rights reserved.
+// </copyright>
+
+#ifndef STANDINSERVER_H
+#define STANDINSERVER_H
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMutex>
+#include <QObject>
+#include <QRandomGenerator>
+#include <QUrlQuery>
+#include <QVector>
+
+#include "DatasetGenerator.h"
+
+class QTcpServer;
+class QTcpSocket;
+
+/*!
+ * \brief Class representing a local HTTP server standing in for Zoho Books and Zoho Accounts. It serves paginated
+ * documents of a synthetic dataset, currencies, exchange rates and tokens with tunable latency and injected errors,
+ * so fetching can be measured without the live service. Statistics can be read from any thread.
+ */
+class StandInServer : public QObject
+{
+    Q_OBJECT
+public:
+
+    /*!
+     * \brief Constructor.
+     */
+    explicit StandInServer(QObject *parent = nullptr);
+
+    /*!
+     * \brief Starts listening on the local interface. Returns true on success.
+     * \param quint16 port -- port to listen on, 0 picks any free port.
+     */
+    bool listen(quint16 port = 0);
+
+    /*!
+     * \brief Returns the port the server listens on.
+     */
+    quint16 port() const;
+
+    /*!
+     * \brief Returns address to be set with WebClient::setApiAddress().
+     */
+    QString apiAddress() const;
+
+    /*!
+     * \brief Returns address to be set with WebClient::setAccountsAddress().
+     */
+    QString accountsAddress() const;
+
+    /*!
+     * \brief Sets dataset served by the server.
+     * \param quint64 seed -- seed of the dataset.
+     * \param int numberOfRows -- number of documents of all kinds.
+     */
+    void setDataset(quint64 seed, int numberOfRows);
+
+    /*!
+     * \brief Sets maximal number of documents on a page, bigger per_page values are cut down to it.
+     * \param int value -- value to set.
+     */
+    void setMaxPageSize(int value);
+
+    /*!
+     * \brief Sets delay of every response.
+     * \param int milliseconds -- fixed part of the delay.
+     * \param int jitterMilliseconds -- upper bound of the random part of the delay.
+     */
+    void setLatency(int milliseconds, int jitterMilliseconds);
+
+    /*!
+     * \brief Sets share of requests answered with an error.
+     * \param double percent -- value to set, from 0 to 100.
+     * \param int status -- HTTP status of injected errors, i.e. 500 or 429.
+     */
+    void setErrorRate(double percent, int status);
+
+    /*!
+     * \brief Returns number of requests answered since the statistics have been reset.
+     */
+    int numberOfRequests() const;
+
+    /*!
+     * \brief Returns number of injected errors since the statistics have been reset.
+     */
+    int numberOfErrors() const;
+
+    /*!
+     * \brief Returns the given percentile of times between receiving a request and writing its response, in microseconds.
+     * \param double percentile -- percentile from 0 to 100.
+     */
+    qint64 latencyPercentile(double percentile) const;
+
+    /*!
+     * \brief Forgets all answered requests.
+     */
+    void resetStatistics();
+
+private:
+    struct Request {
+        QByteArray method;
+        QString path;
+        QUrlQuery query;
+        bool keepAlive;
+    };
+
+    struct Response {
+        int status;
+        QByteArray body;
+    };
+
+    // incoming data of a connection. Requests of a connection are answered one by one, in order.
+    struct Connection {
+        QByteArray buffer;
+        bool busy = false;
+    };
+
+    void onNewConnection();
+    void processBuffer(QTcpSocket *socket);
+    bool takeRequest(QByteArray &buffer, Request &request) const;
+    void respond(QTcpSocket *socket, const Request &request, const QElapsedTimer &timer);
+
+    Response route(const Request &request) const;
+    Response listResponse(DatasetGenerator::Kind kind, const QUrlQuery &query) const;
+    Response recurringBillResponse(const QString &id) const;
+    Response currenciesResponse() const;
+    Response exchangeRatesResponse(const QString &currencyId) const;
+    static Response errorResponse(int status, int code, const QString &message);
+
+    QTcpServer *m_server = nullptr;
+    QHash<QTcpSocket *, Connection> m_connections;
+
+    DatasetGenerator m_generator;
+    int m_numberOfRows = 0;
+    int m_maxPageSize;
+    int m_latency = 0;
+    int m_jitter = 0;
+    double m_errorPercent = 0;
+    int m_errorStatus;
+    QRandomGenerator m_random;
+
+    mutable QMutex m_statisticsMutex;
+    QVector<qint64> m_latencies;
+    int m_numberOfErrors = 0;
+};
+
+#endif // STANDINSERVER_H
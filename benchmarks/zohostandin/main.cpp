@@ -0,0 +1,71 @@
+// <copyright company="Scythe Studio Sp. z o.o.">
+//     This file contains proprietary code. Copyright (c) 2021. All rights reserved.
+// </copyright>
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QTextStream>
+#include <QTimer>
+
+#include "StandInServer.h"
+
+#define DEFAULT_PORT "8080"
+#define DEFAULT_NUMBER_OF_ROWS "100000"
+#define DEFAULT_SEED "1"
+#define DEFAULT_PAGE_SIZE "200"
+#define DEFAULT_ERROR_STATUS "500"
+#define REPORT_INTERVAL 5000 // ms
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("zohostandin");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Serves a synthetic dataset through the same endpoints as Zoho Books API, "
+                                     "so fetching can be load tested offline.");
+    parser.addHelpOption();
+    parser.addOptions({
+        {"port", "Port to listen on.", "port", DEFAULT_PORT},
+        {"rows", "Number of documents of all kinds.", "rows", DEFAULT_NUMBER_OF_ROWS},
+        {"seed", "Seed of the dataset, latency jitter and injected errors.", "seed", DEFAULT_SEED},
+        {"page-size", "Maximal number of documents on a page.", "documents", DEFAULT_PAGE_SIZE},
+        {"latency", "Fixed delay of every response.", "ms", "0"},
+        {"jitter", "Upper bound of the random delay added to every response.", "ms", "0"},
+        {"error-rate", "Percent of requests answered with an error.", "percent", "0"},
+        {"error-status", "HTTP status of injected errors.", "status", DEFAULT_ERROR_STATUS}
+    });
+    parser.process(app);
+
+    StandInServer server;
+    server.setDataset(parser.value("seed").toULongLong(), parser.value("rows").toInt());
+    server.setMaxPageSize(parser.value("page-size").toInt());
+    server.setLatency(parser.value("latency").toInt(), parser.value("jitter").toInt());
+    server.setErrorRate(parser.value("error-rate").toDouble(), parser.value("error-status").toInt());
+
+    QTextStream out(stdout);
+    if (!server.listen(quint16(parser.value("port").toUInt()))) {
+        QTextStream(stderr) << "Cannot listen on port " << parser.value("port") << endl;
+        return 1;
+    }
+    out << "Zoho Books API: " << server.apiAddress() << endl;
+    out << "Zoho Accounts: " << server.accountsAddress() << endl;
+    out << "Set them as apiAddress and accountsAddress in the application settings to fetch from this server." << endl;
+
+    // statistics are reported only when something has been requested since the last report.
+    int reportedRequests = 0;
+    QTimer reportTimer;
+    QObject::connect(&reportTimer, &QTimer::timeout, [&]() {
+        const int requests = server.numberOfRequests();
+        if (requests == reportedRequests) {
+            return;
+        }
+        reportedRequests = requests;
+        out << "requests: " << requests << ", errors: " << server.numberOfErrors()
+            << ", latency p50/p95/p99: " << server.latencyPercentile(50) / 1000.0 << '/'
+            << server.latencyPercentile(95) / 1000.0 << '/' << server.latencyPercentile(99) / 1000.0 << " ms" << endl;
+    });
+    reportTimer.start(REPORT_INTERVAL);
+
+    return app.exec();
+}
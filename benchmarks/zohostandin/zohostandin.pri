@@ -0,0 +1,17 @@
+# <copyright company="Scythe Studio Sp. z o.o.">
+#     This file contains proprietary code. Copyright (c) 2021. All rights reserved.
+#</copyright>
+
+# Local stand-in for Zoho Books API, shared by the server tool and network benchmarks.
+
+QT += network
+
+include(../datasetgenerator/datasetgenerator.pri)
+
+INCLUDEPATH += $$PWD
+
+SOURCES += \
+    $$PWD/StandInServer.cpp
+
+HEADERS += \
+    $$PWD/StandInServer.h
@@ -0,0 +1,219 @@
+// <copyright company="Scythe Studio Sp. z o.o.">
+//     This file contains proprietary code. Copyright (c) 2021. All rights reserved.
+// </copyright>
+
+#include "HeadlessRunner.h"
+#include "plotting/ForecastEngine.h"
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTextStream>
+
+#define HEADLESS_ARGUMENT "--headless"
+#define DATE_FORMAT "yyyy-MM-dd"
+#define NUMBER_OF_DOCUMENT_KINDS 3 // invoices, expenses and bills.
+
+bool HeadlessRunner::isRequested(int argc, char *argv[])
+{
+    for (int i = 1; i < argc; ++i) {
+        if (qstrcmp(argv[i], HEADLESS_ARGUMENT) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+HeadlessRunner::HeadlessRunner(QObject *parent)
+    : QObject(parent)
+    , m_logicController(new LogicController(this))
+{
+    connect(m_logicController, &LogicController::invoicesReady, this, &HeadlessRunner::onDocumentsReady);
+    connect(m_logicController, &LogicController::expensesReady, this, &HeadlessRunner::onDocumentsReady);
+    connect(m_logicController, &LogicController::billsReady, this, &HeadlessRunner::onDocumentsReady);
+    // periods of incomplete documents would look complete, so nothing is written.
+    connect(m_logicController, &LogicController::synchronizationFailed, this, [this](const QStringList &endpointNames) {
+        fail("Some documents couldn't be downloaded: " + endpointNames.join(", ") + ".");
+    });
+}
+
+bool HeadlessRunner::parseArguments(const QStringList &arguments)
+{
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Writes income, expenses and cash flow of every period to the standard output.");
+    const QCommandLineOption helpOption = parser.addHelpOption();
+    parser.addOptions({
+        {"headless", "Runs without the graphical interface."},
+        {"from", "First date of the forecast.", "yyyy-MM-dd"},
+        {"to", "Last date of the forecast.", "yyyy-MM-dd"},
+        {"format", "Output format: csv (default) or json.", "format", "csv"},
+        {"granularity", "Length of periods: daily, weekly, monthly (default) or quarterly.", "granularity", "monthly"},
+        {"data", "Directory with invoices.csv, normalExpenses.csv, recurrentExpenses.csv, normalBills.csv and recurrentBills.csv "
+                 "converted with demo exchange rates. Documents saved after the last synchronization are used if not set.", "directory"},
+        {"demo", "Uses mock-data bundled with the application."},
+        {"forecast", "Adds a forecast, may be repeated. Recurrent forecasts repeat every month.", "price:yyyy-MM-dd:income|expense[:recurrent]"},
+        {"no-forecasting", "Does not expand recurrent documents and forecasts."}
+    });
+
+    if (!parser.parse(arguments)) {
+        fail(parser.errorText());
+        return false;
+    }
+    if (parser.isSet(helpOption)) {
+        parser.showHelp();
+    }
+
+    m_fromDate = QDate::fromString(parser.value("from"), DATE_FORMAT);
+    m_toDate = QDate::fromString(parser.value("to"), DATE_FORMAT);
+    if (!m_fromDate.isValid() || !m_toDate.isValid() || m_fromDate >= m_toDate) {
+        fail("Valid --from and --to dates are required, --from has to be earlier than --to.");
+        return false;
+    }
+
+    const QString format = parser.value("format").toLower();
+    if (format == "csv") {
+        m_format = Csv;
+    } else if (format == "json") {
+        m_format = Json;
+    } else {
+        fail("Unknown format: " + format);
+        return false;
+    }
+
+    if (!parseGranularity(parser.value("granularity").toLower(), m_granularity)) {
+        fail("Unknown granularity: " + parser.value("granularity"));
+        return false;
+    }
+
+    m_dataDirectory = parser.isSet("demo") ? DEMO_DATA_DIRECTORY : parser.value("data");
+
+    for (const QString &value : parser.values("forecast")) {
+        ForecastingModel::Forecast forecast;
+        if (!parseForecast(value, forecast)) {
+            fail("Invalid forecast: " + value);
+            return false;
+        }
+        forecast.name = QString("Forecast %1").arg(m_logicController->forecasts().size() + 1);
+        m_logicController->forecasts().append(forecast);
+    }
+
+    m_logicController->setForecastingEnabled(!parser.isSet("no-forecasting"));
+    return true;
+}
+
+void HeadlessRunner::start()
+{
+    // the same dates are set as after clicking the update button.
+    m_logicController->setFirstDate(m_fromDate);
+    m_logicController->setLastDate(m_toDate);
+    m_logicController->setFromDate(m_fromDate);
+    m_logicController->setToDate(m_toDate);
+    // scenario runs must not replace documents saved by the application.
+    m_logicController->setSnapshotSavingEnabled(false);
+    m_readyDocuments = 0;
+
+    if (m_dataDirectory.isEmpty()) {
+        if (!m_logicController->loadSnapshot()) {
+            fail("No saved documents found, use --data or --demo.");
+        }
+    } else {
+        m_logicController->prepareFakeRates();
+        m_logicController->setDataDirectory(m_dataDirectory);
+        m_logicController->readFiles();
+    }
+}
+
+void HeadlessRunner::onDocumentsReady()
+{
+    if (++m_readyDocuments == NUMBER_OF_DOCUMENT_KINDS) {
+        // texts that couldn't be stored would be read back as "?", i.e. currencies without exchange rates.
+        if (CompactSymbol::hasOverflowed()) {
+            fail("Documents have too many distinct statuses, currencies or recurrence frequencies, check the columns of the files.");
+            return;
+        }
+        writePeriods();
+        QCoreApplication::exit(0);
+    }
+}
+
+void HeadlessRunner::writePeriods()
+{
+    ForecastEngine forecastEngine;
+    forecastEngine.setDates(m_logicController->firstDate(), m_logicController->lastDate(), m_fromDate, m_toDate);
+    forecastEngine.setForecastingEnabled(m_logicController->isForecastingEnabled());
+
+    const QList<ForecastingModel::Forecast> &forecasts = m_logicController->forecasts();
+    const TransactionStore &transactions = m_logicController->transactions();
+    const QVector<ForecastEngine::DayAmount> incomeDays = forecastEngine.incomeDays(transactions.invoices(), forecasts);
+    const QVector<ForecastEngine::DayAmount> expensesDays = forecastEngine.expensesDays(transactions.expenses(),
+                                                                                       transactions.bills(), forecasts);
+    PeriodEngine periodEngine;
+    periodEngine.setPoints(ForecastEngine::points(incomeDays, expensesDays));
+    const QVector<PeriodEngine::Period> periods = periodEngine.periods(forecastEngine.start(), forecastEngine.limit(), m_granularity);
+
+    QTextStream out(stdout);
+    if (m_format == Json) {
+        QJsonArray array;
+        for (const PeriodEngine::Period &period : periods) {
+            QJsonObject object;
+            object.insert("start_date", period.startDate.toString(DATE_FORMAT));
+            object.insert("end_date", period.endDate.toString(DATE_FORMAT));
+            object.insert("income", period.incomeSum);
+            object.insert("expenses", period.expensesSum);
+            object.insert("balance", period.balance);
+            object.insert("cash_flow", period.cashFlow);
+            array.append(object);
+        }
+        out << QJsonDocument(array).toJson();
+    } else {
+        out << "start_date,end_date,income,expenses,balance,cash_flow\n";
+        for (const PeriodEngine::Period &period : periods) {
+            out << period.startDate.toString(DATE_FORMAT) << ','
+                << period.endDate.toString(DATE_FORMAT) << ','
+                << QString::number(period.incomeSum, 'f', 2) << ','
+                << QString::number(period.expensesSum, 'f', 2) << ','
+                << QString::number(period.balance, 'f', 2) << ','
+                << QString::number(period.cashFlow, 'f', 2) << '\n';
+        }
+    }
+}
+
+void HeadlessRunner::fail(const QString &message)
+{
+    QTextStream(stderr) << message << '\n';
+    QCoreApplication::exit(1);
+}
+
+bool HeadlessRunner::parseForecast(const QString &value, ForecastingModel::Forecast &forecast)
+{
+    const QStringList parts = value.split(':');
+    if (parts.size() < 3 || parts.size() > 4) {
+        return false;
+    }
+
+    bool ok = false;
+    forecast.price = parts.at(0).toDouble(&ok);
+    forecast.date = QDate::fromString(parts.at(1), DATE_FORMAT);
+    const QString kind = parts.at(2).toLower();
+    forecast.isIncome = kind == "income";
+    forecast.isRecurrent = parts.size() == 4 && parts.at(3).toLower() == "recurrent";
+    return ok && forecast.date.isValid() && (kind == "income" || kind == "expense")
+            && (parts.size() == 3 || forecast.isRecurrent);
+}
+
+bool HeadlessRunner::parseGranularity(const QString &value, PeriodEngine::Granularity &granularity)
+{
+    if (value == "daily") {
+        granularity = PeriodEngine::Daily;
+    } else if (value == "weekly") {
+        granularity = PeriodEngine::Weekly;
+    } else if (value == "monthly") {
+        granularity = PeriodEngine::Monthly;
+    } else if (value == "quarterly") {
+        granularity = PeriodEngine::Quarterly;
+    } else {
+        return false;
+    }
+    return true;
+}
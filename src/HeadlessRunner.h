@@ -0,0 +1,74 @@
+// <copyright company="Scythe Studio Sp. z o.o.">
+//     This file contains proprietary code. Copyright (c) 2021. All rights reserved.
+// </copyright>
+
+#ifndef HEADLESSRUNNER_H
+#define HEADLESSRUNNER_H
+
+#include "LogicController.h"
+#include "plotting/PeriodEngine.h"
+#include <QObject>
+#include <QDate>
+
+/*!
+ * \brief Class representing the command-line mode of the application. Documents are taken from the snapshot
+ * or from CSV files, income, expenses and cash flow of every period are written to the standard output.
+ */
+class HeadlessRunner : public QObject
+{
+    Q_OBJECT
+public:
+
+    /*!
+     * \brief Format of the written periods.
+     */
+    enum Format {
+        Csv,
+        Json
+    };
+
+    /*!
+     * \brief Returns true if the application is started with the '--headless' argument. Otherwise false.
+     * Checked before any application object exists, so no display is needed in this mode.
+     * \param int argc -- number of arguments.
+     * \param char *argv[] -- arguments.
+     */
+    static bool isRequested(int argc, char *argv[]);
+
+    /*!
+     * \brief Constructor.
+     * \param QObject *parent -- parent.
+     */
+    explicit HeadlessRunner(QObject *parent = nullptr);
+
+    /*!
+     * \brief Reads options from the command line. Returns false and prints the reason if they are not valid.
+     * \param const QStringList &arguments -- arguments of the application.
+     */
+    bool parseArguments(const QStringList &arguments);
+
+    /*!
+     * \brief Starts reading documents. The application quits after the periods have been written.
+     */
+    void start();
+
+private:
+    void onDocumentsReady();
+    void writePeriods();
+    void fail(const QString &message);
+
+    static bool parseForecast(const QString &value, ForecastingModel::Forecast &forecast);
+    static bool parseGranularity(const QString &value, PeriodEngine::Granularity &granularity);
+
+    LogicController *m_logicController = nullptr;
+
+    QDate m_fromDate;
+    QDate m_toDate;
+    Format m_format = Csv;
+    PeriodEngine::Granularity m_granularity = PeriodEngine::Monthly;
+    QString m_dataDirectory; // empty if documents are taken from the snapshot.
+
+    int m_readyDocuments = 0; // number of document kinds already processed.
+};
+
+#endif // HEADLESSRUNNER_H
@@ -4,40 +4,202 @@
 
 #include "LogicController.h"
 #include <QDate>
-#include <QFile>
+#include "datasets/ColumnKernels.h"
+#include "datasets/CsvReader.h"
 #include <QStyleFactory>
+#include <QFutureWatcher>
+#include <QtConcurrent>
+#include <algorithm>
 
 #define NUMBER_OF_SUPPORTED_EXCHANGE_RATES 11
+#define IMPORT_OVERFLOW_ERROR "Documents have too many distinct statuses, currencies or recurrence frequencies. " \
+                              "Check the columns of the imported files and restart the application."
+
+// Recurring and normal documents come from different endpoints, so their ids are kept apart.
+static QString invoiceKey(const Invoice &invoice)
+{
+    return invoice.invoiceId();
+}
+
+static QString expenseKey(const Expense &expense)
+{
+    return expense.expenseId().isEmpty() ? QString() : (expense.isRecurrent() ? "r:" : "n:") + expense.expenseId();
+}
+
+static QString billKey(const Bill &bill)
+{
+    return bill.billId().isEmpty() ? QString() : (bill.isRecurrent() ? "r:" : "n:") + bill.billId();
+}
+
+// Replaces documents which are already stored and appends the new ones. Documents without id are always appended.
+template <typename T>
+static void mergeById(QList<T> &stored, QHash<QString, int> &index, const QList<T> &documents, QString (*key)(const T &))
+{
+    for (const T &document : documents) {
+        const QString &id = key(document);
+        const auto it = index.constFind(id);
+        if (!id.isEmpty() && it != index.constEnd()) {
+            stored[it.value()] = document;
+        } else {
+            if (!id.isEmpty()) {
+                index.insert(id, stored.size());
+            }
+            stored.append(document);
+        }
+    }
+}
+
+// Positions change after sorting, so the index has to be built again.
+template <typename T>
+static void rebuildIndex(const QList<T> &stored, QHash<QString, int> &index, QString (*key)(const T &))
+{
+    index.clear();
+    index.reserve(stored.size());
+    for (int i = 0; i < stored.size(); ++i) {
+        const QString &id = key(stored.at(i));
+        if (!id.isEmpty()) {
+            index.insert(id, i);
+        }
+    }
+}
+
+// Rates by currency id, covering ids up to the given one. Currencies without a rate are Zlote, so their rate is 1.
+static QVector<double> ratesByCurrencyId(const QMap<QString, double> &exchangeRates, quint16 maxCurrencyId)
+{
+    QVector<quint16> ids;
+    ids.reserve(exchangeRates.size());
+    for (auto it = exchangeRates.constBegin(); it != exchangeRates.constEnd(); ++it) {
+        ids << CompactSymbol(it.key()).code();
+        maxCurrencyId = qMax(maxCurrencyId, ids.last());
+    }
+
+    QVector<double> rates(maxCurrencyId + 1, 1.0);
+    int i = 0;
+    for (auto it = exchangeRates.constBegin(); it != exchangeRates.constEnd(); ++it) {
+        rates[ids.at(i++)] = it.value();
+    }
+    return rates;
+}
+
+// Result of processing handed back from a worker thread.
+template <typename T>
+struct ProcessedDocuments {
+    QList<T> documents;
+    QHash<QString, int> index;
+    TransactionColumns columns;
+};
+
+// Runs on a worker thread. Containers are passed by value, so the ones displayed in the meantime are not touched.
+template <typename T>
+static ProcessedDocuments<T> processDocuments(QList<T> stored, QHash<QString, int> index, QList<T> received,
+                                              const QMap<QString, double> &exchangeRates,
+                                              QString (*key)(const T &), QDate (*sortDate)(const T &),
+                                              TransactionColumns (*columns)(const QList<T> &))
+{
+    // currency codes are mapped to rates once, then all the amounts are converted in a single pass over the columns.
+    QVector<double> amounts(received.size());
+    QVector<quint16> currencies(received.size());
+    quint16 maxCurrencyId = 0;
+    for (int i = 0; i < received.size(); ++i) {
+        amounts[i] = received.at(i).total();
+        currencies[i] = received.at(i).currencyId();
+        maxCurrencyId = qMax(maxCurrencyId, currencies.at(i));
+    }
+    const QVector<double> &rates = ratesByCurrencyId(exchangeRates, maxCurrencyId);
+    ColumnKernels::convert(amounts.constData(), currencies.constData(), rates.constData(), amounts.data(), amounts.size());
+    for (int i = 0; i < received.size(); ++i) {
+        received[i].setPlnTotal(amounts.at(i));
+    }
+
+    mergeById(stored, index, received, key);
+
+    std::sort(stored.begin(), stored.end(), [sortDate](const T &d1, const T &d2) {
+        return sortDate(d1) < sortDate(d2);
+    });
+    rebuildIndex(stored, index, key);
+
+    return {stored, index, columns(stored)};
+}
+
+// Documents are ordered by the date used for picking them between 'from date' and 'to date', so the range is binary searched
+// in the column of these dates.
+template <typename T>
+static DocumentRange<T> findRange(const QList<T> &documents, const TransactionColumns &columns, const QDate &from, const QDate &to)
+{
+    const int first = columns.lowerBound(from);
+    return DocumentRange<T>(&documents, first, qMax(first, columns.upperBound(to)));
+}
+
+// Runs on a thread pool, parses a single part of a CSV file.
+template <typename T>
+static QList<T> parseCsvPart(CsvReader part, T (*parse)(const CsvReader &))
+{
+    QList<T> documents;
+    while (part.readRow()) {
+        documents.append(parse(part));
+    }
+    return documents;
+}
+
+// Parts of the file are parsed in parallel and merged in the order of the file. The first line is skipped.
+template <typename T>
+static QList<T> parseCsvFile(CsvReader &reader, T (*parse)(const CsvReader &), int threadCount)
+{
+    reader.readRow();
+
+    QList<QFuture<QList<T>>> futures;
+    for (const CsvReader &part : reader.split(threadCount)) {
+        futures << QtConcurrent::run(&parseCsvPart<T>, part, parse);
+    }
+
+    QList<T> documents;
+    for (QFuture<QList<T>> &future : futures) {
+        documents.append(future.result());
+    }
+    return documents;
+}
 
 LogicController::LogicController(QObject *parent)
     : QObject(parent)
     , m_settings(new Settings(this))
     , m_webClient(new WebClient(this))
+    , m_snapshotStore(new SnapshotStore(this))
+    , m_importThreadCount(QThread::idealThreadCount())
 {
-    connect(m_webClient, &WebClient::invoicesReceived, this, [&](QList<Invoice> list){
-        setInvoices(list);
-    });
+    m_webClient->setMaxConcurrentRequests(m_settings->maxConcurrentRequests());
+    m_webClient->setApiAddress(m_settings->apiAddress());
+    m_webClient->setAccountsAddress(m_settings->accountsAddress());
 
-    // It is important to keep consistency here and set '...Arrived' variable to true before adding objects.
-    connect(m_webClient, &WebClient::normalExpensesReceived, this, [this] {
+    // Pages are streamed into containers as they land. Sorting and bounds are calculated once all pages are in.
+    connect(m_webClient, &WebClient::invoicesReceived, this, &LogicController::addInvoices);
+    connect(m_webClient, &WebClient::allInvoicesReceived, this, &LogicController::finishInvoices);
+
+    connect(m_webClient, &WebClient::normalExpensesReceived, this, &LogicController::addExpenses);
+    connect(m_webClient, &WebClient::recurringExpensesReceived, this, &LogicController::addExpenses);
+    connect(m_webClient, &WebClient::allNormalExpensesReceived, this, [this] {
         m_normalExpensesArrived = true;
+        finishExpenses();
     });
-    connect(m_webClient, &WebClient::normalExpensesReceived, this, &LogicController::addExpenses);
-
-    connect(m_webClient, &WebClient::recurringExpensesReceived, this, [this] {
+    connect(m_webClient, &WebClient::allRecurringExpensesReceived, this, [this] {
         m_recurrentExpensesArrived = true;
+        finishExpenses();
     });
-    connect(m_webClient, &WebClient::recurringExpensesReceived, this, &LogicController::addExpenses);
 
-    connect(m_webClient, &WebClient::normalBillsReceived, this, [this] {
+    connect(m_webClient, &WebClient::normalBillsReceived, this, &LogicController::addBills);
+    connect(m_webClient, &WebClient::recurringBillsReceived, this, &LogicController::addBills);
+    connect(m_webClient, &WebClient::allNormalBillsReceived, this, [this] {
         m_normalBillsArrived = true;
+        finishBills();
     });
-    connect(m_webClient, &WebClient::normalBillsReceived, this, &LogicController::addBills);
-
-    connect(m_webClient, &WebClient::recurringBillsReceived, this, [&] {
+    connect(m_webClient, &WebClient::allRecurringBillsReceived, this, [this] {
         m_recurrentBillsArrived = true;
+        finishBills();
+    });
+
+    connect(m_webClient, &WebClient::allDataReceived, this, &LogicController::onAllDataReceived);
+    connect(m_webClient, &WebClient::fetchFailed, this, [this](const QString &endpointName) {
+        m_failedEndpoints << endpointName;
     });
-    connect(m_webClient, &WebClient::recurringBillsReceived, this, &LogicController::addBills);
 
     connect(m_webClient, &WebClient::accessTokenRefreshed, m_settings, &Settings::setAccessToken);
     connect(m_webClient, &WebClient::accessAndRefreshTokensRefreshed, this, &LogicController::updateAccessAndRefreshTokens);
@@ -64,6 +226,7 @@ void LogicController::makeCurrenciesRequest()
 
 void LogicController::requestAllData()
 {
+    m_failedEndpoints.clear();
     // web client requests to call
     m_webClient->getInvoicesRequest(m_settings->accessToken());
     m_webClient->getBillsRequest(m_settings->accessToken());
@@ -102,48 +265,73 @@ QList<Invoice> LogicController::invoices() const
     return m_invoices;
 }
 
-QList<Invoice> LogicController::rangedInvoices() const
+DocumentRange<Invoice> LogicController::rangedInvoices() const
 {
-    // list of invoices in the range provided by the user.
-    QList<Invoice> list;
-    for (auto &invoice : m_invoices) {
-        QDate date = invoice.dueDate().isValid() ? invoice.dueDate() : invoice.date();
-        if (m_fromDate <= date && date <= m_toDate) {
-            list.append(invoice);
-        }
-    }
-    return list;
+    return m_rangedInvoices;
 }
 
-void LogicController::setInvoices(QList<Invoice> &invoices)
+void LogicController::addInvoices(QList<Invoice> &invoices)
 {
-    for (auto &invoice : invoices) {
-        if (m_exchangeRates.contains(invoice.currencyCode())) { // not Zlote.
-            invoice.setPlnTotal(m_exchangeRates[invoice.currencyCode()] * invoice.total());
-        } else {
-            invoice.setPlnTotal(invoice.total()); // Zlote.
-        }
-    }
-
-    m_invoices = invoices;
-
-    // sorting according to the due date.
-    std::sort(m_invoices.begin(), m_invoices.end(), [](const Invoice& i1, const Invoice& i2){
-        return i1.dueDate() < i2.dueDate();
-    });
+    m_invoicesQueue.pending << invoices;
+}
 
-    // bellow is calculation of the first and of the last date of records. (not the bounds of a chart)
-    QDate firstDateToMeasure = invoices.first().dueDate().isValid() ? invoices.first().dueDate() : invoices.first().date();
-    if (firstDateToMeasure < m_firstDate) {
-        m_firstDate = firstDateToMeasure;
-    }
+void LogicController::finishInvoices()
+{
+    processInvoices();
+}
 
-    QDate lastDateToMeasure = invoices.last().dueDate().isValid() ? invoices.last().dueDate() : invoices.last().date();
-    if (lastDateToMeasure > m_lastDate) {
-        m_lastDate = lastDateToMeasure;
+void LogicController::processInvoices()
+{
+    if (m_invoicesQueue.running) {
+        m_invoicesQueue.rerun = true;
+        return;
     }
+    m_invoicesQueue.running = true;
+    m_invoicesQueue.rerun = false;
+
+    const quint64 generation = m_containersGeneration;
+    const QList<Invoice> stored = m_invoices;
+    const QHash<QString, int> index = m_invoicesIndex;
+    const QList<Invoice> received = m_invoicesQueue.pending;
+    const QMap<QString, double> exchangeRates = m_exchangeRates;
+    m_invoicesQueue.pending.clear();
+
+    auto *watcher = new QFutureWatcher<ProcessedDocuments<Invoice>>(this);
+    connect(watcher, &QFutureWatcher<ProcessedDocuments<Invoice>>::finished, this, [=]() {
+        m_invoicesQueue.running = false;
+        if (generation == m_containersGeneration) {
+            const ProcessedDocuments<Invoice> &processed = watcher->result();
+            m_invoices = processed.documents;
+            m_invoicesIndex = processed.index;
+            m_transactions.setInvoices(processed.columns);
+            updateRanges();
+
+            // bellow is calculation of the first and of the last date of records. (not the bounds of a chart)
+            if (!m_invoices.isEmpty()) {
+                QDate firstDateToMeasure = m_invoices.first().dueDate().isValid() ? m_invoices.first().dueDate() : m_invoices.first().date();
+                if (firstDateToMeasure < m_firstDate) {
+                    m_firstDate = firstDateToMeasure;
+                }
+
+                QDate lastDateToMeasure = m_invoices.last().dueDate().isValid() ? m_invoices.last().dueDate() : m_invoices.last().date();
+                if (lastDateToMeasure > m_lastDate) {
+                    m_lastDate = lastDateToMeasure;
+                }
+            }
+
+            emit invoicesReady();
+        }
+        watcher->deleteLater();
 
-    emit invoicesReady();
+        if (m_invoicesQueue.rerun) {
+            processInvoices();
+        }
+        checkAllDataReady();
+    });
+    watcher->setFuture(QtConcurrent::run([=]() {
+        return processDocuments(stored, index, received, exchangeRates, &invoiceKey,
+                                &TransactionColumns::invoiceSortDate, &TransactionColumns::fromInvoices);
+    }));
 }
 
 QList<Expense> LogicController::expenses() const
@@ -151,17 +339,9 @@ QList<Expense> LogicController::expenses() const
     return m_expenses;
 }
 
-QList<Expense> LogicController::rangedExpenses() const
+DocumentRange<Expense> LogicController::rangedExpenses() const
 {
-    // list of expenses in the range provided by the user.
-    QList<Expense> list;
-    for (auto &expense : m_expenses) {
-        QDate date = expense.nextExpenseDate().isValid() ? expense.nextExpenseDate() : expense.date();
-        if (m_fromDate <= date && date <= m_toDate) {
-            list.append(expense);
-        }
-    }
-    return list;
+    return m_rangedExpenses;
 }
 
 QList<ForecastingModel::Forecast> &LogicController::forecasts()
@@ -172,45 +352,81 @@ QList<ForecastingModel::Forecast> &LogicController::forecasts()
 void LogicController::setExpenses(const QList<Expense> &expenses)
 {
     m_expenses = expenses;
+    std::sort(m_expenses.begin(), m_expenses.end(), [](const Expense &e1, const Expense &e2) {
+        return TransactionColumns::expenseSortDate(e1) < TransactionColumns::expenseSortDate(e2);
+    });
+    m_transactions.setExpenses(TransactionColumns::fromExpenses(m_expenses));
+    updateRanges();
+    rebuildIndex(m_expenses, m_expensesIndex, &expenseKey);
     emit expensesReady();
 }
 
 void LogicController::addExpenses(QList<Expense> &expenses)
 {
-    for (auto &expense : expenses) {
-        if (m_exchangeRates.contains(expense.currencyCode())) {
-            expense.setPlnTotal(m_exchangeRates[expense.currencyCode()] * expense.total());
-        } else {
-            expense.setPlnTotal(expense.total());
-        }
-    }
-
-    m_expenses.append(expenses);
+    m_expensesQueue.pending << expenses;
+}
 
+void LogicController::finishExpenses()
+{
     if (m_normalExpensesArrived && m_recurrentExpensesArrived) {
         m_normalExpensesArrived = false;
         m_recurrentExpensesArrived = false;
+        processExpenses();
+    }
+}
 
-        std::sort(m_expenses.begin(), m_expenses.end(), [](const Expense& e1, const Expense& e2){
-            QDate d1 = e1.nextExpenseDate().isValid() ? e1.nextExpenseDate() : e1.date();
-            QDate d2 = e2.nextExpenseDate().isValid() ? e2.nextExpenseDate() : e2.date();
-            return d1 < d2;
-        });
-
-        // bellow is calculation of the first and of the last date of records. (not the bounds of a chart)
-
-        QDate firstDateToMeasure = m_expenses.first().nextExpenseDate().isValid() ? m_expenses.first().nextExpenseDate() : m_expenses.first().date();
-
-        if (firstDateToMeasure < m_firstDate) {
-            m_firstDate = firstDateToMeasure;
+void LogicController::processExpenses()
+{
+    if (m_expensesQueue.running) {
+        m_expensesQueue.rerun = true;
+        return;
+    }
+    m_expensesQueue.running = true;
+    m_expensesQueue.rerun = false;
+
+    const quint64 generation = m_containersGeneration;
+    const QList<Expense> stored = m_expenses;
+    const QHash<QString, int> index = m_expensesIndex;
+    const QList<Expense> received = m_expensesQueue.pending;
+    const QMap<QString, double> exchangeRates = m_exchangeRates;
+    m_expensesQueue.pending.clear();
+
+    auto *watcher = new QFutureWatcher<ProcessedDocuments<Expense>>(this);
+    connect(watcher, &QFutureWatcher<ProcessedDocuments<Expense>>::finished, this, [=]() {
+        m_expensesQueue.running = false;
+        if (generation == m_containersGeneration) {
+            const ProcessedDocuments<Expense> &processed = watcher->result();
+            m_expenses = processed.documents;
+            m_expensesIndex = processed.index;
+            m_transactions.setExpenses(processed.columns);
+            updateRanges();
+
+            // bellow is calculation of the first and of the last date of records. (not the bounds of a chart)
+            if (!m_expenses.isEmpty()) {
+                QDate firstDateToMeasure = m_expenses.first().nextExpenseDate().isValid() ? m_expenses.first().nextExpenseDate() : m_expenses.first().date();
+
+                if (firstDateToMeasure < m_firstDate) {
+                    m_firstDate = firstDateToMeasure;
+                }
+                QDate lastDateToMeasure = m_expenses.last().nextExpenseDate().isValid() ? m_expenses.last().nextExpenseDate() : m_expenses.last().date();
+
+                if (lastDateToMeasure > m_lastDate) {
+                    m_lastDate = lastDateToMeasure;
+                }
+            }
+            emit expensesReady();
         }
-        QDate lastDateToMeasure = m_expenses.last().nextExpenseDate().isValid() ? m_expenses.last().nextExpenseDate() : m_expenses.last().date();
+        watcher->deleteLater();
 
-        if (lastDateToMeasure > m_lastDate) {
-            m_lastDate = lastDateToMeasure;
+        if (m_expensesQueue.rerun) {
+            processExpenses();
         }
-        emit expensesReady();
-    }
+        checkAllDataReady();
+    });
+    watcher->setFuture(QtConcurrent::run([=]() {
+        return processDocuments(stored, index, received, exchangeRates, &expenseKey,
+                                &TransactionColumns::expenseSortDate, &TransactionColumns::fromExpenses);
+    }));
 }
 
 QList<Bill> LogicController::bills() const
@@ -218,22 +434,74 @@ QList<Bill> LogicController::bills() const
     return m_bills;
 }
 
-QList<Bill> LogicController::rangedBills() const
+DocumentRange<Bill> LogicController::rangedBills() const
 {
-    // list of bills in the range provided by the user.
-    QList<Bill> list;
-    for (auto &bill : m_bills) {
-        QDate date = bill.nextBillDate().isValid() ? bill.nextBillDate() : bill.dueDate().isValid() ? bill.dueDate() : bill.date();
-        if (m_fromDate <= date && date <= m_toDate) {
-            list.append(bill);
-        }
-    }
-    return list;
+    return m_rangedBills;
+}
+
+const TransactionStore &LogicController::transactions() const
+{
+    return m_transactions;
+}
+
+void LogicController::updateRanges()
+{
+    // lists are kept sorted, so documents in the range provided by the user are found with binary search.
+    m_rangedInvoices = findRange(m_invoices, m_transactions.invoices(), m_fromDate, m_toDate);
+    m_rangedExpenses = findRange(m_expenses, m_transactions.expenses(), m_fromDate, m_toDate);
+    m_rangedBills = findRange(m_bills, m_transactions.bills(), m_fromDate, m_toDate);
 }
 
 void LogicController::clearExchangeRates()
 {
     m_exchangeRates.clear();
+    m_receivedRates.clear();
+}
+
+bool LogicController::loadSnapshot()
+{
+    SnapshotStore::Snapshot snapshot;
+    if (!m_snapshotStore->load(snapshot)) {
+        return false;
+    }
+
+    // processing started before is based on containers replaced below, so its results are dropped.
+    ++m_containersGeneration;
+    m_invoices = snapshot.invoices;
+    m_expenses = snapshot.expenses;
+    m_bills = snapshot.bills;
+    m_transactions.setInvoices(TransactionColumns::fromInvoices(m_invoices));
+    m_transactions.setExpenses(TransactionColumns::fromExpenses(m_expenses));
+    m_transactions.setBills(TransactionColumns::fromBills(m_bills));
+    updateRanges();
+    // rates received during this session are more recent than the stored ones.
+    for (auto it = snapshot.exchangeRates.constBegin(); it != snapshot.exchangeRates.constEnd(); ++it) {
+        if (!m_receivedRates.contains(it.key())) {
+            m_exchangeRates.insert(it.key(), it.value());
+        }
+    }
+    m_webClient->setSyncWatermarks(snapshot.syncWatermarks);
+
+    // the same steps as after receiving all pages are performed, stored documents only need to be indexed.
+    finishInvoices();
+    m_normalExpensesArrived = true;
+    m_recurrentExpensesArrived = true;
+    finishExpenses();
+    m_normalBillsArrived = true;
+    m_recurrentBillsArrived = true;
+    finishBills();
+    return true;
+}
+
+void LogicController::saveSnapshot() const
+{
+    SnapshotStore::Snapshot snapshot;
+    snapshot.invoices = m_invoices;
+    snapshot.expenses = m_expenses;
+    snapshot.bills = m_bills;
+    snapshot.exchangeRates = m_exchangeRates;
+    snapshot.syncWatermarks = m_webClient->syncWatermarks();
+    m_snapshotStore->save(snapshot);
 }
 
 QMap<QString, double> LogicController::exchangeRates() const
@@ -249,42 +517,116 @@ bool LogicController::isForecastingEnabled() const
 void LogicController::setBills(const QList<Bill> &bills)
 {
     m_bills = bills;
+    std::sort(m_bills.begin(), m_bills.end(), [](const Bill &b1, const Bill &b2) {
+        return TransactionColumns::billSortDate(b1) < TransactionColumns::billSortDate(b2);
+    });
+    m_transactions.setBills(TransactionColumns::fromBills(m_bills));
+    updateRanges();
+    rebuildIndex(m_bills, m_billsIndex, &billKey);
     emit billsReady();
 }
 
 void LogicController::addBills(QList<Bill> &bills)
 {
-    for (auto &bill : bills) {
-        if (m_exchangeRates.contains(bill.currencyCode())) {
-            bill.setPlnTotal(m_exchangeRates[bill.currencyCode()] * bill.total());
-        } else {
-            bill.setPlnTotal(bill.total());
-        }
-    }
-
-    m_bills.append(bills);
+    m_billsQueue.pending << bills;
+}
 
+void LogicController::finishBills()
+{
     if (m_normalBillsArrived && m_recurrentBillsArrived) {
         m_normalBillsArrived = false;
         m_recurrentBillsArrived = false;
-        std::sort(m_bills.begin(), m_bills.end(), [](const Bill& b1, const Bill& b2){
-            QDate d1 = b1.nextBillDate().isValid() ? b1.nextBillDate() : b1.date();
-            QDate d2 = b2.nextBillDate().isValid() ? b2.nextBillDate() : b2.date();
-            return d1 < d2;
-        });
-
-        // bellow is calculation of the first and of the last date of records. (not the bounds of a chart)
-        QDate firstDateToMeasure = m_bills.first().dueDate().isValid() ? m_bills.first().dueDate() : m_bills.first().date();
-        if (m_firstDate < firstDateToMeasure) {
-            m_firstDate = firstDateToMeasure;
+        processBills();
+    }
+}
+
+void LogicController::processBills()
+{
+    if (m_billsQueue.running) {
+        m_billsQueue.rerun = true;
+        return;
+    }
+    m_billsQueue.running = true;
+    m_billsQueue.rerun = false;
+
+    const quint64 generation = m_containersGeneration;
+    const QList<Bill> stored = m_bills;
+    const QHash<QString, int> index = m_billsIndex;
+    const QList<Bill> received = m_billsQueue.pending;
+    const QMap<QString, double> exchangeRates = m_exchangeRates;
+    m_billsQueue.pending.clear();
+
+    auto *watcher = new QFutureWatcher<ProcessedDocuments<Bill>>(this);
+    connect(watcher, &QFutureWatcher<ProcessedDocuments<Bill>>::finished, this, [=]() {
+        m_billsQueue.running = false;
+        if (generation == m_containersGeneration) {
+            const ProcessedDocuments<Bill> &processed = watcher->result();
+            m_bills = processed.documents;
+            m_billsIndex = processed.index;
+            m_transactions.setBills(processed.columns);
+            updateRanges();
+
+            // bellow is calculation of the first and of the last date of records. (not the bounds of a chart)
+            if (!m_bills.isEmpty()) {
+                QDate firstDateToMeasure = m_bills.first().dueDate().isValid() ? m_bills.first().dueDate() : m_bills.first().date();
+                if (m_firstDate < firstDateToMeasure) {
+                    m_firstDate = firstDateToMeasure;
+                }
+
+                QDate lastDateToMeasure = m_bills.last().dueDate().isValid() ? m_bills.last().dueDate() : m_bills.last().date();
+                if (lastDateToMeasure > m_lastDate) {
+                    m_lastDate = lastDateToMeasure;
+                }
+            }
+
+            emit billsReady();
         }
+        watcher->deleteLater();
 
-        QDate lastDateToMeasure = m_bills.last().dueDate().isValid() ? m_bills.last().dueDate() : m_bills.last().date();
-        if (lastDateToMeasure > m_lastDate) {
-            m_lastDate = lastDateToMeasure;
+        if (m_billsQueue.rerun) {
+            processBills();
         }
+        checkAllDataReady();
+    });
+    watcher->setFuture(QtConcurrent::run([=]() {
+        return processDocuments(stored, index, received, exchangeRates, &billKey,
+                                &TransactionColumns::billSortDate, &TransactionColumns::fromBills);
+    }));
+}
 
-        emit billsReady();
+void LogicController::onAllDataReceived()
+{
+    m_allDataReceived = true;
+    checkAllDataReady();
+}
+
+void LogicController::checkAllDataReady()
+{
+    // all the endpoints have finished, but their documents might still be processed.
+    const bool processing = m_invoicesQueue.running || m_expensesQueue.running || m_billsQueue.running;
+    if (!m_allDataReceived || processing) {
+        return;
+    }
+    m_allDataReceived = false;
+    // documents replaced by their updated versions might have been the last ones with some names.
+    InternedString::releaseUnused();
+
+    emit allDataReady();
+    if (CompactSymbol::hasOverflowed()) {
+        m_failedEndpoints.clear();
+        emit importFailed(IMPORT_OVERFLOW_ERROR);
+        return;
+    }
+    if (!m_failedEndpoints.isEmpty()) {
+        // incomplete documents are not saved. Watermarks of failed endpoints haven't moved, so they're downloaded again.
+        const QStringList failedEndpoints = m_failedEndpoints;
+        m_failedEndpoints.clear();
+        emit synchronizationFailed(failedEndpoints);
+        return;
+    }
+    // demo data is read from local files, so it's not worth saving.
+    if (!isDemoMode() && m_snapshotSavingEnabled) {
+        saveSnapshot();
     }
 }
 
@@ -292,7 +634,8 @@ void LogicController::addRate(const QString &currency_code, const double &rate)
 {
     // theoretically number of exchange rates supported by Zoho might change in future. This macro can be changed.
     m_exchangeRates.insert(currency_code, rate);
-    if (m_exchangeRates.size() == NUMBER_OF_SUPPORTED_EXCHANGE_RATES) {
+    m_receivedRates.insert(currency_code);
+    if (m_receivedRates.size() == NUMBER_OF_SUPPORTED_EXCHANGE_RATES) {
         emit exchangeRateSReceived();
     }
 }
@@ -355,6 +698,7 @@ QDate LogicController::fromDate() const
 void LogicController::setFromDate(const QDate& fromDate)
 {
     m_fromDate = fromDate;
+    updateRanges();
 }
 
 QDate LogicController::toDate() const
@@ -365,6 +709,7 @@ QDate LogicController::toDate() const
 void LogicController::setToDate(const QDate& toDate)
 {
     m_toDate = toDate;
+    updateRanges();
 }
 
 bool LogicController::requestMade() const
@@ -384,96 +729,82 @@ void LogicController::readFiles()
     readRecurrentExpensesFile();
     readNormalBillsFile();
     readRecurrentBillsFile();
+    emit m_webClient->allDataReceived();
+}
+
+QString LogicController::dataDirectory() const
+{
+    return m_dataDirectory;
+}
+
+void LogicController::setDataDirectory(const QString &directory)
+{
+    m_dataDirectory = directory.isEmpty() ? DEMO_DATA_DIRECTORY : directory;
+}
+
+int LogicController::importThreadCount() const
+{
+    return m_importThreadCount;
+}
+
+void LogicController::setImportThreadCount(int value)
+{
+    m_importThreadCount = qMax(1, value);
+}
+
+void LogicController::setSnapshotSavingEnabled(bool value)
+{
+    m_snapshotSavingEnabled = value;
 }
 
 void LogicController::readInvoicesFile() const
 {
-    QFile file(":/assets/invoices.csv");
-    if (file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        QTextStream in(&file);
-        QString line = in.readLine(); // skipping first line
-        line = in.readLine();
-        QList<Invoice> invoices;
-        while (!line.isNull()) {
-            QList<QString> splittedLine = line.split(",");
-            invoices.append(Invoice::parseInvoice(splittedLine));
-            line = in.readLine();
-        }
-        file.close();
+    CsvReader reader(m_dataDirectory + "/invoices.csv");
+    if (reader.open()) {
+        QList<Invoice> invoices = parseCsvFile<Invoice>(reader, &Invoice::parseInvoice, m_importThreadCount);
         emit m_webClient->invoicesReceived(invoices);
     }
+    emit m_webClient->allInvoicesReceived();
 }
 
 void LogicController::readNormalExpensesFile() const
 {
-    QFile file(":/assets/normalExpenses.csv");
-    if (file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        QTextStream in(&file);
-        QString line = in.readLine(); // skipping first line
-        line = in.readLine();
-        QList<Expense> expenses;
-        while (!line.isNull()) {
-            QStringList splittedLine = line.split(",");
-            expenses.append(Expense::parseNormalExpense(splittedLine));
-            line = in.readLine();
-        }
-        file.close();
+    CsvReader reader(m_dataDirectory + "/normalExpenses.csv");
+    if (reader.open()) {
+        QList<Expense> expenses = parseCsvFile<Expense>(reader, &Expense::parseNormalExpense, m_importThreadCount);
         emit m_webClient->normalExpensesReceived(expenses);
     }
+    emit m_webClient->allNormalExpensesReceived();
 }
 
 void LogicController::readRecurrentExpensesFile() const
 {
-    QFile file(":/assets/recurrentExpenses.csv");
-    if (file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        QTextStream in(&file);
-        QString line = in.readLine(); // skipping first line
-        line = in.readLine();
-        QList<Expense> expenses;
-        while (!line.isNull()) {
-            QStringList splittedLine = line.split(",");
-            expenses.append(Expense::parseRecurrentExpense(splittedLine));
-            line = in.readLine();
-        }
-        file.close();
+    CsvReader reader(m_dataDirectory + "/recurrentExpenses.csv");
+    if (reader.open()) {
+        QList<Expense> expenses = parseCsvFile<Expense>(reader, &Expense::parseRecurrentExpense, m_importThreadCount);
         emit m_webClient->recurringExpensesReceived(expenses);
     }
+    emit m_webClient->allRecurringExpensesReceived();
 }
 
 void LogicController::readNormalBillsFile() const
 {
-    QFile file(":/assets/normalBills.csv");
-    if (file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        QTextStream in(&file);
-        QString line = in.readLine(); // skipping first line
-        line = in.readLine();
-        QList<Bill> bills;
-        while (!line.isNull()) {
-            QList<QString> splittedLine = line.split(",");
-            bills.append(Bill::parseNormalBill(splittedLine));
-            line = in.readLine();
-        }
-        file.close();
+    CsvReader reader(m_dataDirectory + "/normalBills.csv");
+    if (reader.open()) {
+        QList<Bill> bills = parseCsvFile<Bill>(reader, &Bill::parseNormalBill, m_importThreadCount);
         emit m_webClient->normalBillsReceived(bills);
     }
+    emit m_webClient->allNormalBillsReceived();
 }
 
 void LogicController::readRecurrentBillsFile() const
 {
-    QFile file(":/assets/recurrentBills.csv");
-    if (file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        QTextStream in(&file);
-        QString line = in.readLine(); // skipping first line
-        line = in.readLine();
-        QList<Bill> bills;
-        while (!line.isNull()) {
-            QList<QString> splittedLine = line.split(",");
-            bills.append(Bill::parseRecurringBill(splittedLine));
-            line = in.readLine();
-        }
-        file.close();
+    CsvReader reader(m_dataDirectory + "/recurrentBills.csv");
+    if (reader.open()) {
+        QList<Bill> bills = parseCsvFile<Bill>(reader, &Bill::parseRecurringBill, m_importThreadCount);
         emit m_webClient->recurringBillsReceived(bills);
     }
+    emit m_webClient->allRecurringBillsReceived();
 }
 
 void LogicController::clearContainers()
@@ -481,6 +812,20 @@ void LogicController::clearContainers()
     m_invoices.clear();
     m_expenses.clear();
     m_bills.clear();
+    m_transactions.clear();
+    m_invoicesIndex.clear();
+    m_expensesIndex.clear();
+    m_billsIndex.clear();
+    updateRanges();
+    m_invoicesQueue.pending.clear();
+    m_expensesQueue.pending.clear();
+    m_billsQueue.pending.clear();
+    m_allDataReceived = false;
+    ++m_containersGeneration;
+    // names of the removed documents are not kept for the rest of the run.
+    InternedString::releaseUnused();
+    // without stored documents there is nothing to update, next synchronization has to download everything.
+    m_webClient->resetSyncWatermarks();
 }
 
 bool LogicController::isDemoMode() const
@@ -6,10 +6,17 @@
 #define LOGICCONTROLLER_H
 
 #include "Settings.h"
+#include "SnapshotStore.h"
 #include "WebClient.h"
+#include "datasets/DocumentRange.h"
+#include "datasets/TransactionStore.h"
 #include "models/ForecastingModel.h"
 #include <QObject>
 #include <QApplication>
+#include <QHash>
+#include <QSet>
+
+#define DEMO_DATA_DIRECTORY ":/assets" // mock-data bundled with the application.
 
 /*!
  * \brief Class representing a logic controller responsible for all the manipulations between components of the application.
@@ -26,7 +33,8 @@ public:
     explicit LogicController(QObject *parent = nullptr);
 
     /*!
-     * \brief Makes a request to Zoho API to get all the data.
+     * \brief Makes a request to Zoho API to get all the data. After the first successful synchronization only
+     * documents modified since the previous one are requested and merged into stored ones by their ids.
      */
     void requestAllData();
 
@@ -52,9 +60,10 @@ public:
     QList<Invoice> invoices() const;
 
     /*!
-     * \brief Returns a list of invoices between set 'from date' and 'to date'.
+     * \brief Returns a view of invoices between set 'from date' and 'to date'. The range is found once per change of the dates
+     * or of the invoices, so calling this method is cheap. The view is invalidated by the next change.
      */
-    QList<Invoice> rangedInvoices() const;
+    DocumentRange<Invoice> rangedInvoices() const;
 
     /*!
      * \brief Returns a list of expenses.
@@ -62,9 +71,10 @@ public:
     QList<Expense> expenses() const;
 
     /*!
-     * \brief Returns a list of expenses between set 'from date' and 'to date'.
+     * \brief Returns a view of expenses between set 'from date' and 'to date'. The range is found once per change of the dates
+     * or of the expenses, so calling this method is cheap. The view is invalidated by the next change.
      */
-    QList<Expense> rangedExpenses() const;
+    DocumentRange<Expense> rangedExpenses() const;
 
     /*!
      * \brief Returns a list of bills.
@@ -72,9 +82,16 @@ public:
     QList<Bill> bills() const;
 
     /*!
-     * \brief Returns a list of bills between set 'from date' and 'to date'.
+     * \brief Returns a view of bills between set 'from date' and 'to date'. The range is found once per change of the dates
+     * or of the bills, so calling this method is cheap. The view is invalidated by the next change.
+     */
+    DocumentRange<Bill> rangedBills() const;
+
+    /*!
+     * \brief Returns amounts and dates of invoices, expenses and bills stored column by column, in the order of the lists.
+     * Ranged documents occupy the same positions of the columns. The columns are invalidated by the next change of the documents.
      */
-    QList<Bill> rangedBills() const;
+    const TransactionStore &transactions() const;
 
     /*!
      * \brief Returns a list of forecasts.
@@ -113,6 +130,34 @@ public:
      */
     void readFiles();
 
+    /*!
+     * \brief Returns directory the files with documents are read from. Mock-data bundled with the application by default.
+     */
+    QString dataDirectory() const;
+
+    /*!
+     * \brief Sets directory the files with documents are read from. Empty value restores mock-data bundled with the application.
+     * \param const QString &directory -- directory containing invoices.csv, normalExpenses.csv, recurrentExpenses.csv, normalBills.csv and recurrentBills.csv.
+     */
+    void setDataDirectory(const QString &directory);
+
+    /*!
+     * \brief Returns maximal number of threads a single file is parsed on.
+     */
+    int importThreadCount() const;
+
+    /*!
+     * \brief Sets maximal number of threads a single file is parsed on. All the cores are used by default.
+     * \param int value -- value to set. Values lower than 1 are treated as 1.
+     */
+    void setImportThreadCount(int value);
+
+    /*!
+     * \brief Sets if documents are saved to the snapshot after all the data is ready.
+     * \param bool value -- value to set.
+     */
+    void setSnapshotSavingEnabled(bool value);
+
     /*!
      * \brief Reads invoices data data file.
      */
@@ -139,7 +184,7 @@ public:
     void readRecurrentBillsFile() const;
 
     /*!
-     * \brief Clears lists of invoices, expenses and bills.
+     * \brief Clears lists of invoices, expenses and bills. Next request to Zoho API downloads all the data again.
      */
     void clearContainers();
 
@@ -219,6 +264,17 @@ public:
      */
     void clearExchangeRates();
 
+    /*!
+     * \brief Restores invoices, expenses, bills and exchange rates saved after the last synchronization.
+     * Emits the same signals as if the data has just been received. Returns false if there's no usable snapshot.
+     */
+    bool loadSnapshot();
+
+    /*!
+     * \brief Saves invoices, expenses, bills and exchange rates, so they are available right after the next start.
+     */
+    void saveSnapshot() const;
+
 signals:
 
     /*!
@@ -252,35 +308,94 @@ signals:
      */
     void modeChanged();
 
+    /*!
+     * \brief This signal is emitted when all pages of invoices, expenses and bills have been received and processed.
+     */
+    void allDataReady();
+
+    /*!
+     * \brief This signal is emitted after allDataReady() if some documents couldn't be downloaded.
+     * Documents that have been downloaded are displayed, but they are not saved and the next update downloads the rest.
+     * \param const QStringList &endpointNames -- names of the endpoints with missing documents, i.e. 'invoices'.
+     */
+    void synchronizationFailed(const QStringList &endpointNames);
+
+    /*!
+     * \brief This signal is emitted after allDataReady() if documents have more distinct statuses, currencies or frequencies
+     * than can be stored, i.e. because of a misaligned column of an imported file. Such documents are not saved.
+     * \param const QString &errorString -- description of the error.
+     */
+    void importFailed(const QString &errorString);
+
 private slots:
-    void setInvoices(QList<Invoice> &invoices);
+    void addInvoices(QList<Invoice> &invoices);
+    void finishInvoices();
     void setExpenses(const QList<Expense> &expenses);
     void addExpenses(QList<Expense> &expenses);
+    void finishExpenses();
     void addRate(const QString &currency_code, const double &rate);
     void setBills(const QList<Bill> &bills);
     void addBills(QList<Bill> &bills);
+    void finishBills();
     void updateAccessAndRefreshTokens(const QString &accessToken, const QString &refreshToken);
+    void onAllDataReceived();
+
+private:
+    // received documents wait here until their endpoints finish, then they are processed on a worker thread.
+    template <typename T>
+    struct ProcessingQueue {
+        QList<T> pending;
+        bool running = false;
+        bool rerun = false; // documents have been finished while processing was running.
+    };
+
+    void processInvoices();
+    void processExpenses();
+    void processBills();
+    void checkAllDataReady();
+    void updateRanges();
 
 private:
     friend class InvoicesModel;
     friend class BillsModel;
     friend class ExpensesModel;
     friend class ForecastingModel;
+    friend class PipelineBenchmark; // feeds documents to processing without the network.
 
     Settings* m_settings = nullptr;
     WebClient* m_webClient = nullptr;
+    SnapshotStore* m_snapshotStore = nullptr;
 
     QList<Invoice> m_invoices = {};
     QList<Expense> m_expenses = {};
     QList<Bill> m_bills = {};
+    TransactionStore m_transactions; // kept in sync with the lists above.
     QList<ForecastingModel::Forecast> m_forecasts = {};
 
+    // positions of stored documents by their ids, used for merging synchronized changes.
+    QHash<QString, int> m_invoicesIndex;
+    QHash<QString, int> m_expensesIndex;
+    QHash<QString, int> m_billsIndex;
+
+    // documents between 'from date' and 'to date'.
+    DocumentRange<Invoice> m_rangedInvoices;
+    DocumentRange<Expense> m_rangedExpenses;
+    DocumentRange<Bill> m_rangedBills;
+
+    ProcessingQueue<Invoice> m_invoicesQueue;
+    ProcessingQueue<Expense> m_expensesQueue;
+    ProcessingQueue<Bill> m_billsQueue;
+    quint64 m_containersGeneration = 0; // results of processing started before clearing containers are dropped.
+    bool m_allDataReceived = false;
+    QStringList m_failedEndpoints; // endpoints which couldn't be fully downloaded during the current synchronization.
+
     bool m_normalExpensesArrived = false;
     bool m_recurrentExpensesArrived = false;
     bool m_normalBillsArrived = false;
     bool m_recurrentBillsArrived = false;
 
     QMap<QString, double> m_exchangeRates;
+    QSet<QString> m_receivedRates; // rates received during this session, restored ones are not counted.
 
     bool m_forecastingEnabled = true;
     QDate m_firstDate;
@@ -290,6 +405,10 @@ private:
     QDate m_toDate;
 
     bool m_requestMade = false; //need for adding forecasts before update button clicked
+
+    QString m_dataDirectory = DEMO_DATA_DIRECTORY;
+    int m_importThreadCount;
+    bool m_snapshotSavingEnabled = true;
 };
 
 #endif // LOGICCONTROLLER_H
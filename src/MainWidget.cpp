@@ -16,6 +16,15 @@
 #include "widgets/ExpensesListWidget.h"
 #include "widgets/ForecastingWidget.h"
 #include <QStyle>
+#include <QEvent>
+
+// Amount shown in the total labels, rounded to grosze.
+static QString plnAmountText(double sum)
+{
+    QString stringSum = std::to_string(std::round(sum * 100.0) / 100.0).c_str();
+    stringSum.truncate(stringSum.lastIndexOf('.') + 3);
+    return stringSum + QString(" PLN");
+}
 
 MainWidget::MainWidget(LogicController *logicController, QWidget *parent)
     : QWidget(parent)
@@ -33,6 +42,8 @@ MainWidget::MainWidget(LogicController *logicController, QWidget *parent)
 
     ui->errorLabel->setVisible(false);
     ui->datesErrorLabel->setVisible(false);
+    ui->synchronizationErrorLabel->setVisible(false);
+    ui->importErrorLabel->setVisible(false);
     ui->updateButton->setEnabled(false);
 
     ui->expensesCheckBox->setCheckable(false);
@@ -49,20 +60,18 @@ MainWidget::MainWidget(LogicController *logicController, QWidget *parent)
     connect(m_logicController, &LogicController::errorLabelVisibilityRequested,
             this, &MainWidget::onErrorLabelVisibilityRequested);
 
+    connect(m_logicController, &LogicController::synchronizationFailed, this, [&] {
+        ui->synchronizationErrorLabel->setVisible(true);
+    });
+    connect(m_logicController, &LogicController::importFailed, this, [&](const QString &errorString) {
+        ui->importErrorLabel->setText(errorString);
+        ui->importErrorLabel->setVisible(true);
+    });
+
     connect(m_logicController, &LogicController::invoicesReady, m_invoicesModel, &InvoicesModel::loadData);
     connect(m_logicController, &LogicController::billsReady, m_billsModel, &BillsModel::loadData);
     connect(m_logicController, &LogicController::expensesReady, m_expensesModel, &ExpensesModel::loadData);
 
-    connect(m_logicController, &LogicController::invoicesReady, this, [&] {
-        updateInvoicesTotalLabel("");
-    });
-    connect(m_logicController, &LogicController::expensesReady, this, [&] {
-        updateExpensesTotalLabel("", false, false);
-    });
-    connect(m_logicController, &LogicController::billsReady, this, [&] {
-        updateBillsTotalLabel("", false, false);
-    });
-
     connect(m_logicController, &LogicController::invoicesReady, this, &MainWidget::updateIncomeSeries);
     connect(m_logicController, &LogicController::expensesReady, this, &MainWidget::expensesArrived);
     connect(m_logicController, &LogicController::billsReady, this, &MainWidget::billsArrived);
@@ -76,6 +85,13 @@ MainWidget::MainWidget(LogicController *logicController, QWidget *parent)
     connect(ui->cashFlowPointsCheckBox, &QCheckBox::stateChanged, m_chart, &CashFlowChart::setCashFlowPointsVisible);
 
     connect(m_forecastingModel, &ForecastingModel::modelChanged, this, &MainWidget::updateChart);
+    connect(m_forecastingModel, &ForecastingModel::forecastChanged, this,
+            [&](const ForecastingModel::Forecast &previous, const ForecastingModel::Forecast &current) {
+        // a single forecast only touches its own points, series are prepared from scratch only if they are not built yet.
+        if (m_logicController->requestMade() && !m_chart->updateForecast(previous, current)) {
+            updateChart();
+        }
+    });
 
     connect(m_chart, &CashFlowChart::axesPrepared, this, [&](){
        ui->updateButton->setEnabled(true);
@@ -84,6 +100,12 @@ MainWidget::MainWidget(LogicController *logicController, QWidget *parent)
     connect(m_logicController, &LogicController::exchangeRateSReceived, this, [&](){
        ui->updateButton->setEnabled(true);
        ui->ratesWaitingLabel->setVisible(false);
+       // data restored from the snapshot is reconciled with Zoho as soon as the connection is confirmed.
+       if (!m_logicController->isDemoMode() && m_logicController->requestMade()) {
+           ui->updateButton->setEnabled(false);
+           m_chart->resetYAxeRanges();
+           m_logicController->requestAllData();
+       }
     });
 
     connect(m_logicController, &LogicController::modeChanged, this, &MainWidget::onModeChanged);
@@ -113,6 +135,17 @@ LogicController *MainWidget::logicController()
     return m_logicController;
 }
 
+void MainWidget::changeEvent(QEvent *event)
+{
+    QWidget::changeEvent(event);
+    if (event->type() == QEvent::LocaleChange) {
+        // texts of the tables are cached with the locale they've been formatted with.
+        m_invoicesModel->loadData();
+        m_billsModel->loadData();
+        m_expensesModel->loadData();
+    }
+}
+
 void MainWidget::onUpdateButtonClicked()
 {
     ui->datesErrorLabel->setVisible(false);
@@ -120,10 +153,28 @@ void MainWidget::onUpdateButtonClicked()
         ui->datesErrorLabel->setVisible(true);
         return;
     }
+    prepareForUpdate();
+    if (m_logicController->isDemoMode()) {
+        // read files with mock-data.
+        m_logicController->clearContainers();
+        m_logicController->readFiles();
+    } else {
+        // make request for the data changed since the previous update. Stored documents are kept and updated.
+        m_logicController->requestAllData();
+    }
+    // REQUEST MADE parameter is used for upcoming requests.
+    m_billsListWidget->resetCheckBoxesAndClearSearch();
+    m_expensesListWidget->resetCheckBoxesAndClearSearch();
+    m_invoicesListWidget->clearSearchLine();
+}
+
+void MainWidget::prepareForUpdate()
+{
     ui->updateButton->setEnabled(false);
+    ui->synchronizationErrorLabel->setVisible(false);
+    ui->importErrorLabel->setVisible(false);
     m_logicController->setFirstDate(ui->fromDateEdit->date());
     m_logicController->setLastDate(ui->toDateEdit->date());
-    m_logicController->clearContainers();
     m_logicController->setFromDate(ui->fromDateEdit->date());
     m_logicController->setToDate(ui->toDateEdit->date());
     ui->chartView->chart()->setVisible(true);
@@ -132,17 +183,16 @@ void MainWidget::onUpdateButtonClicked()
     m_chart->resetYAxeRanges();
     m_chart->setDates(ui->fromDateEdit->date(), ui->toDateEdit->date());
     m_logicController->setRequestMade(true);
-    if (m_logicController->isDemoMode()) {
-        // read files with mock-data.
-        m_logicController->readFiles();
-    } else {
-        // make request for the data.
-        m_logicController->requestAllData();
+}
+
+void MainWidget::restoreSnapshot()
+{
+    // data saved after the last synchronization is displayed right away, the network synchronization follows in the background.
+    prepareForUpdate();
+    if (!m_logicController->loadSnapshot()) {
+        m_logicController->setRequestMade(false);
+        ui->chartView->chart()->setVisible(false);
     }
-    // REQUEST MADE parameter is used for upcoming requests.
-    m_billsListWidget->resetCheckBoxesAndClearSearch();
-    m_expensesListWidget->resetCheckBoxesAndClearSearch();
-    m_invoicesListWidget->clearSearchLine();
 }
 
 void MainWidget::onGrantTokenButtonClicked()
@@ -178,106 +228,16 @@ void MainWidget::setupDisplayWidgets()
     m_forecastingWidget = new ForecastingWidget(m_forecastingModel, this);
     ui->tabWidget->addTab(m_forecastingWidget, "Forecasting");
 
-    connect(m_billsListWidget, &BillsListWidget::filteringApplied, this, &MainWidget::updateBillsTotalLabel);
-    connect(m_invoicesListWidget, &InvoicesListWidget::filteringApplied, this, &MainWidget::updateInvoicesTotalLabel);
-    connect(m_expensesListWidget, &ExpensesListWidget::filteringApplied, this, &MainWidget::updateExpensesTotalLabel);
-}
-
-void MainWidget::updateInvoicesTotalLabel(const QString &text)
-{
-    double sum = 0;
-    for (int i = 0; i < m_logicController->rangedInvoices().size(); ++i) {
-        if (!text.isEmpty()) {
-            if (m_logicController->rangedInvoices().at(i).invoiceNumber().toLower().contains(text.toLower()) ||
-                m_logicController->rangedInvoices().at(i).party().toLower().contains(text.toLower()) ||
-                m_logicController->rangedInvoices().at(i).status().toLower().contains(text.toLower()) ||
-                m_logicController->rangedInvoices().at(i).date().toString().contains(text.toLower()) ||
-                m_logicController->rangedInvoices().at(i).dueDate().toString().contains(text.toLower()) ||
-                m_logicController->rangedInvoices().at(i).currencyCode().contains(text.toLower()) ||
-                QString::number(m_logicController->rangedInvoices().at(i).plnTotal()).toLower().contains(text.toLower())){
-                    sum += m_logicController->rangedInvoices().at(i).plnTotal();
-            } else {
-                continue;
-            }
-        } else {
-            sum += m_logicController->rangedInvoices().at(i).plnTotal();
-        }
-    }
-    QString stringSum = std::to_string(std::round(sum * 100.0) / 100.0).c_str();
-    stringSum.truncate(stringSum.lastIndexOf('.') + 3);
-    m_invoicesListWidget->updatePLNAmountLabel(stringSum + QString(" PLN"));
-}
-
-void MainWidget::updateExpensesTotalLabel(const QString &text, bool hideNormal, bool hideRecurrent)
-{
-    double sum = 0;
-    for (int i = 0; i != m_logicController->rangedExpenses().size(); ++i) {
-        if (hideRecurrent && m_logicController->rangedExpenses().at(i).isRecurrent()) {
-            continue;
-        }
-
-        if (hideNormal && !m_logicController->rangedExpenses().at(i).isRecurrent()) {
-            continue;
-        }
-
-        if (!text.isEmpty()) {
-            if (m_logicController->rangedExpenses().at(i).expenseId().toLower().contains(text.toLower()) ||
-                m_logicController->rangedExpenses().at(i).status().toLower().contains(text.toLower()) ||
-                m_logicController->rangedExpenses().at(i).category().toLower().contains(text.toLower()) ||
-                m_logicController->rangedExpenses().at(i).partyName().toLower().contains(text.toLower()) ||
-                QVariant(m_logicController->rangedExpenses().at(i).isRecurrent()).toString().toLower().contains(text.toLower()) ||
-                m_logicController->rangedExpenses().at(i).recurrenceFrequency().toLower().contains(text.toLower()) ||
-                m_logicController->rangedExpenses().at(i).date().toString().toLower().contains(text.toLower()) ||
-                m_logicController->rangedExpenses().at(i).nextExpenseDate().toString().toLower().contains(text.toLower()) ||
-                m_logicController->rangedExpenses().at(i).currencyCode().toLower().contains(text.toLower()) ||
-                QString::number(m_logicController->rangedExpenses().at(i).plnTotal()).toLower().contains(text.toLower())) {
-                    sum += m_logicController->rangedExpenses().at(i).plnTotal();
-            } else {
-                continue;
-            }
-        } else {
-            sum += m_logicController->rangedExpenses().at(i).plnTotal();
-        }
-    }
-    QString stringSum = std::to_string(std::round(sum * 100.0) / 100.0).c_str();
-    stringSum.truncate(stringSum.lastIndexOf('.') + 3);
-    m_expensesListWidget->updatePLNAmountLabel(stringSum + QString(" PLN"));
-}
-
-void MainWidget::updateBillsTotalLabel(const QString &text, bool hideRecurrent, bool hideNormal)
-{
-    double sum = 0;
-    for (int i = 0; i != m_logicController->rangedBills().size(); ++i) {
-        if (hideRecurrent && m_logicController->rangedBills().at(i).isRecurrent()) {
-            continue;
-        }
-
-        if (hideNormal && !m_logicController->rangedBills().at(i).isRecurrent()) {
-            continue;
-        }
-
-        if (!text.isEmpty()) {
-            if (m_logicController->rangedBills().at(i).billNumber().toLower().contains(text.toLower()) ||
-                m_logicController->rangedBills().at(i).party().toLower().contains(text.toLower()) ||
-                QVariant(m_logicController->rangedBills().at(i).isRecurrent()).toString().toLower().contains(text.toLower()) ||
-                m_logicController->rangedBills().at(i).status().toLower().contains(text.toLower()) ||
-                m_logicController->rangedBills().at(i).recurrence_frequency().toLower().contains(text.toLower()) ||
-                m_logicController->rangedBills().at(i).date().toString().toLower().contains(text.toLower()) ||
-                m_logicController->rangedBills().at(i).dueDate().toString().toLower().contains(text.toLower()) ||
-                m_logicController->rangedBills().at(i).nextBillDate().toString().toLower().contains(text.toLower()) ||
-                m_logicController->rangedBills().at(i).currencyCode().toLower().contains(text.toLower()) ||
-                QString::number(m_logicController->rangedBills().at(i).plnTotal()).toLower().contains(text.toLower())) {
-                    sum += m_logicController->rangedBills().at(i).plnTotal();
-            } else {
-                continue;
-            }
-        } else {
-            sum += m_logicController->rangedBills().at(i).plnTotal();
-        }
-    }
-    QString stringSum = std::to_string(std::round(sum * 100.0) / 100.0).c_str();
-    stringSum.truncate(stringSum.lastIndexOf('.') + 3);
-    m_billsListWidget->updatePLNAmountLabel(stringSum + QString(" PLN"));
+    // totals are summed up by the tables while filtering their rows.
+    connect(m_billsListWidget, &BillsListWidget::filteredTotalChanged, this, [&](double total) {
+        m_billsListWidget->updatePLNAmountLabel(plnAmountText(total));
+    });
+    connect(m_invoicesListWidget, &InvoicesListWidget::filteredTotalChanged, this, [&](double total) {
+        m_invoicesListWidget->updatePLNAmountLabel(plnAmountText(total));
+    });
+    connect(m_expensesListWidget, &ExpensesListWidget::filteredTotalChanged, this, [&](double total) {
+        m_expensesListWidget->updatePLNAmountLabel(plnAmountText(total));
+    });
 }
 
 void MainWidget::updateIncomeSeries()
@@ -389,7 +349,6 @@ void MainWidget::onModeChanged()
         ui->fromDateEdit->setDate(QDate::currentDate().addMonths(-1));
         ui->toDateEdit->setDate(QDate(QDate::currentDate().year(), 12, 31));
         m_logicController->clearExchangeRates();
-        m_logicController->checkAccessToken();
     }
 
     // clearing models and tables.
@@ -397,4 +356,9 @@ void MainWidget::onModeChanged()
     m_invoicesModel->loadData();
     m_expensesModel->loadData();
     m_forecastingModel->loadData();
+
+    if (!m_logicController->isDemoMode()) {
+        restoreSnapshot();
+        m_logicController->checkAccessToken();
+    }
 }
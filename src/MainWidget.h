@@ -52,6 +52,14 @@ public:
      */
     LogicController *logicController();
 
+protected:
+
+    /*!
+     * \brief Reloads the tables when the locale changes, so amounts are formatted again.
+     * \param QEvent *event -- change event.
+     */
+    void changeEvent(QEvent *event) override;
+
 private slots:
     void onUpdateButtonClicked();
     void onGrantTokenButtonClicked();
@@ -67,10 +75,8 @@ private:
     void expensesArrived();
 
     void setupDisplayWidgets();
-
-    void updateInvoicesTotalLabel(const QString &text);
-    void updateExpensesTotalLabel(const QString &text, bool hideRecurrent, bool hideNormal);
-    void updateBillsTotalLabel(const QString &text, bool hideRecurrent, bool hideNormal);
+    void prepareForUpdate();
+    void restoreSnapshot();
 
     void updateIncomeSeries();
     void updateExpensesSeries();
@@ -7,6 +7,7 @@
 #include "LogicController.h"
 #include "ui_MainWindow.h"
 #include "widgets/AboutDialog.h"
+#include <QFileDialog>
 
 MainWindow::MainWindow(QWidget *parent) :
     QMainWindow(parent),
@@ -35,6 +36,12 @@ MainWindow::~MainWindow()
 
 void MainWindow::setupMenu()
 {
+    m_fileMenu = menuBar()->addMenu(tr("&File"));
+
+    m_importAction = new QAction(tr("&Import CSV files..."), this);
+    connect(m_importAction, &QAction::triggered, this, &MainWindow::onImportActionTriggered);
+    m_fileMenu->addAction(m_importAction);
+
     m_helpMenu = menuBar()->addMenu(tr("&Help"));
 
     m_aboutAction = new QAction(tr("&About"), this);
@@ -62,6 +69,21 @@ void MainWindow::onAboutActionTriggered()
     aboutDialog.exec();
 }
 
+void MainWindow::onImportActionTriggered()
+{
+    const QString &directory = QFileDialog::getExistingDirectory(this, tr("Directory with invoices.csv, normalExpenses.csv, "
+                                                                        "recurrentExpenses.csv, normalBills.csv and recurrentBills.csv"));
+    if (directory.isEmpty()) {
+        return;
+    }
+
+    // local files are read in the demo mode, so imported ones are shown after the next update.
+    m_logicController->setDataDirectory(directory);
+    if (!m_logicController->isDemoMode()) {
+        onEnableDemoModeActionTriggered();
+    }
+}
+
 void MainWindow::onEnableDemoModeActionTriggered()
 {
     m_logicController->setIsDemoMode(true);
@@ -73,6 +95,7 @@ void MainWindow::onEnableDemoModeActionTriggered()
 void MainWindow::onDisableDemoModeActionTriggered()
 {
     m_logicController->setIsDemoMode(false);
+    m_logicController->setDataDirectory(QString());
     m_helpMenu->removeAction(m_disableDemoModeAction);
     m_helpMenu->addAction(m_enableDemoModeAction);
     setWindowTitle("Zoho Books Forecasting");
@@ -43,6 +43,7 @@ private slots:
     void setupMenu();
 
     void onAboutActionTriggered();
+    void onImportActionTriggered();
     void onEnableDemoModeActionTriggered();
     void onDisableDemoModeActionTriggered();
 
@@ -51,7 +52,9 @@ private:
     MainWidget *m_mainWidget = nullptr;
     LogicController *m_logicController = nullptr;
 
+    QMenu *m_fileMenu = nullptr;
     QMenu *m_helpMenu = nullptr;
+    QAction *m_importAction = nullptr;
     QAction *m_aboutAction = nullptr;
     QAction *m_disableDemoModeAction = nullptr;
     QAction *m_enableDemoModeAction = nullptr;
@@ -3,6 +3,7 @@
 // </copyright>
 
 #include "Settings.h"
+#include "WebClient.h"
 #include <QApplication>
 #include <QDir>
 
@@ -10,6 +11,9 @@
 #define REFRESH_TOKEN "refreshToken"
 #define IS_DARK_MODE_ENABLED "isDarkModeEnabled"
 #define IS_DEMO_MODE "isDemoMode"
+#define MAX_CONCURRENT_REQUESTS "maxConcurrentRequests"
+#define API_ADDRESS "apiAddress"
+#define ACCOUNTS_ADDRESS "accountsAddress"
 
 Settings::Settings(QObject *parent)
     : QObject(parent)
@@ -62,3 +66,33 @@ void Settings::setIsDemoMode(bool value)
 {
     m_settings->setValue(IS_DEMO_MODE, value);
 }
+
+int Settings::maxConcurrentRequests() const
+{
+    return m_settings->value(MAX_CONCURRENT_REQUESTS, DEFAULT_MAX_CONCURRENT_REQUESTS).toInt();
+}
+
+void Settings::setMaxConcurrentRequests(int value)
+{
+    m_settings->setValue(MAX_CONCURRENT_REQUESTS, value);
+}
+
+QString Settings::apiAddress() const
+{
+    return m_settings->value(API_ADDRESS, "").toString();
+}
+
+void Settings::setApiAddress(const QString &address)
+{
+    m_settings->setValue(API_ADDRESS, address);
+}
+
+QString Settings::accountsAddress() const
+{
+    return m_settings->value(ACCOUNTS_ADDRESS, "").toString();
+}
+
+void Settings::setAccountsAddress(const QString &address)
+{
+    m_settings->setValue(ACCOUNTS_ADDRESS, address);
+}
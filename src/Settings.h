@@ -65,6 +65,39 @@ public:
      */
     void setIsDemoMode(bool isDemoMode);
 
+    /*!
+     * \brief Returns maximal number of requests to Zoho API being in flight at the same time.
+     */
+    int maxConcurrentRequests() const;
+
+    /*!
+     * \brief Sets maximal number of requests to Zoho API being in flight at the same time.
+     * \param int value -- value to set.
+     */
+    void setMaxConcurrentRequests(int value);
+
+    /*!
+     * \brief Returns address of Zoho Books API. Empty if the address of Zoho Books is used.
+     */
+    QString apiAddress() const;
+
+    /*!
+     * \brief Sets address of Zoho Books API, i.e. of a local stand-in server used for load testing.
+     * \param const QString &address -- value to set.
+     */
+    void setApiAddress(const QString &address);
+
+    /*!
+     * \brief Returns address of Zoho Accounts. Empty if the address of Zoho Accounts is used.
+     */
+    QString accountsAddress() const;
+
+    /*!
+     * \brief Sets address of Zoho Accounts, i.e. of a local stand-in server used for load testing.
+     * \param const QString &address -- value to set.
+     */
+    void setAccountsAddress(const QString &address);
+
 private:
     QSettings *m_settings = nullptr;
 };
@@ -0,0 +1,81 @@
+// <copyright company="Scythe Studio Sp. z o.o.">
+//     This file contains proprietary code. Copyright (c) 2021. All rights reserved.
+// </copyright>
+
+#include "SnapshotStore.h"
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QDebug>
+
+#define SNAPSHOT_FILE_NAME "snapshot.bin"
+#define SNAPSHOT_MAGIC 0x5A424653 // "ZBFS"
+#define SNAPSHOT_VERSION 2 // has to be increased after every change of the layout of stored objects.
+
+SnapshotStore::SnapshotStore(QObject *parent)
+    : QObject(parent)
+{
+    const QString &directory = QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation);
+    QDir().mkpath(directory);
+    m_filePath = QDir(directory).filePath(SNAPSHOT_FILE_NAME);
+}
+
+QString SnapshotStore::filePath() const
+{
+    return m_filePath;
+}
+
+bool SnapshotStore::save(const Snapshot &snapshot) const
+{
+    QSaveFile file(m_filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "Cannot write snapshot" << m_filePath << file.errorString();
+        return false;
+    }
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_5_15);
+    out << quint32(SNAPSHOT_MAGIC) << quint32(SNAPSHOT_VERSION);
+    out << snapshot.syncWatermarks << snapshot.exchangeRates
+        << snapshot.invoices << snapshot.expenses << snapshot.bills;
+
+    if (out.status() != QDataStream::Ok) {
+        file.cancelWriting();
+        return false;
+    }
+
+    return file.commit();
+}
+
+bool SnapshotStore::load(Snapshot &snapshot) const
+{
+    QFile file(m_filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_5_15);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    in >> magic >> version;
+    if (magic != SNAPSHOT_MAGIC || version != SNAPSHOT_VERSION) {
+        qWarning() << "Snapshot" << m_filePath << "has unsupported format, ignoring it";
+        return false;
+    }
+
+    Snapshot readSnapshot;
+    in >> readSnapshot.syncWatermarks >> readSnapshot.exchangeRates
+       >> readSnapshot.invoices >> readSnapshot.expenses >> readSnapshot.bills;
+
+    if (in.status() != QDataStream::Ok) {
+        qWarning() << "Snapshot" << m_filePath << "is corrupted, ignoring it";
+        return false;
+    }
+
+    snapshot = readSnapshot;
+    return true;
+}
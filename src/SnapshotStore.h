@@ -0,0 +1,62 @@
+// <copyright company="Scythe Studio Sp. z o.o.">
+//     This file contains proprietary code. Copyright (c) 2021. All rights reserved.
+// </copyright>
+
+#ifndef SNAPSHOTSTORE_H
+#define SNAPSHOTSTORE_H
+
+#include <QObject>
+#include <QDateTime>
+#include <QMap>
+
+#include "datasets/Invoice.h"
+#include "datasets/Expense.h"
+#include "datasets/Bill.h"
+
+/*!
+ * \brief Class representing a local on-disk store of the last synchronized data.
+ */
+class SnapshotStore : public QObject
+{
+    Q_OBJECT
+public:
+
+    /*!
+     * \brief Data kept in a snapshot.
+     */
+    struct Snapshot {
+        QList<Invoice> invoices;
+        QList<Expense> expenses;
+        QList<Bill> bills;
+        QMap<QString, double> exchangeRates;
+        QList<QDateTime> syncWatermarks; // indexed with WebClient::Endpoint.
+    };
+
+    /*!
+     * \brief Constructor.
+     * \param QObject *parent -- parent.
+     */
+    explicit SnapshotStore(QObject *parent = nullptr);
+
+    /*!
+     * \brief Returns path of the snapshot file.
+     */
+    QString filePath() const;
+
+    /*!
+     * \brief Writes the snapshot to the disk. Previous snapshot is replaced only if writing succeeded.
+     * \param const Snapshot &snapshot -- snapshot to write.
+     */
+    bool save(const Snapshot &snapshot) const;
+
+    /*!
+     * \brief Reads the snapshot from the disk. Returns false if there's no snapshot or it cannot be read.
+     * \param Snapshot &snapshot -- snapshot to read into.
+     */
+    bool load(Snapshot &snapshot) const;
+
+private:
+    QString m_filePath;
+};
+
+#endif // SNAPSHOTSTORE_H
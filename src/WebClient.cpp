@@ -11,6 +11,10 @@
 #include <QHttpMultiPart>
 #include <QJsonArray>
 #include <QJsonObject>
+#include <QDebug>
+#include <QFutureWatcher>
+#include <QtConcurrent>
+#include <QTimer>
 
 #define CLIENT_ID "1000.6F1ZTL3L8Q04ZCOH4XNI4T04U0TL7F"
 #define CLIENT_SECRET "05758cb8651c830c570d2fb3e69c7291909a8449ca"
@@ -19,124 +23,406 @@
 #define GRANT_TYPE_AUTHORIZATION_CODE "authorization_code"
 #define SCOPE "ZohoBooks.fullaccess.READ"
 #define SERVER_ADDRESS "https://books.zoho.eu/api/v3/"
+#define ACCOUNTS_ADDRESS "https://accounts.zoho.eu/oauth/v2/"
 #define CONTENT_TYPE "application/x-www-form-urlencoded;charset=UTF-8"
 #define ORGANIZATION_ID "20077575557"
 #define NEXT_EXPENSE_DATE "next_expense_date"
 #define NEXT_BILL_DATE "next_bill_date"
 #define EXCLUDE_BASE "Currencies.ExcludeBaseCurrency"
+#define LAST_MODIFIED_TIME_FORMAT "yyyy-MM-ddTHH:mm:ss+0000"
+#define PAGE_SIZE 200 // maximal page size accepted by Zoho Books API.
+#define MAX_REQUEST_ATTEMPTS 4
+#define RETRY_DELAY 500 // ms, doubled with every attempt.
+#define MAX_RETRY_DELAY 30000 // ms, also bounds the delay asked for by the server.
+
+// paths of the paginated endpoints, indexed with WebClient::Endpoint.
+static const char *const ENDPOINT_PATHS[WebClient::EndpointCount] = {
+    "invoices",
+    "bills",
+    "recurringbills",
+    "expenses",
+    "recurringexpenses"
+};
 
 WebClient::WebClient(QObject *parent)
     : QObject(parent)
     , m_manager(new QNetworkAccessManager(this))
+    , m_apiAddress(SERVER_ADDRESS)
+    , m_accountsAddress(ACCOUNTS_ADDRESS)
+    , m_maxConcurrentRequests(DEFAULT_MAX_CONCURRENT_REQUESTS)
 {
 }
 
+// paths are appended to the addresses, so they always end with a slash.
+static QString normalizedAddress(const QString &address, const char *defaultAddress)
+{
+    if (address.isEmpty()) {
+        return defaultAddress;
+    }
+    return address.endsWith('/') ? address : address + '/';
+}
+
+// Throttling (429), server errors (5xx) and network errors without any response usually pass after a while.
+static bool isTransientFailure(QNetworkReply *reply)
+{
+    const int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (status != 0) {
+        return status == 429 || status >= 500;
+    }
+    return reply->error() != QNetworkReply::OperationCanceledError && reply->error() < QNetworkReply::ProxyConnectionRefusedError;
+}
+
+// Delay before the next attempt, as asked for by the server in 'Retry-After' or growing exponentially.
+static int retryDelay(QNetworkReply *reply, int attempt)
+{
+    bool ok = false;
+    const int retryAfter = reply->rawHeader("Retry-After").toInt(&ok);
+    if (ok && retryAfter >= 0) {
+        return qMin(retryAfter * 1000, MAX_RETRY_DELAY);
+    }
+    return qMin(RETRY_DELAY << (attempt - 1), MAX_RETRY_DELAY);
+}
+
 //requests
 
+QString WebClient::apiAddress() const
+{
+    return m_apiAddress;
+}
+
+void WebClient::setApiAddress(const QString &address)
+{
+    m_apiAddress = normalizedAddress(address, SERVER_ADDRESS);
+}
+
+QString WebClient::accountsAddress() const
+{
+    return m_accountsAddress;
+}
+
+void WebClient::setAccountsAddress(const QString &address)
+{
+    m_accountsAddress = normalizedAddress(address, ACCOUNTS_ADDRESS);
+}
+
+int WebClient::maxConcurrentRequests() const
+{
+    return m_maxConcurrentRequests;
+}
+
+void WebClient::setMaxConcurrentRequests(int value)
+{
+    m_maxConcurrentRequests = qMax(1, value);
+    pumpRequests();
+}
+
+void WebClient::resetSyncWatermarks()
+{
+    for (int i = 0; i < EndpointCount; ++i) {
+        m_syncWatermarks[i] = QDateTime();
+    }
+}
+
+QList<QDateTime> WebClient::syncWatermarks() const
+{
+    QList<QDateTime> watermarks;
+    for (int i = 0; i < EndpointCount; ++i) {
+        watermarks << m_syncWatermarks[i];
+    }
+    return watermarks;
+}
+
+void WebClient::setSyncWatermarks(const QList<QDateTime> &watermarks)
+{
+    for (int i = 0; i < EndpointCount; ++i) {
+        m_syncWatermarks[i] = i < watermarks.size() ? watermarks.at(i) : QDateTime();
+    }
+}
+
 void WebClient::getInvoicesRequest(const QString &accessToken)
 {
-    QUrl url(QString(SERVER_ADDRESS "invoices"));
+    startPagedFetch(InvoicesEndpoint, accessToken);
+}
+
+void WebClient::getExpensesRequest(const QString &accessToken)
+{
+    startPagedFetch(ExpensesEndpoint, accessToken);
+}
+
+void WebClient::getRecurringExpensesRequest(const QString &accessToken)
+{
+    startPagedFetch(RecurringExpensesEndpoint, accessToken);
+}
+
+void WebClient::getBillsRequest(const QString &accessToken)
+{
+    startPagedFetch(BillsEndpoint, accessToken);
+}
+
+void WebClient::getRecurringBillsRequest(const QString &accessToken)
+{
+    m_recurringBillsNumbers.clear();
+    m_recurringBills.clear();
+    m_recurringBillsInFlight = 0;
+    m_recurringBillsAttempts.clear();
+    startPagedFetch(RecurringBillsEndpoint, accessToken);
+}
+
+void WebClient::startPagedFetch(Endpoint endpoint, const QString &accessToken)
+{
+    m_accessToken = accessToken;
+
+    PagedFetch &fetch = m_fetches[endpoint];
+    if (!fetch.active) {
+        ++m_activeFetches;
+    }
+    fetch = PagedFetch();
+    fetch.active = true;
+    fetch.generation = ++m_fetchGeneration;
+    // documents modified while the fetch is running are fetched again next time, which is harmless as they are merged by id.
+    fetch.startedAt = QDateTime::currentDateTimeUtc();
+    fetch.modifiedSince = m_syncWatermarks[endpoint];
+
+    pumpRequests();
+}
+
+bool WebClient::canRequestNextPage(const PagedFetch &fetch) const
+{
+    if (!fetch.active) {
+        return false;
+    }
+
+    if (fetch.nextPage == 1) {
+        return true;
+    }
+
+    // Until the first page confirms there is more data, no page is requested ahead.
+    // Afterwards pages are requested speculatively, but never further than the window ahead of the last landed page.
+    if (!fetch.hasMorePages) {
+        return false;
+    }
+
+    if (fetch.lastPage != -1 && fetch.nextPage > fetch.lastPage) {
+        return false;
+    }
+
+    return fetch.nextPage - fetch.completedUpTo <= m_maxConcurrentRequests;
+}
+
+void WebClient::pumpRequests()
+{
+    while (m_requestsInFlight < m_maxConcurrentRequests) {
+        // details of recurring bills are served first as they hold back finishing of the whole endpoint.
+        if (!m_recurringBillsNumbers.isEmpty()) {
+            getRecurringBillRequest(m_accessToken, m_recurringBillsNumbers.takeFirst());
+            continue;
+        }
+
+        bool requested = false;
+        for (int i = 0; i < EndpointCount; ++i) {
+            const Endpoint endpoint = static_cast<Endpoint>((m_nextEndpoint + i) % EndpointCount);
+            PagedFetch &fetch = m_fetches[endpoint];
+            const bool hasRetriedPage = fetch.active && !fetch.retriedPages.isEmpty();
+            if (hasRetriedPage || canRequestNextPage(fetch)) {
+                m_nextEndpoint = (endpoint + 1) % EndpointCount;
+                requestPage(endpoint, hasRetriedPage ? fetch.retriedPages.takeFirst() : fetch.nextPage++);
+                requested = true;
+                break;
+            }
+        }
+
+        if (!requested) {
+            break;
+        }
+    }
+}
+
+void WebClient::requestPage(Endpoint endpoint, int page)
+{
+    const quint64 generation = m_fetches[endpoint].generation;
+
+    QUrl url(m_apiAddress + ENDPOINT_PATHS[endpoint]);
     QUrlQuery query;
     query.addQueryItem("organization_id", ORGANIZATION_ID);
-    query.addQueryItem("sort_column", "due_date");
+    query.addQueryItem("page", QString::number(page));
+    query.addQueryItem("per_page", QString::number(PAGE_SIZE));
+    if (endpoint == InvoicesEndpoint) {
+        query.addQueryItem("sort_column", "due_date");
+    }
+    if (m_fetches[endpoint].modifiedSince.isValid()) {
+        query.addQueryItem("last_modified_time", m_fetches[endpoint].modifiedSince.toString(LAST_MODIFIED_TIME_FORMAT));
+    }
     url.setQuery(query);
 
     QNetworkRequest request(url);
-    request.setRawHeader("Authorization", "Zoho-oauthtoken " + accessToken.toUtf8());
+    request.setRawHeader("Authorization", "Zoho-oauthtoken " + m_accessToken.toUtf8());
     request.setRawHeader("Content-type", CONTENT_TYPE);
 
+    ++m_requestsInFlight;
     QNetworkReply *reply = m_manager->get(request);
 
     connect(reply, &QNetworkReply::finished, this, [=]() {
-        if (reply->error() == QNetworkReply::NoError)
-        {
-            parseGetInvoicesResponse(reply->readAll());
+        --m_requestsInFlight;
+        // replies belonging to a fetch that has been restarted in the meantime are dropped.
+        if (m_fetches[endpoint].active && m_fetches[endpoint].generation == generation) {
+            if (reply->error() == QNetworkReply::NoError) {
+                onPageReceived(endpoint, page, reply->readAll());
+            } else if (isTransientFailure(reply) && ++m_fetches[endpoint].attempts[page] < MAX_REQUEST_ATTEMPTS) {
+                retryPage(endpoint, page, retryDelay(reply, m_fetches[endpoint].attempts[page]), reply->errorString());
+            } else {
+                onPageFailed(endpoint, page, reply->errorString());
+            }
         }
         reply->deleteLater();
+        pumpRequests();
     });
 }
 
-void WebClient::getExpensesRequest(const QString &accessToken)
+void WebClient::onPageReceived(Endpoint endpoint, int page, const QByteArray &response)
 {
-     QUrl url(QString(SERVER_ADDRESS "expenses"));
-     QUrlQuery query;
-     query.addQueryItem("organization_id", ORGANIZATION_ID);
-     url.setQuery(query);
+    const quint64 generation = m_fetches[endpoint].generation;
+
+    // the page stays uncompleted until it's decoded, so the endpoint cannot finish before its documents are handed over.
+    auto *watcher = new QFutureWatcher<DecodedPage>(this);
+    connect(watcher, &QFutureWatcher<DecodedPage>::finished, this, [=]() {
+        if (m_fetches[endpoint].active && m_fetches[endpoint].generation == generation) {
+            DecodedPage decodedPage = watcher->result();
+            onPageDecoded(endpoint, page, decodedPage);
+            pumpRequests();
+        }
+        watcher->deleteLater();
+    });
+    watcher->setFuture(QtConcurrent::run(&WebClient::decodePage, endpoint, response));
+}
 
-     QNetworkRequest request(url);
-     request.setRawHeader("Authorization", "Zoho-oauthtoken " + accessToken.toUtf8());
-     QNetworkReply *reply = m_manager->get(request);
+void WebClient::onPageDecoded(Endpoint endpoint, int page, DecodedPage &decodedPage)
+{
+    const PagedFetch &fetch = m_fetches[endpoint];
+
+    // speculative pages behind the last one carry no data.
+    if (fetch.lastPage == -1 || page <= fetch.lastPage) {
+        switch (endpoint) {
+        case InvoicesEndpoint:
+            emit invoicesReceived(decodedPage.invoices);
+            break;
+        case BillsEndpoint:
+            emit normalBillsReceived(decodedPage.bills);
+            break;
+        case RecurringBillsEndpoint:
+            // list endpoint lacks some fields, so details of every recurring bill are requested through the same window.
+            m_recurringBillsNumbers << decodedPage.recurringBillsNumbers;
+            break;
+        case ExpensesEndpoint:
+            emit normalExpensesReceived(decodedPage.expenses);
+            break;
+        case RecurringExpensesEndpoint:
+            emit recurringExpensesReceived(decodedPage.expenses);
+            break;
+        case EndpointCount:
+            break;
+        }
+    }
 
-     connect(reply, &QNetworkReply::finished, this, [=]() {
-         if (reply->error() == QNetworkReply::NoError) {
-             parseGetExpensesResponse(reply->readAll());
-         }
-         reply->deleteLater();
-     });
+    markPageCompleted(endpoint, page, decodedPage.hasMorePages);
 }
 
-void WebClient::getRecurringExpensesRequest(const QString &accessToken)
+void WebClient::retryPage(Endpoint endpoint, int page, int delay, const QString &errorString)
 {
-     QUrl url(QString(SERVER_ADDRESS "recurringexpenses"));
-     QUrlQuery query;
-     query.addQueryItem("organization_id", ORGANIZATION_ID);
-     url.setQuery(query);
+    qWarning() << "Fetching page" << page << "of" << ENDPOINT_PATHS[endpoint] << "failed:" << errorString
+               << "- retrying in" << delay << "ms";
+
+    // the page stays uncompleted in the meantime, so the endpoint cannot finish without it.
+    const quint64 generation = m_fetches[endpoint].generation;
+    QTimer::singleShot(delay, this, [=]() {
+        PagedFetch &fetch = m_fetches[endpoint];
+        if (fetch.active && fetch.generation == generation) {
+            fetch.retriedPages << page;
+            pumpRequests();
+        }
+    });
+}
 
-     QNetworkRequest request(url);
-     request.setRawHeader("Authorization", "Zoho-oauthtoken " + accessToken.toUtf8());
-     QNetworkReply *reply = m_manager->get(request);
+void WebClient::onPageFailed(Endpoint endpoint, int page, const QString &errorString)
+{
+    // a page which failed for good ends the endpoint, otherwise speculative requests would never stop.
+    qWarning() << "Fetching page" << page << "of" << ENDPOINT_PATHS[endpoint] << "failed:" << errorString;
+    reportFetchFailure(endpoint, errorString);
+    markPageCompleted(endpoint, page, false);
+}
 
-     connect(reply, &QNetworkReply::finished, this, [=]() {
-         if (reply->error() == QNetworkReply::NoError) {
-             parseGetRecurringExpensesResponse(reply->readAll());
-         }
-         reply->deleteLater();
-     });
+void WebClient::reportFetchFailure(Endpoint endpoint, const QString &errorString)
+{
+    PagedFetch &fetch = m_fetches[endpoint];
+    if (!fetch.failed) {
+        fetch.failed = true;
+        emit fetchFailed(ENDPOINT_PATHS[endpoint], errorString);
+    }
 }
 
-void WebClient::getBillsRequest(const QString &accessToken)
+void WebClient::markPageCompleted(Endpoint endpoint, int page, bool hasMorePages)
 {
-     QUrl url(QString(SERVER_ADDRESS "bills"));
-     QUrlQuery query;
-     query.addQueryItem("organization_id", ORGANIZATION_ID);
-     url.setQuery(query);
+    PagedFetch &fetch = m_fetches[endpoint];
+    fetch.completedPages.insert(page);
+    while (fetch.completedPages.contains(fetch.completedUpTo + 1)) {
+        ++fetch.completedUpTo;
+    }
 
-     QNetworkRequest request(url);
-     request.setRawHeader("Authorization", "Zoho-oauthtoken " + accessToken.toUtf8());
-     QNetworkReply *reply = m_manager->get(request);
+    if (hasMorePages) {
+        fetch.hasMorePages = true;
+    } else if (fetch.lastPage == -1 || page < fetch.lastPage) {
+        fetch.lastPage = page;
+    }
 
-     connect(reply, &QNetworkReply::finished, this, [=]() {
-         if (reply->error() == QNetworkReply::NoError) {
-             parseGetBillsResponse(reply->readAll());
-         }
-         reply->deleteLater();
-     });
+    checkFetchFinished(endpoint);
 }
 
-void WebClient::getRecurringBillsRequest(const QString &accessToken)
+void WebClient::checkFetchFinished(Endpoint endpoint)
 {
-     m_recurringBillsNumbers.clear();
-     m_recurringBills.clear();
-     QUrl url(QString(SERVER_ADDRESS "recurringbills"));
-     QUrlQuery query;
-     query.addQueryItem("organization_id", ORGANIZATION_ID);
-     url.setQuery(query);
+    PagedFetch &fetch = m_fetches[endpoint];
+    if (!fetch.active || fetch.lastPage == -1 || fetch.completedUpTo < fetch.lastPage) {
+        return;
+    }
 
-     QNetworkRequest request(url);
-     request.setRawHeader("Authorization", "Zoho-oauthtoken " + accessToken.toUtf8());
-     QNetworkReply *reply = m_manager->get(request);
+    if (endpoint == RecurringBillsEndpoint && (m_recurringBillsInFlight > 0 || !m_recurringBillsNumbers.isEmpty())) {
+        return;
+    }
 
-     connect(reply, &QNetworkReply::finished, this, [=]() {
-         if (reply->error() == QNetworkReply::NoError) {
-             parseGetRecurringBillsResponse(reply->readAll(), accessToken);
-         }
-         reply->deleteLater();
-     });
+    fetch.active = false;
+    --m_activeFetches;
+
+    // a failed fetch does not move the watermark, so missing documents are requested again next time.
+    if (!fetch.failed) {
+        m_syncWatermarks[endpoint] = fetch.startedAt;
+    }
+
+    switch (endpoint) {
+    case InvoicesEndpoint:
+        emit allInvoicesReceived();
+        break;
+    case BillsEndpoint:
+        emit allNormalBillsReceived();
+        break;
+    case RecurringBillsEndpoint:
+        emit allRecurringBillsReceived();
+        break;
+    case ExpensesEndpoint:
+        emit allNormalExpensesReceived();
+        break;
+    case RecurringExpensesEndpoint:
+        emit allRecurringExpensesReceived();
+        break;
+    case EndpointCount:
+        break;
+    }
+
+    if (m_activeFetches == 0) {
+        emit allDataReceived();
+    }
 }
 
 void WebClient::postRefreshAccessTokenRequest(const QString &refreshToken)
 {
-     QUrl url(QString("https://accounts.zoho.eu/oauth/v2/token"));
+     QUrl url(m_accountsAddress + "token");
      QUrlQuery query;
      query.addQueryItem("refresh_token", refreshToken.toUtf8());
      query.addQueryItem("client_id", CLIENT_ID);
@@ -158,7 +444,7 @@ void WebClient::postRefreshAccessTokenRequest(const QString &refreshToken)
 
 void WebClient::postNewAccessAndRefreshTokensRequest(const QString &grantCode)
 {
-     QUrl url(QString("https://accounts.zoho.eu/oauth/v2/token"));
+     QUrl url(m_accountsAddress + "token");
      QUrlQuery query;
      query.addQueryItem("client_id", CLIENT_ID);
      query.addQueryItem("client_secret", CLIENT_SECRET);
@@ -186,7 +472,7 @@ void WebClient::postNewAccessAndRefreshTokensRequest(const QString &grantCode)
 
 void WebClient::getMocRequest(const QString &accessToken, const QString &refreshToken)
 {
-    QUrl url(QString(SERVER_ADDRESS "organizations"));
+    QUrl url(m_apiAddress + "organizations");
     QUrlQuery query;
     query.addQueryItem("organization_id", ORGANIZATION_ID);
 
@@ -207,7 +493,7 @@ void WebClient::getMocRequest(const QString &accessToken, const QString &refresh
 
 void WebClient::getListOfCurrenciesRequest(const QString &accessToken)
 {
-    QUrl url(QString(SERVER_ADDRESS "settings/currencies?filter_by=Currencies.ExcludeBaseCurrency"));
+    QUrl url(m_apiAddress + "settings/currencies?filter_by=Currencies.ExcludeBaseCurrency");
     QUrlQuery query;
     query.addQueryItem("organization_id", ORGANIZATION_ID);
 
@@ -225,7 +511,7 @@ void WebClient::getListOfCurrenciesRequest(const QString &accessToken)
 
 void WebClient::getExchangeRateRequest(const QString &accessToken, const QString &currency_id)
 {
-    QUrl url(QString("https://books.zoho.eu/api/v3/settings/currencies/" + currency_id + "/exchangerates/"));
+    QUrl url(m_apiAddress + "settings/currencies/" + currency_id + "/exchangerates/");
     QUrlQuery query;
     query.addQueryItem("organization_id", ORGANIZATION_ID);
 
@@ -243,111 +529,170 @@ void WebClient::getExchangeRateRequest(const QString &accessToken, const QString
 
 //parsing
 
-void WebClient::parseGetInvoicesResponse(const QByteArray &response)
+WebClient::DecodedPage WebClient::decodePage(Endpoint endpoint, const QByteArray &response)
 {
     const QJsonDocument &jsonResponse = QJsonDocument::fromJson(response);
+
+    DecodedPage decodedPage;
+    decodedPage.hasMorePages = jsonResponse["page_context"].toObject()["has_more_page"].toBool();
+
+    switch (endpoint) {
+    case InvoicesEndpoint:
+        decodedPage.invoices = parseGetInvoicesResponse(jsonResponse);
+        break;
+    case BillsEndpoint:
+        decodedPage.bills = parseGetBillsResponse(jsonResponse);
+        break;
+    case RecurringBillsEndpoint:
+        decodedPage.recurringBillsNumbers = parseGetRecurringBillsResponse(jsonResponse);
+        break;
+    case ExpensesEndpoint:
+        decodedPage.expenses = parseGetExpensesResponse(jsonResponse);
+        break;
+    case RecurringExpensesEndpoint:
+        decodedPage.expenses = parseGetRecurringExpensesResponse(jsonResponse);
+        break;
+    case EndpointCount:
+        break;
+    }
+
+    return decodedPage;
+}
+
+QList<Invoice> WebClient::parseGetInvoicesResponse(const QJsonDocument &jsonResponse)
+{
     const QJsonArray &jsonInvoices = jsonResponse["invoices"].toArray();
 
     QList<Invoice> invoices;
+    invoices.reserve(jsonInvoices.size());
 
     for (const auto &invoiceJson : jsonInvoices) {
-        const auto &invoiceMap = invoiceJson.toVariant().toMap();
-        invoices << Invoice::parseInvoice(invoiceMap);
+        invoices << Invoice::parseInvoice(invoiceJson.toObject());
     }
 
-    emit invoicesReceived(invoices);
+    return invoices;
 }
 
-void WebClient::parseGetExpensesResponse(const QByteArray &response)
+QList<Expense> WebClient::parseGetExpensesResponse(const QJsonDocument &jsonResponse)
 {
-    const QJsonDocument &jsonResponse = QJsonDocument::fromJson(response);
     const QJsonArray &jsonExpenses = jsonResponse["expenses"].toArray();
 
     QList<Expense> expenses;
+    expenses.reserve(jsonExpenses.size());
 
     for (const auto &expenseJson : jsonExpenses)
     {
-        const auto &expenseMap = expenseJson.toVariant().toMap();
-        expenses << Expense::parseNormalExpense(expenseMap);
+        expenses << Expense::parseNormalExpense(expenseJson.toObject());
     }
 
-    emit normalExpensesReceived(expenses);
+    return expenses;
 }
 
-void WebClient::parseGetRecurringExpensesResponse(const QByteArray &response)
+QList<Expense> WebClient::parseGetRecurringExpensesResponse(const QJsonDocument &jsonResponse)
 {
-    const QJsonDocument &jsonResponse = QJsonDocument::fromJson(response);
     const QJsonArray &jsonRecurringExpenses = jsonResponse["recurring_expenses"].toArray();
 
     QList<Expense> recurringExpenses;
+    recurringExpenses.reserve(jsonRecurringExpenses.size());
 
     for (const auto &recurringExpenseJson : jsonRecurringExpenses) {
-        const auto &recurrentExpenseMap = recurringExpenseJson.toVariant().toMap();
-        const Expense &expense = Expense::parseRecurrentExpense(recurrentExpenseMap);
-        recurringExpenses << expense;
+        recurringExpenses << Expense::parseRecurrentExpense(recurringExpenseJson.toObject());
     }
 
-    emit recurringExpensesReceived(recurringExpenses);
+    return recurringExpenses;
 }
 
-void WebClient::parseGetBillsResponse(const QByteArray &response)
+QList<Bill> WebClient::parseGetBillsResponse(const QJsonDocument &jsonResponse)
 {
-    const QJsonDocument &jsonResponse = QJsonDocument::fromJson(response);
     const QJsonArray &jsonBills = jsonResponse["bills"].toArray();
 
     QList<Bill> bills;
+    bills.reserve(jsonBills.size());
 
     for (const auto &billJson : jsonBills) {
-        const auto &billMap = billJson.toVariant().toMap();
-        bills << Bill::parseNormalBill(billMap);
+        bills << Bill::parseNormalBill(billJson.toObject());
     }
 
-    emit normalBillsReceived(bills);
+    return bills;
 }
 
-void WebClient::parseGetRecurringBillsResponse(const QByteArray &response, const QString &accessToken)
+QStringList WebClient::parseGetRecurringBillsResponse(const QJsonDocument &jsonResponse)
 {
-    const QJsonDocument &jsonResponse = QJsonDocument::fromJson(response);
     const QJsonArray &jsonRecurringBills = jsonResponse["recurring_bills"].toArray();
 
+    QStringList recurringBillsNumbers;
+    recurringBillsNumbers.reserve(jsonRecurringBills.size());
+
     for (const auto &jsonRecurrentBill : jsonRecurringBills) {
-        const auto &recurrentBillMap = jsonRecurrentBill.toVariant().toMap();
-        m_recurringBillsNumbers << recurrentBillMap["recurring_bill_id"].toString();
+        recurringBillsNumbers << jsonRecurrentBill.toObject()["recurring_bill_id"].toString();
     }
 
-    for (auto it = m_recurringBillsNumbers.begin(); it != m_recurringBillsNumbers.end(); ++it) {
-        getRecurringBillRequest(accessToken, *it);
-    }
+    return recurringBillsNumbers;
 }
 
 void WebClient::getRecurringBillRequest(const QString &accessToken, const QString &recurring_bill_id)
 {
-     QUrl url(QString(SERVER_ADDRESS "recurringbills/" + recurring_bill_id));
+     const quint64 generation = m_fetches[RecurringBillsEndpoint].generation;
+
+     QUrl url(m_apiAddress + "recurringbills/" + recurring_bill_id);
      QUrlQuery query;
      query.addQueryItem("organization_id", ORGANIZATION_ID);
      url.setQuery(query);
 
      QNetworkRequest request(url);
      request.setRawHeader("Authorization", "Zoho-oauthtoken " + accessToken.toUtf8());
+
+     ++m_requestsInFlight;
+     ++m_recurringBillsInFlight;
      QNetworkReply *reply = m_manager->get(request);
 
      connect(reply, &QNetworkReply::finished, this, [=]() {
-         if (reply->error() == QNetworkReply::NoError) {
-             parseGetRecurringBillResponse(reply->readAll());
+         --m_requestsInFlight;
+         if (m_fetches[RecurringBillsEndpoint].generation == generation) {
+             if (reply->error() != QNetworkReply::NoError && isTransientFailure(reply)
+                     && ++m_recurringBillsAttempts[recurring_bill_id] < MAX_REQUEST_ATTEMPTS) {
+                 const int delay = retryDelay(reply, m_recurringBillsAttempts.value(recurring_bill_id));
+                 qWarning() << "Fetching recurring bill" << recurring_bill_id << "failed:" << reply->errorString()
+                            << "- retrying in" << delay << "ms";
+                 // the bill is counted as in flight until it's requested again, so the endpoint cannot finish without it.
+                 QTimer::singleShot(delay, this, [=]() {
+                     if (m_fetches[RecurringBillsEndpoint].generation == generation) {
+                         --m_recurringBillsInFlight;
+                         m_recurringBillsNumbers.prepend(recurring_bill_id);
+                         pumpRequests();
+                     }
+                 });
+                 reply->deleteLater();
+                 pumpRequests();
+                 return;
+             }
+
+             --m_recurringBillsInFlight;
+             if (reply->error() == QNetworkReply::NoError) {
+                 parseGetRecurringBillResponse(reply->readAll());
+             } else {
+                 qWarning() << "Fetching recurring bill" << recurring_bill_id << "failed:" << reply->errorString();
+                 reportFetchFailure(RecurringBillsEndpoint, reply->errorString());
+             }
+
+             // details are handed over in batches, once all currently requested ones have landed.
+             if (m_recurringBillsInFlight == 0 && m_recurringBillsNumbers.isEmpty() && !m_recurringBills.isEmpty()) {
+                 emit recurringBillsReceived(m_recurringBills);
+                 m_recurringBills.clear();
+             }
+             checkFetchFinished(RecurringBillsEndpoint);
          }
          reply->deleteLater();
+         pumpRequests();
      });
 }
+
 void WebClient::parseGetRecurringBillResponse(const QByteArray &response)
 {
     const QJsonDocument &jsonResponse = QJsonDocument::fromJson(response);
     const QJsonObject &jsonObject = jsonResponse["recurring_bill"].toObject();
 
-    m_recurringBills << Bill::parseRecurringBill(jsonObject.toVariantMap());
-
-    if (m_recurringBills.size() == m_recurringBillsNumbers.size()) {
-        emit recurringBillsReceived(m_recurringBills);
-    }
+    m_recurringBills << Bill::parseRecurringBill(jsonObject);
 }
 
 void WebClient::parsePostRefreshAccessTokenResponse(const QByteArray &response)
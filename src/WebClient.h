@@ -7,12 +7,18 @@
 
 #include <QObject>
 #include <QNetworkAccessManager>
+#include <QJsonDocument>
 #include <QDate>
+#include <QDateTime>
+#include <QSet>
+#include <QHash>
 
 #include "datasets/Invoice.h"
 #include "datasets/Expense.h"
 #include "datasets/Bill.h"
 
+#define DEFAULT_MAX_CONCURRENT_REQUESTS 6 // QNetworkAccessManager opens up to 6 connections per host.
+
 /*!
  * \brief Class representing web-client making requests for data and tokens.
  */
@@ -26,38 +32,104 @@ public:
      */
     explicit WebClient(QObject *parent = nullptr);
 
-    // getting data
+    /*!
+     * \brief Enum representing a paginated list endpoint of Zoho Books API.
+     */
+    enum Endpoint {
+        InvoicesEndpoint,
+        BillsEndpoint,
+        RecurringBillsEndpoint,
+        ExpensesEndpoint,
+        RecurringExpensesEndpoint,
+        EndpointCount
+    };
+
+    /*!
+     * \brief Returns address of Zoho Books API the requests for documents are made to.
+     */
+    QString apiAddress() const;
+
+    /*!
+     * \brief Sets address of Zoho Books API, i.e. of a local stand-in server.
+     * \param const QString &address -- value to set. Empty value restores the address of Zoho Books.
+     */
+    void setApiAddress(const QString &address);
+
+    /*!
+     * \brief Returns address of Zoho Accounts the requests for tokens are made to.
+     */
+    QString accountsAddress() const;
+
+    /*!
+     * \brief Sets address of Zoho Accounts, i.e. of a local stand-in server.
+     * \param const QString &address -- value to set. Empty value restores the address of Zoho Accounts.
+     */
+    void setAccountsAddress(const QString &address);
+
+    /*!
+     * \brief Returns maximal number of requests being in flight at the same time.
+     */
+    int maxConcurrentRequests() const;
+
+    /*!
+     * \brief Sets maximal number of requests being in flight at the same time.
+     * \param int value -- value to set. Values lower than 1 are treated as 1.
+     */
+    void setMaxConcurrentRequests(int value);
+
+    /*!
+     * \brief Forgets moments of the last successful synchronization, so the next requests download all the documents.
+     */
+    void resetSyncWatermarks();
+
+    /*!
+     * \brief Returns moments of the last successful synchronization of every endpoint.
+     */
+    QList<QDateTime> syncWatermarks() const;
+
+    /*!
+     * \brief Sets moments of the last successful synchronization of every endpoint, i.e. restored from a snapshot.
+     * \param const QList<QDateTime> &watermarks -- values to set, indexed with Endpoint.
+     */
+    void setSyncWatermarks(const QList<QDateTime> &watermarks);
+
+    // getting data. If an endpoint has been synchronized before, only documents modified since then are fetched.
 
     /*!
-     * \brief Makes GET request for invoices.
+     * \brief Fetches all pages of invoices. Each page is emitted with invoicesReceived() as it lands.
      * \param const QString &accessToken -- access token for making request.
      */
     void getInvoicesRequest(const QString &accessToken);
 
     /*!
-     * \brief Makes GET request for expenses.
+     * \brief Fetches all pages of expenses. Each page is emitted with normalExpensesReceived() as it lands.
      * \param const QString &accessToken -- access token for making request.
      */
     void getExpensesRequest(const QString &accessToken);
 
     /*!
-     * \brief Makes GET request for recurring expenses.
+     * \brief Fetches all pages of recurring expenses. Each page is emitted with recurringExpensesReceived() as it lands.
      * \param const QString &accessToken -- access token for making request.
      */
     void getRecurringExpensesRequest(const QString &accessToken);
 
     /*!
-     * \brief Makes GET request for bills.
+     * \brief Fetches all pages of bills. Each page is emitted with normalBillsReceived() as it lands.
      * \param const QString &accessToken -- access token for making request.
      */
     void getBillsRequest(const QString &accessToken);
 
     /*!
-     * \brief Makes GET request for recurring bills.
+     * \brief Fetches all pages of recurring bills together with details of every recurring bill.
      * \param const QString &accessToken -- access token for making request.
      */
     void getRecurringBillsRequest(const QString &accessToken);
 
+    /*!
+     * \brief Makes GET request for details of a single recurring bill.
+     * \param const QString &accessToken -- access token for making request.
+     * \param const QString &recurring_bill_id -- id of the recurring bill.
+     */
     void getRecurringBillRequest(const QString &accessToken, const QString &recurring_bill_id);
 
     /*!
@@ -94,7 +166,6 @@ public:
      */
     void getMocRequest(const QString &accessToken, const QString &refreshToken);
 
-    void parseGetRecurringBillResponse(const QByteArray &repsonse);
 signals:
 
     /*!
@@ -104,35 +175,73 @@ signals:
     void accessTokenRefreshed(const QString &accessToken);
 
     /*!
-     * \brief This signal is emitted  when invoices have been proceeded and can be utilized.
+     * \brief This signal is emitted  when a page of invoices has been proceeded and can be utilized.
      * \param QList<Invoice> &invoices -- list of invoices.
      */
     void invoicesReceived(QList<Invoice> &invoices);
 
     /*!
-     * \brief This signal is emitted when recurring expenses have been proceeded and can be utilized.
+     * \brief This signal is emitted when a page of recurring expenses has been proceeded and can be utilized.
      * \param QList<Expense> &expenses -- list of expenses.
      */
     void recurringExpensesReceived(QList<Expense> &recurringExpenses);
 
     /*!
-     * \brief This signal is emitted when normal expenses have been proceeded and can be utilized.
+     * \brief This signal is emitted when a page of normal expenses has been proceeded and can be utilized.
      * \param QList<Expense> &expenses -- list of expenses.
      */
     void normalExpensesReceived(QList<Expense> &expenses);
 
     /*!
-     * \brief This signal is emitted when recurring bills have been proceeded and can be utilized.
+     * \brief This signal is emitted when a batch of recurring bills has been proceeded and can be utilized.
      * \param QList<Bill> &bills -- list of bills.
      */
     void recurringBillsReceived(QList<Bill> &recurringBills);
 
     /*!
-     * \brief This signal is emitted when normal bills have been proceeded and can be utilized.
+     * \brief This signal is emitted when a page of normal bills has been proceeded and can be utilized.
      * \param QList<Bill> &bills -- list of bills.
      */
     void normalBillsReceived(QList<Bill> &bills);
 
+    /*!
+     * \brief This signal is emitted when all pages of invoices have been received.
+     */
+    void allInvoicesReceived();
+
+    /*!
+     * \brief This signal is emitted when all pages of recurring expenses have been received.
+     */
+    void allRecurringExpensesReceived();
+
+    /*!
+     * \brief This signal is emitted when all pages of normal expenses have been received.
+     */
+    void allNormalExpensesReceived();
+
+    /*!
+     * \brief This signal is emitted when all pages and details of recurring bills have been received.
+     */
+    void allRecurringBillsReceived();
+
+    /*!
+     * \brief This signal is emitted when all pages of normal bills have been received.
+     */
+    void allNormalBillsReceived();
+
+    /*!
+     * \brief This signal is emitted when all pages of all requested endpoints have been received.
+     */
+    void allDataReceived();
+
+    /*!
+     * \brief This signal is emitted when some documents of an endpoint couldn't be fetched, even after retrying.
+     * The endpoint still finishes with the documents that have been received, but they are incomplete.
+     * \param const QString &endpointName -- name of the endpoint, i.e. 'invoices'.
+     * \param const QString &errorString -- description of the last error.
+     */
+    void fetchFailed(const QString &endpointName, const QString &errorString);
+
     /*!
      * \brief This signal is emitted when GET mock-request had positive response.
      */
@@ -158,19 +267,77 @@ signals:
     void exchangeRateReceived(const QString &currency_code, const double &exchangeRate);
 
 private:
-    void parseGetInvoicesResponse(const QByteArray &response);
-    void parseGetExpensesResponse(const QByteArray &response);
-    void parseGetRecurringExpensesResponse(const QByteArray &response);
-    void parseGetBillsResponse(const QByteArray &response);
-    void parseGetRecurringBillsResponse(const QByteArray &response, const QString &accessToken);
+    friend class PipelineBenchmark; // measures decoding of responses without the network.
+
+    /*!
+     * \brief State of fetching all pages of a single endpoint.
+     */
+    struct PagedFetch {
+        bool active = false;
+        bool failed = false;
+        quint64 generation = 0; // replies of previous fetches are dropped.
+        QDateTime startedAt;
+        QDateTime modifiedSince; // invalid for a full synchronization.
+        int nextPage = 1;
+        int lastPage = -1; // unknown until some page reports no more pages.
+        int completedUpTo = 0; // all pages up to this one have landed.
+        bool hasMorePages = false; // speculative fan-out starts once the first page confirms more pages.
+        QSet<int> completedPages;
+        QList<int> retriedPages; // pages which failed transiently, requested again before any new page.
+        QHash<int, int> attempts; // number of failed attempts by page.
+    };
+
+    void startPagedFetch(Endpoint endpoint, const QString &accessToken);
+    void requestPage(Endpoint endpoint, int page);
+    // documents of a single page, decoded on a worker thread.
+    struct DecodedPage {
+        bool hasMorePages = false;
+        QList<Invoice> invoices;
+        QList<Expense> expenses;
+        QList<Bill> bills;
+        QStringList recurringBillsNumbers;
+    };
+
+    void onPageReceived(Endpoint endpoint, int page, const QByteArray &response);
+    void onPageDecoded(Endpoint endpoint, int page, DecodedPage &decodedPage);
+    void retryPage(Endpoint endpoint, int page, int delay, const QString &errorString);
+    void onPageFailed(Endpoint endpoint, int page, const QString &errorString);
+    void reportFetchFailure(Endpoint endpoint, const QString &errorString);
+    void markPageCompleted(Endpoint endpoint, int page, bool hasMorePages);
+    void checkFetchFinished(Endpoint endpoint);
+    bool canRequestNextPage(const PagedFetch &fetch) const;
+    void pumpRequests();
+
+    // decoding functions don't touch members, so they can be run outside of the GUI thread.
+    static DecodedPage decodePage(Endpoint endpoint, const QByteArray &response);
+    static QList<Invoice> parseGetInvoicesResponse(const QJsonDocument &jsonResponse);
+    static QList<Expense> parseGetExpensesResponse(const QJsonDocument &jsonResponse);
+    static QList<Expense> parseGetRecurringExpensesResponse(const QJsonDocument &jsonResponse);
+    static QList<Bill> parseGetBillsResponse(const QJsonDocument &jsonResponse);
+    static QStringList parseGetRecurringBillsResponse(const QJsonDocument &jsonResponse);
     void parsePostRefreshAccessTokenResponse(const QByteArray &response);
     void parsePostNewAccessAndRefreshTokenRequest(const QByteArray &response);
     void parseGetListOfCurrencies(const QByteArray &response, const QString &accessToken);
     void parseGetExchageRate(const QByteArray &response);
+    void parseGetRecurringBillResponse(const QByteArray &response);
 
 private:
     QNetworkAccessManager *m_manager = nullptr;
-    QStringList m_recurringBillsNumbers; // Used for recurring bills issue.
+    QString m_accessToken;
+    QString m_apiAddress;
+    QString m_accountsAddress;
+
+    PagedFetch m_fetches[EndpointCount];
+    QDateTime m_syncWatermarks[EndpointCount]; // start of the last fetch that completed without errors.
+    quint64 m_fetchGeneration = 0;
+    int m_activeFetches = 0;
+    int m_requestsInFlight = 0;
+    int m_maxConcurrentRequests;
+    int m_nextEndpoint = 0; // endpoints are served in round-robin manner.
+
+    QStringList m_recurringBillsNumbers; // Used for recurring bills issue. Ids waiting for the details request.
+    int m_recurringBillsInFlight = 0;
+    QHash<QString, int> m_recurringBillsAttempts; // number of failed attempts by recurring bill id.
     QList<Bill> m_recurringBills;
 };
 
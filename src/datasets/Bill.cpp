@@ -3,11 +3,15 @@
 // </copyright>
 
 #include "Bill.h"
+#include "JsonFields.h"
 
+#define BILL_ID "bill_id"
 #define BILL_NUMBER "bill_number"
 #define RECURRING_BILL_NUMBER "recurring_bill_id"
 #define PARTY "vendor_name"
 #define RECURRENCE_FREQUENCY "recurrence_frequency"
+#define REPEAT_EVERY "repeat_every"
+#define END_DATE "end_date"
 #define STATUS "status"
 #define DATE "date"
 #define DUE_DATE "due_date"
@@ -21,6 +25,11 @@ Bill::Bill()
 
 }
 
+QString Bill::billId() const
+{
+    return m_billId;
+}
+
 QString Bill::billNumber() const
 {
     return m_billNumber;
@@ -28,7 +37,7 @@ QString Bill::billNumber() const
 
 QString Bill::party() const
 {
-    return m_party;
+    return m_party.toString();
 }
 
 bool Bill::isRecurrent() const
@@ -38,32 +47,54 @@ bool Bill::isRecurrent() const
 
 QString Bill::status() const
 {
-    return m_status;
+    return m_status.toString();
 }
 
 QString Bill::recurrence_frequency() const
 {
-    return m_recurrence_frequency;
+    return m_recurrence_frequency.toString();
+}
+
+int Bill::repeatEvery() const
+{
+    return m_repeatEvery;
+}
+
+QDate Bill::endDate() const
+{
+    return m_endDate.toDate();
+}
+
+Recurrence Bill::recurrence() const
+{
+    Recurrence recurrence(m_nextBillDate.toDate(), m_recurrence_frequency.frequency(), m_repeatEvery);
+    recurrence.setEndDate(m_endDate.toDate());
+    return recurrence;
 }
 
 QDate Bill::date() const
 {
-    return m_date;
+    return m_date.toDate();
 }
 
 QDate Bill::dueDate() const
 {
-    return m_dueDate;
+    return m_dueDate.toDate();
 }
 
 QDate Bill::nextBillDate() const
 {
-    return m_nextBillDate;
+    return m_nextBillDate.toDate();
 }
 
 QString Bill::currencyCode() const
 {
-    return m_currencyCode;
+    return m_currencyCode.toString();
+}
+
+quint16 Bill::currencyId() const
+{
+    return m_currencyCode.code();
 }
 
 double Bill::total() const
@@ -84,6 +115,7 @@ void Bill::setPlnTotal(const double &amount)
 Bill Bill::parseNormalBill(const QVariantMap &map)
 {
     Bill bill;
+    bill.m_billId = map[BILL_ID].toString();
     bill.m_billNumber = map[BILL_NUMBER].toString();
     bill.m_party = map[PARTY].toString();
     bill.m_isRecurrent = false;
@@ -100,11 +132,14 @@ Bill Bill::parseNormalBill(const QVariantMap &map)
 Bill Bill::parseRecurringBill(const QVariantMap &map)
 {
     Bill bill;
+    bill.m_billId = map[RECURRING_BILL_NUMBER].toString();
     bill.m_billNumber = map[RECURRING_BILL_NUMBER].toString();
     bill.m_party = map[PARTY].toString();
     bill.m_isRecurrent = true;
     bill.m_status = map[STATUS].toString();
     bill.m_recurrence_frequency = map[RECURRENCE_FREQUENCY].toString();
+    bill.m_repeatEvery = qMax(1, map.value(REPEAT_EVERY, 1).toInt());
+    bill.m_endDate = map[END_DATE].toDate();
     bill.m_date = map[DATE].toDate();
     bill.m_dueDate = map[DUE_DATE].toDate();
     bill.m_nextBillDate = map[NEXT_BILL_DATE].toDate();
@@ -114,30 +149,109 @@ Bill Bill::parseRecurringBill(const QVariantMap &map)
     return bill;
 }
 
-Bill Bill::parseNormalBill(const QStringList &list)
+Bill Bill::parseNormalBill(const QJsonObject &object)
 {
     Bill bill;
-    bill.m_billNumber = list.at(0);
-    bill.m_party = list.at(1);
+    bill.m_billId = JsonFields::string(object, QLatin1String(BILL_ID));
+    bill.m_billNumber = JsonFields::string(object, QLatin1String(BILL_NUMBER));
+    bill.m_party = JsonFields::string(object, QLatin1String(PARTY));
     bill.m_isRecurrent = false;
-    bill.m_status = list.at(3);
-    bill.m_date = QDate::fromString(list.at(5), "d-M-yyyy");
-    bill.m_dueDate = QDate::fromString(list.at(6), "d-M-yyyy");
-    bill.m_total = list.at(8).toDouble();
-    bill.m_currencyCode = list.at(9);
+    bill.m_status = JsonFields::string(object, QLatin1String(STATUS));
+    bill.m_date = JsonFields::date(object, QLatin1String(DATE));
+    bill.m_dueDate = JsonFields::date(object, QLatin1String(DUE_DATE));
+    bill.m_nextBillDate = JsonFields::date(object, QLatin1String(NEXT_BILL_DATE));
+    bill.m_currencyCode = JsonFields::string(object, QLatin1String(CURRENCY_CODE));
+    bill.m_currencySymbol = JsonFields::string(object, QLatin1String(CURRENCY_SYMBOL));
+    bill.m_total = JsonFields::number(object, QLatin1String(TOTAL));
     return bill;
 }
 
-Bill Bill::parseRecurringBill(const QStringList &list)
+Bill Bill::parseRecurringBill(const QJsonObject &object)
 {
     Bill bill;
-    bill.m_billNumber = list.at(0);
-    bill.m_party = list.at(1);
+    bill.m_billId = JsonFields::string(object, QLatin1String(RECURRING_BILL_NUMBER));
+    bill.m_billNumber = bill.m_billId;
+    bill.m_party = JsonFields::string(object, QLatin1String(PARTY));
     bill.m_isRecurrent = true;
-    bill.m_status = list.at(3);
-    bill.m_recurrence_frequency = list.at(4);
-    bill.m_nextBillDate = QDate::fromString(list.at(7), "d-M-yyyy");
-    bill.m_total = list.at(8).toDouble();
-    bill.m_currencyCode = list.at(9);
+    bill.m_status = JsonFields::string(object, QLatin1String(STATUS));
+    bill.m_recurrence_frequency = JsonFields::string(object, QLatin1String(RECURRENCE_FREQUENCY));
+    bill.m_repeatEvery = qMax(1, int(JsonFields::number(object, QLatin1String(REPEAT_EVERY))));
+    bill.m_endDate = JsonFields::date(object, QLatin1String(END_DATE));
+    bill.m_date = JsonFields::date(object, QLatin1String(DATE));
+    bill.m_dueDate = JsonFields::date(object, QLatin1String(DUE_DATE));
+    bill.m_nextBillDate = JsonFields::date(object, QLatin1String(NEXT_BILL_DATE));
+    bill.m_currencyCode = JsonFields::string(object, QLatin1String(CURRENCY_CODE));
+    bill.m_currencySymbol = JsonFields::string(object, QLatin1String(CURRENCY_SYMBOL));
+    bill.m_total = JsonFields::number(object, QLatin1String(TOTAL));
     return bill;
 }
+
+Bill Bill::parseNormalBill(const CsvReader &row)
+{
+    Bill bill;
+    bill.m_billId = row.string(0); // local files have no separate id, number is unique.
+    bill.m_billNumber = bill.m_billId;
+    bill.m_party = row.string(1);
+    bill.m_isRecurrent = false;
+    bill.m_status = row.string(3);
+    bill.m_date = row.date(5);
+    bill.m_dueDate = row.date(6);
+    bill.m_total = row.number(8);
+    bill.m_currencyCode = row.string(9);
+    return bill;
+}
+
+Bill Bill::parseRecurringBill(const CsvReader &row)
+{
+    Bill bill;
+    bill.m_billId = row.string(0); // local files have no separate id, number is unique.
+    bill.m_billNumber = bill.m_billId;
+    bill.m_party = row.string(1);
+    bill.m_isRecurrent = true;
+    bill.m_status = row.string(3);
+    bill.m_recurrence_frequency = row.string(4);
+    bill.m_nextBillDate = row.date(7);
+    bill.m_total = row.number(8);
+    bill.m_currencyCode = row.string(9);
+    return bill;
+}
+
+QDataStream &operator<<(QDataStream &stream, const Bill &bill)
+{
+    stream << bill.m_billId
+           << bill.m_billNumber
+           << bill.m_party
+           << bill.m_isRecurrent
+           << bill.m_status
+           << bill.m_recurrence_frequency
+           << bill.m_repeatEvery
+           << bill.m_endDate
+           << bill.m_date
+           << bill.m_dueDate
+           << bill.m_nextBillDate
+           << bill.m_total
+           << bill.m_currencyCode
+           << bill.m_currencySymbol
+           << bill.m_plnTotal;
+    return stream;
+}
+
+QDataStream &operator>>(QDataStream &stream, Bill &bill)
+{
+    stream >> bill.m_billId
+           >> bill.m_billNumber
+           >> bill.m_party
+           >> bill.m_isRecurrent
+           >> bill.m_status
+           >> bill.m_recurrence_frequency
+           >> bill.m_repeatEvery
+           >> bill.m_endDate
+           >> bill.m_date
+           >> bill.m_dueDate
+           >> bill.m_nextBillDate
+           >> bill.m_total
+           >> bill.m_currencyCode
+           >> bill.m_currencySymbol
+           >> bill.m_plnTotal;
+    return stream;
+}
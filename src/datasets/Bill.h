@@ -7,6 +7,11 @@
 
 #include <QDate>
 #include <QVariant>
+#include <QJsonObject>
+#include <QDataStream>
+#include "CompactFields.h"
+#include "CsvReader.h"
+#include "Recurrence.h"
 
 /*!
  * \brief Class representing a bill entity.
@@ -20,6 +25,11 @@ public:
      */
     explicit Bill();
 
+    /*!
+     * \brief Returns a bill Id used by Zoho to identify the document.
+     */
+    QString billId() const;
+
     /*!
      * \brief Returns a bill number.
      */
@@ -45,6 +55,21 @@ public:
      */
     QString recurrence_frequency() const;
 
+    /*!
+     * \brief Returns number of frequency units between recurrences of the bill (i.e. 2 for every second month).
+     */
+    int repeatEvery() const;
+
+    /*!
+     * \brief Returns the date recurrences of the bill end at. Invalid date if they never end.
+     */
+    QDate endDate() const;
+
+    /*!
+     * \brief Returns rule of future recurrences of the bill, starting at the next bill date.
+     */
+    Recurrence recurrence() const;
+
     /*!
      * \brief Returns a date of the bill.
      */
@@ -70,6 +95,11 @@ public:
      */
     QString currencyCode() const;
 
+    /*!
+     * \brief Returns a code of the currency shared by all the documents paid in it, cheaper to compare than the currency code.
+     */
+    quint16 currencyId() const;
+
     /*!
      * \brief Returns a total amount of the bill in Polish Zlote.
      */
@@ -87,33 +117,66 @@ public:
      */
     static Bill parseNormalBill(const QVariantMap &map);
 
+    /*!
+     * \brief Deserializes QVariantMap to create a recurring bill.
+     * \param const QVariantMap &map -- a map describing a bill object.
+     */
     static Bill parseRecurringBill(const QVariantMap &map);
 
     /*!
-     * \brief Deserializes QStringList to create a normal (non-recurring) bill.
-     * \param const QStringList &list -- a list describing a bill objects.
+     * \brief Deserializes QJsonObject to create a normal (non-recurring) bill. Fields are read directly, without converting to QVariantMap.
+     * \param const QJsonObject &object -- an object describing a bill.
+     */
+    static Bill parseNormalBill(const QJsonObject &object);
+
+    /*!
+     * \brief Deserializes QJsonObject to create a recurring bill. Fields are read directly, without converting to QVariantMap.
+     * \param const QJsonObject &object -- an object describing a bill.
+     */
+    static Bill parseRecurringBill(const QJsonObject &object);
+
+    /*!
+     * \brief Deserializes the current row of a CSV file to create a normal bill. Columns follow the layout of the bundled CSV files.
+     * \param const CsvReader &row -- reader positioned at a row describing a bill.
      */
-    static Bill parseNormalBill(const QStringList &list);
+    static Bill parseNormalBill(const CsvReader &row);
 
     /*!
-     * \brief Deserializes QStringList to create a recurring bill.
-     * \param const QStringList &list -- a list describing a bill objects.
+     * \brief Deserializes the current row of a CSV file to create a recurring bill. Columns follow the layout of the bundled CSV files.
+     * \param const CsvReader &row -- reader positioned at a row describing a bill.
      */
-    static Bill parseRecurringBill(const QStringList &list);
+    static Bill parseRecurringBill(const CsvReader &row);
+
+    /*!
+     * \brief Serializes the bill to a binary stream.
+     * \param QDataStream &stream -- stream to write to.
+     * \param const Bill &bill -- bill to write.
+     */
+    friend QDataStream &operator<<(QDataStream &stream, const Bill &bill);
+
+    /*!
+     * \brief Deserializes the bill from a binary stream.
+     * \param QDataStream &stream -- stream to read from.
+     * \param Bill &bill -- bill to read into.
+     */
+    friend QDataStream &operator>>(QDataStream &stream, Bill &bill);
 
 private:
+    QString m_billId = "";
     QString m_billNumber = "";
-    QString m_party = "";
-    bool m_isRecurrent = false;
-    QString m_status = "";
-    QString m_recurrence_frequency = "";
-    QDate m_date = QDate();
-    QDate m_dueDate = QDate();
-    QDate m_nextBillDate = QDate();
+    InternedString m_party;
     double m_total = 0.0;
-    QString m_currencyCode = "";
-    QString m_currencySymbol = "";
     double m_plnTotal = 0.0;
+    int m_repeatEvery = 1;
+    CompactDate m_endDate;
+    CompactDate m_date;
+    CompactDate m_dueDate;
+    CompactDate m_nextBillDate;
+    CompactSymbol m_status;
+    CompactSymbol m_currencyCode;
+    CompactSymbol m_currencySymbol;
+    CompactFrequency m_recurrence_frequency;
+    bool m_isRecurrent = false;
 };
 
 #endif // BILL_H
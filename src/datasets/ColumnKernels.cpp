@@ -0,0 +1,80 @@
+// <copyright company="Scythe Studio Sp. z o.o.">
+//     This file contains proprietary code. Copyright (c) 2021. All rights reserved.
+// </copyright>
+
+#include "ColumnKernels.h"
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace ColumnKernels {
+
+void convert(const double *values, const quint16 *currencies, const double *rates, double *result, int count)
+{
+    int i = 0;
+#if defined(__SSE2__)
+    // there's no gather in SSE2, rates are loaded one by one and multiplied in pairs.
+    for (; i + 2 <= count; i += 2) {
+        const __m128d rate = _mm_set_pd(rates[currencies[i + 1]], rates[currencies[i]]);
+        _mm_storeu_pd(result + i, _mm_mul_pd(_mm_loadu_pd(values + i), rate));
+    }
+#endif
+    for (; i < count; ++i) {
+        result[i] = values[i] * rates[currencies[i]];
+    }
+}
+
+double sum(const double *values, int count)
+{
+    int i = 0;
+    double total = 0;
+#if defined(__SSE2__)
+    // two accumulators, so additions of consecutive pairs don't wait for each other.
+    __m128d first = _mm_setzero_pd();
+    __m128d second = _mm_setzero_pd();
+    for (; i + 4 <= count; i += 4) {
+        first = _mm_add_pd(first, _mm_loadu_pd(values + i));
+        second = _mm_add_pd(second, _mm_loadu_pd(values + i + 2));
+    }
+    double lanes[2];
+    _mm_storeu_pd(lanes, _mm_add_pd(first, second));
+    total = lanes[0] + lanes[1];
+#endif
+    for (; i < count; ++i) {
+        total += values[i];
+    }
+    return total;
+}
+
+double maskedSum(const double *values, const quint8 *flags, quint8 mask, quint8 value, int count)
+{
+    int i = 0;
+    double total = 0;
+#if defined(__SSE2__)
+    // flags of 4 values are compared at once, then every resulting byte is widened to a 64-bit lane masking a value.
+    const __m128i maskBytes = _mm_set1_epi8(char(mask));
+    const __m128i valueBytes = _mm_set1_epi8(char(value));
+    __m128d first = _mm_setzero_pd();
+    __m128d second = _mm_setzero_pd();
+    for (; i + 4 <= count; i += 4) {
+        qint32 packed;
+        std::memcpy(&packed, flags + i, sizeof(packed));
+        __m128i selected = _mm_cmpeq_epi8(_mm_and_si128(_mm_cvtsi32_si128(packed), maskBytes), valueBytes);
+        selected = _mm_unpacklo_epi8(selected, selected);
+        selected = _mm_unpacklo_epi16(selected, selected);
+        first = _mm_add_pd(first, _mm_and_pd(_mm_castsi128_pd(_mm_unpacklo_epi32(selected, selected)), _mm_loadu_pd(values + i)));
+        second = _mm_add_pd(second, _mm_and_pd(_mm_castsi128_pd(_mm_unpackhi_epi32(selected, selected)), _mm_loadu_pd(values + i + 2)));
+    }
+    double lanes[2];
+    _mm_storeu_pd(lanes, _mm_add_pd(first, second));
+    total = lanes[0] + lanes[1];
+#endif
+    for (; i < count; ++i) {
+        total += (flags[i] & mask) == value ? values[i] : 0.0;
+    }
+    return total;
+}
+
+} // namespace ColumnKernels
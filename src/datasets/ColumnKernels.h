@@ -0,0 +1,45 @@
+// <copyright company="Scythe Studio Sp. z o.o.">
+//     This file contains proprietary code. Copyright (c) 2021. All rights reserved.
+// </copyright>
+
+#ifndef COLUMNKERNELS_H
+#define COLUMNKERNELS_H
+
+#include <QtGlobal>
+
+/*!
+ * \brief Loops over whole columns of numbers. SSE2 is used when the build enables it, as on every x86-64 target,
+ * otherwise plain scalar loops.
+ */
+namespace ColumnKernels {
+
+/*!
+ * \brief Multiplies every value by the rate of its currency: result[i] = values[i] * rates[currencies[i]].
+ * \param const double *values -- amounts to convert.
+ * \param const quint16 *currencies -- ids of currencies of the amounts, positions in the rates.
+ * \param const double *rates -- rates by currency id, covering all the ids in currencies.
+ * \param double *result -- converted amounts. May be the same array as values.
+ * \param int count -- number of amounts.
+ */
+void convert(const double *values, const quint16 *currencies, const double *rates, double *result, int count);
+
+/*!
+ * \brief Returns sum of the values.
+ * \param const double *values -- values to sum up.
+ * \param int count -- number of values.
+ */
+double sum(const double *values, int count);
+
+/*!
+ * \brief Returns sum of the values having the flags selected by the mask set to the value: (flags[i] & mask) == value.
+ * \param const double *values -- values to sum up.
+ * \param const quint8 *flags -- flags of the values.
+ * \param quint8 mask -- flags to check.
+ * \param quint8 value -- expected value of the checked flags.
+ * \param int count -- number of values.
+ */
+double maskedSum(const double *values, const quint8 *flags, quint8 mask, quint8 value, int count);
+
+} // namespace ColumnKernels
+
+#endif // COLUMNKERNELS_H
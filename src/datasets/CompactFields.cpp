@@ -0,0 +1,226 @@
+// <copyright company="Scythe Studio Sp. z o.o.">
+//     This file contains proprietary code. Copyright (c) 2021. All rights reserved.
+// </copyright>
+
+#include "CompactFields.h"
+#include <QHash>
+#include <QReadWriteLock>
+#include <QSet>
+
+#define INVALID_JULIAN_DAY INT_MIN
+#define SYMBOLS_BLOCK_SIZE 256
+#define MAX_SYMBOLS_BLOCKS 256 // 65536 symbols, as many as fit into quint16.
+#define OVERFLOW_SYMBOL_CODE 0xffff // shared by all the texts that didn't fit, the last code is never given to a text.
+#define OVERFLOW_SYMBOL_TEXT "?"
+
+namespace {
+
+// Documents are parsed on many threads, lookups of known texts take only the read lock.
+// Symbols are kept in blocks that never move, so a text is read without any lock once its code is known.
+struct SymbolTable {
+    QReadWriteLock lock;
+    QHash<QString, quint16> codes;
+    QString *blocks[MAX_SYMBOLS_BLOCKS] = {};
+    int size = 0;
+    bool overflowed = false;
+};
+
+struct NamePool {
+    QReadWriteLock lock;
+    QSet<QString> names;
+};
+
+quint16 appendSymbol(SymbolTable &table, const QString &text)
+{
+    if (table.size == OVERFLOW_SYMBOL_CODE) {
+        // i.e. a misaligned column of an imported file. The import is reported as failed instead of storing a wrong text silently.
+        table.overflowed = true;
+        return OVERFLOW_SYMBOL_CODE;
+    }
+    const int block = table.size / SYMBOLS_BLOCK_SIZE;
+    if (!table.blocks[block]) {
+        table.blocks[block] = new QString[SYMBOLS_BLOCK_SIZE];
+    }
+    table.blocks[block][table.size % SYMBOLS_BLOCK_SIZE] = text;
+    table.codes.insert(text, quint16(table.size));
+    return quint16(table.size++);
+}
+
+SymbolTable &symbolTable()
+{
+    static SymbolTable *table = [] {
+        auto *newTable = new SymbolTable; // never deleted, documents may outlive static destructors.
+        appendSymbol(*newTable, QString()); // code 0 is the empty text.
+        return newTable;
+    }();
+    return *table;
+}
+
+NamePool &namePool()
+{
+    static NamePool *pool = new NamePool;
+    return *pool;
+}
+
+} // namespace
+
+CompactDate::CompactDate(const QDate &date)
+    : m_julianDay(date.isValid() ? qint32(date.toJulianDay()) : INVALID_JULIAN_DAY)
+{
+}
+
+QDate CompactDate::toDate() const
+{
+    return m_julianDay == INVALID_JULIAN_DAY ? QDate() : QDate::fromJulianDay(m_julianDay);
+}
+
+CompactSymbol::CompactSymbol(const QString &text)
+{
+    if (text.isEmpty()) {
+        return;
+    }
+
+    SymbolTable &table = symbolTable();
+    {
+        QReadLocker locker(&table.lock);
+        const auto code = table.codes.constFind(text);
+        if (code != table.codes.constEnd()) {
+            m_code = code.value();
+            return;
+        }
+    }
+
+    QWriteLocker locker(&table.lock);
+    const auto code = table.codes.constFind(text); // might have been added in the meantime.
+    m_code = code != table.codes.constEnd() ? code.value() : appendSymbol(table, text);
+}
+
+QString CompactSymbol::toString() const
+{
+    if (m_code == OVERFLOW_SYMBOL_CODE) {
+        return QStringLiteral(OVERFLOW_SYMBOL_TEXT);
+    }
+    return symbolTable().blocks[m_code / SYMBOLS_BLOCK_SIZE][m_code % SYMBOLS_BLOCK_SIZE];
+}
+
+quint16 CompactSymbol::code() const
+{
+    return m_code;
+}
+
+bool CompactSymbol::hasOverflowed()
+{
+    SymbolTable &table = symbolTable();
+    QReadLocker locker(&table.lock);
+    return table.overflowed;
+}
+
+CompactFrequency::CompactFrequency(const QString &text)
+    : m_frequency(quint8(Recurrence::frequencyFromString(text)))
+{
+    if (m_frequency == Recurrence::NoFrequency) {
+        m_unknownText = text; // displayed as it came.
+    }
+}
+
+Recurrence::Frequency CompactFrequency::frequency() const
+{
+    return static_cast<Recurrence::Frequency>(m_frequency);
+}
+
+QString CompactFrequency::toString() const
+{
+    return m_frequency == Recurrence::NoFrequency ? m_unknownText.toString() : Recurrence::frequencyToString(frequency());
+}
+
+InternedString::InternedString(const QString &text)
+{
+    if (text.isEmpty()) {
+        return;
+    }
+
+    NamePool &pool = namePool();
+    {
+        QReadLocker locker(&pool.lock);
+        const auto name = pool.names.constFind(text);
+        if (name != pool.names.constEnd()) {
+            m_text = *name;
+            return;
+        }
+    }
+
+    QWriteLocker locker(&pool.lock);
+    m_text = *pool.names.insert(text); // returns the existing name if it has been added in the meantime.
+}
+
+const QString &InternedString::toString() const
+{
+    return m_text;
+}
+
+void InternedString::releaseUnused()
+{
+    // a name is shared by the pool and every InternedString storing it, so a name referenced only by the pool is unused.
+    // New references are only taken under the lock, so a name cannot start being used while it's being removed.
+    NamePool &pool = namePool();
+    QWriteLocker locker(&pool.lock);
+    for (auto name = pool.names.begin(); name != pool.names.end();) {
+        if (name->isDetached()) {
+            name = pool.names.erase(name);
+        } else {
+            ++name;
+        }
+    }
+}
+
+QDataStream &operator<<(QDataStream &stream, const CompactDate &date)
+{
+    return stream << date.toDate();
+}
+
+QDataStream &operator>>(QDataStream &stream, CompactDate &date)
+{
+    QDate value;
+    stream >> value;
+    date = value;
+    return stream;
+}
+
+QDataStream &operator<<(QDataStream &stream, const CompactSymbol &symbol)
+{
+    return stream << symbol.toString();
+}
+
+QDataStream &operator>>(QDataStream &stream, CompactSymbol &symbol)
+{
+    QString value;
+    stream >> value;
+    symbol = value;
+    return stream;
+}
+
+QDataStream &operator<<(QDataStream &stream, const CompactFrequency &frequency)
+{
+    return stream << frequency.toString();
+}
+
+QDataStream &operator>>(QDataStream &stream, CompactFrequency &frequency)
+{
+    QString value;
+    stream >> value;
+    frequency = value;
+    return stream;
+}
+
+QDataStream &operator<<(QDataStream &stream, const InternedString &text)
+{
+    return stream << text.toString();
+}
+
+QDataStream &operator>>(QDataStream &stream, InternedString &text)
+{
+    QString value;
+    stream >> value;
+    text = value;
+    return stream;
+}
@@ -0,0 +1,157 @@
+// <copyright company="Scythe Studio Sp. z o.o.">
+//     This file contains proprietary code. Copyright (c) 2021. All rights reserved.
+// </copyright>
+
+#ifndef COMPACTFIELDS_H
+#define COMPACTFIELDS_H
+
+#include <QDataStream>
+#include <QDate>
+#include <QString>
+#include <climits>
+#include "Recurrence.h"
+
+// Compact replacements of fields repeated across millions of documents. They are assigned from and serialized as
+// the types they replace, so parsing and the snapshot format don't change.
+// Documents declare their members from the largest alignment to the smallest one, so no padding is left between them.
+
+/*!
+ * \brief Date stored as a 4-byte Julian day instead of 8 bytes of QDate.
+ */
+class CompactDate
+{
+public:
+
+    /*!
+     * \brief Constructor of an invalid date.
+     */
+    CompactDate() = default;
+
+    /*!
+     * \brief Constructor.
+     * \param const QDate &date -- date to store.
+     */
+    CompactDate(const QDate &date);
+
+    /*!
+     * \brief Returns the stored date.
+     */
+    QDate toDate() const;
+
+private:
+    qint32 m_julianDay = INT_MIN; // invalid date.
+};
+
+/*!
+ * \brief Short text repeated across documents, i.e. a status or a currency code, stored as a 2-byte code.
+ * Every distinct text is kept once for the whole application, so reading it doesn't allocate.
+ */
+class CompactSymbol
+{
+public:
+
+    /*!
+     * \brief Constructor of an empty text.
+     */
+    CompactSymbol() = default;
+
+    /*!
+     * \brief Constructor. If there are already 65535 distinct texts, a new text is stored as "?" and hasOverflowed() turns true.
+     * \param const QString &text -- text to store.
+     */
+    CompactSymbol(const QString &text);
+
+    /*!
+     * \brief Returns the stored text.
+     */
+    QString toString() const;
+
+    /*!
+     * \brief Returns the code of the stored text. Equal texts have equal codes during the whole run of the application.
+     */
+    quint16 code() const;
+
+    /*!
+     * \brief Returns true if any text couldn't be stored since the start of the application. Documents having such texts are wrong.
+     */
+    static bool hasOverflowed();
+
+private:
+    quint16 m_code = 0; // empty text.
+};
+
+/*!
+ * \brief Recurrence frequency stored as a single byte.
+ */
+class CompactFrequency
+{
+public:
+
+    /*!
+     * \brief Constructor of no frequency.
+     */
+    CompactFrequency() = default;
+
+    /*!
+     * \brief Constructor.
+     * \param const QString &text -- Zoho recurrence frequency ("days", "weeks", "months" or "years").
+     */
+    CompactFrequency(const QString &text);
+
+    /*!
+     * \brief Returns the stored frequency. NoFrequency for texts other than the known ones.
+     */
+    Recurrence::Frequency frequency() const;
+
+    /*!
+     * \brief Returns the stored frequency as Zoho names it, or the stored text if it's not a known frequency.
+     */
+    QString toString() const;
+
+private:
+    quint8 m_frequency = Recurrence::NoFrequency;
+    CompactSymbol m_unknownText; // set only for texts other than the known frequencies.
+};
+
+/*!
+ * \brief Name repeated across documents, i.e. a party or a category. Equal names share a single buffer.
+ */
+class InternedString
+{
+public:
+
+    /*!
+     * \brief Constructor of an empty name.
+     */
+    InternedString() = default;
+
+    /*!
+     * \brief Constructor.
+     * \param const QString &text -- name to store.
+     */
+    InternedString(const QString &text);
+
+    /*!
+     * \brief Returns the stored name.
+     */
+    const QString &toString() const;
+
+    /*!
+     * \brief Forgets names not stored by any InternedString anymore, i.e. after documents have been removed.
+     */
+    static void releaseUnused();
+
+private:
+    QString m_text;
+};
+
+QDataStream &operator<<(QDataStream &stream, const CompactDate &date);
+QDataStream &operator>>(QDataStream &stream, CompactDate &date);
+QDataStream &operator<<(QDataStream &stream, const CompactSymbol &symbol);
+QDataStream &operator>>(QDataStream &stream, CompactSymbol &symbol);
+QDataStream &operator<<(QDataStream &stream, const CompactFrequency &frequency);
+QDataStream &operator>>(QDataStream &stream, CompactFrequency &frequency);
+QDataStream &operator<<(QDataStream &stream, const InternedString &text);
+QDataStream &operator>>(QDataStream &stream, InternedString &text);
+
+#endif // COMPACTFIELDS_H
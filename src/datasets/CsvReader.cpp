@@ -0,0 +1,266 @@
+// <copyright company="Scythe Studio Sp. z o.o.">
+//     This file contains proprietary code. Copyright (c) 2021. All rights reserved.
+// </copyright>
+
+#include "CsvReader.h"
+
+#define DATE_FORMAT "d-M-yyyy"
+#define UTF8_BOM "\xEF\xBB\xBF"
+#define MIN_PART_SIZE 65536 // bytes, smaller parts are not worth a thread.
+#define MAX_EXACT_POWER_OF_TEN 22 // 10^22 is the biggest power of ten represented exactly by double.
+#define MAX_DATE_PART_DIGITS 9 // any 9 digits fit into int.
+
+namespace {
+
+bool isDigit(char character)
+{
+    return character >= '0' && character <= '9';
+}
+
+// reads digits of a date part, returns -1 if there are none or too many of them.
+int readNumber(const char *&position, const char *end)
+{
+    if (position == end || !isDigit(*position)) {
+        return -1;
+    }
+    int value = 0;
+    for (int digits = 0; position != end && isDigit(*position); ++digits, ++position) {
+        if (digits == MAX_DATE_PART_DIGITS) {
+            return -1;
+        }
+        value = value * 10 + (*position - '0');
+    }
+    return value;
+}
+
+} // namespace
+
+CsvReader::CsvReader(const QString &fileName)
+    : m_file(new QFile(fileName))
+{
+}
+
+bool CsvReader::open()
+{
+    if (!m_file->open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    const qint64 size = m_file->size();
+    const uchar *mapped = size > 0 ? m_file->map(0, size) : nullptr;
+    if (mapped) {
+        m_position = reinterpret_cast<const char *>(mapped);
+        m_end = m_position + size;
+    } else {
+        m_buffer = m_file->readAll();
+        m_position = m_buffer.constData();
+        m_end = m_position + m_buffer.size();
+    }
+
+    const int bomLength = int(qstrlen(UTF8_BOM));
+    if (m_end - m_position >= bomLength && qstrncmp(m_position, UTF8_BOM, uint(bomLength)) == 0) {
+        m_position += bomLength;
+    }
+    return true;
+}
+
+QVector<CsvReader> CsvReader::split(int count) const
+{
+    const qint64 size = m_end - m_position;
+    count = int(qBound<qint64>(1, count, size / MIN_PART_SIZE + 1));
+
+    QVector<CsvReader> parts;
+    parts.reserve(count);
+    const char *begin = m_position;
+    const char *position = m_position;
+    // newlines inside quoted fields don't end rows, so quotes are tracked from the beginning. It's a lot cheaper than parsing.
+    bool quoted = false;
+    for (int part = 1; part < count; ++part) {
+        const char *target = m_position + size * part / count;
+        while (position != m_end && (position < target || quoted || *position != '\n')) {
+            if (*position == '"') {
+                quoted = !quoted;
+            }
+            ++position;
+        }
+        if (position == m_end) {
+            break;
+        }
+        ++position;
+
+        CsvReader reader(*this);
+        reader.m_position = begin;
+        reader.m_end = position;
+        reader.m_fields.clear();
+        parts << reader;
+        begin = position;
+    }
+
+    CsvReader reader(*this);
+    reader.m_position = begin;
+    reader.m_fields.clear();
+    parts << reader;
+    return parts;
+}
+
+bool CsvReader::readRow()
+{
+    m_fields.clear();
+
+    // blank lines, i.e. the one after the trailing newline, are skipped.
+    while (m_position != m_end && (*m_position == '\n' || *m_position == '\r')) {
+        ++m_position;
+    }
+    if (m_position == m_end) {
+        return false;
+    }
+
+    while (true) {
+        Field field = {m_position, m_position, false};
+        if (m_position != m_end && *m_position == '"') {
+            // quoted field runs to the closing quote, it may contain separators, newlines and doubled quotes.
+            field.begin = ++m_position;
+            while (m_position != m_end) {
+                if (*m_position == '"') {
+                    if (m_position + 1 != m_end && m_position[1] == '"') {
+                        field.hasEscapedQuotes = true;
+                        m_position += 2;
+                        continue;
+                    }
+                    break;
+                }
+                ++m_position;
+            }
+            field.end = m_position;
+            // anything between the closing quote and the separator is ignored.
+            while (m_position != m_end && *m_position != ',' && *m_position != '\n' && *m_position != '\r') {
+                ++m_position;
+            }
+        } else {
+            while (m_position != m_end && *m_position != ',' && *m_position != '\n' && *m_position != '\r') {
+                ++m_position;
+            }
+            field.end = m_position;
+        }
+        m_fields << field;
+
+        if (m_position == m_end || *m_position != ',') {
+            break;
+        }
+        ++m_position;
+    }
+
+    if (m_position != m_end && *m_position == '\r') {
+        ++m_position;
+    }
+    if (m_position != m_end && *m_position == '\n') {
+        ++m_position;
+    }
+    return true;
+}
+
+int CsvReader::fieldCount() const
+{
+    return m_fields.size();
+}
+
+QString CsvReader::string(int index) const
+{
+    if (index < 0 || index >= m_fields.size()) {
+        return QString();
+    }
+
+    const Field &field = m_fields.at(index);
+    if (!field.hasEscapedQuotes) {
+        return QString::fromUtf8(field.begin, int(field.end - field.begin));
+    }
+
+    QByteArray unescaped;
+    unescaped.reserve(int(field.end - field.begin));
+    for (const char *position = field.begin; position != field.end; ++position) {
+        unescaped += *position;
+        if (*position == '"') {
+            ++position; // the second quote of a pair.
+        }
+    }
+    return QString::fromUtf8(unescaped);
+}
+
+double CsvReader::number(int index) const
+{
+    if (isEmpty(index)) {
+        return 0;
+    }
+
+    const Field &field = m_fields.at(index);
+    const char *position = field.begin;
+    while (position != field.end && *position == ' ') {
+        ++position;
+    }
+
+    const bool negative = position != field.end && *position == '-';
+    if (position != field.end && (*position == '-' || *position == '+')) {
+        ++position;
+    }
+
+    // amounts have a few decimal digits, so the mantissa fits in 53 bits and dividing by an exact power of ten rounds correctly.
+    quint64 mantissa = 0;
+    int digits = 0;
+    int decimals = 0;
+    bool fraction = false;
+    for (; position != field.end; ++position) {
+        if (isDigit(*position)) {
+            mantissa = mantissa * 10 + quint64(*position - '0');
+            ++digits;
+            if (fraction) {
+                ++decimals;
+            }
+        } else if (*position == '.' && !fraction) {
+            fraction = true;
+        } else {
+            break;
+        }
+    }
+
+    if (position != field.end || digits > 15 || decimals > MAX_EXACT_POWER_OF_TEN) {
+        // exponents, thousand separators and long numbers go through the generic conversion.
+        return string(index).trimmed().toDouble();
+    }
+
+    double value = double(mantissa);
+    double divisor = 1;
+    for (int i = 0; i < decimals; ++i) {
+        divisor *= 10;
+    }
+    value /= divisor;
+    return negative ? -value : value;
+}
+
+QDate CsvReader::date(int index) const
+{
+    if (isEmpty(index)) {
+        return QDate();
+    }
+
+    const Field &field = m_fields.at(index);
+    const char *position = field.begin;
+    const int day = readNumber(position, field.end);
+    if (position != field.end && *position == '-') {
+        ++position;
+        const int month = readNumber(position, field.end);
+        if (position != field.end && *position == '-') {
+            ++position;
+            const int year = readNumber(position, field.end);
+            if (position == field.end && day > 0 && month > 0 && year > 0) {
+                return QDate(year, month, day);
+            }
+        }
+    }
+
+    return QDate::fromString(string(index).trimmed(), DATE_FORMAT);
+}
+
+bool CsvReader::isEmpty(int index) const
+{
+    return index < 0 || index >= m_fields.size() || m_fields.at(index).begin == m_fields.at(index).end;
+}
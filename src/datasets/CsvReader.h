@@ -0,0 +1,91 @@
+// <copyright company="Scythe Studio Sp. z o.o.">
+//     This file contains proprietary code. Copyright (c) 2021. All rights reserved.
+// </copyright>
+
+#ifndef CSVREADER_H
+#define CSVREADER_H
+
+#include <QByteArray>
+#include <QDate>
+#include <QFile>
+#include <QSharedPointer>
+#include <QString>
+#include <QVector>
+
+/*!
+ * \brief Class reading CSV files row by row. The file is memory-mapped when possible and rows are tokenized in place,
+ * following RFC 4180 quoting, so no line or list of fields is allocated. Fields are converted only when read.
+ * Copies share the file, so rows can be split into parts read on different threads.
+ */
+class CsvReader
+{
+public:
+
+    /*!
+     * \brief Constructor.
+     * \param const QString &fileName -- path to the file, resources are supported as well.
+     */
+    explicit CsvReader(const QString &fileName);
+
+    /*!
+     * \brief Opens the file. Returns false if it cannot be read.
+     */
+    bool open();
+
+    /*!
+     * \brief Splits the rows not read yet into parts of similar size, each of them ending at a row boundary.
+     * Every part is a separate reader, so they can be read in parallel. Small files are not split.
+     * \param int count -- maximal number of parts.
+     */
+    QVector<CsvReader> split(int count) const;
+
+    /*!
+     * \brief Moves to the next non-empty row. Returns false if there are no more rows.
+     */
+    bool readRow();
+
+    /*!
+     * \brief Returns number of fields in the current row.
+     */
+    int fieldCount() const;
+
+    /*!
+     * \brief Returns a text field, quotes are removed. Empty string is returned for missing fields.
+     * \param int index -- index of the field in the current row.
+     */
+    QString string(int index) const;
+
+    /*!
+     * \brief Returns a number field, read straight from the bytes of the file. 0 is returned for missing fields.
+     * \param int index -- index of the field in the current row.
+     */
+    double number(int index) const;
+
+    /*!
+     * \brief Returns a date field in d-M-yyyy format. Invalid date is returned for missing or empty fields.
+     * \param int index -- index of the field in the current row.
+     */
+    QDate date(int index) const;
+
+    /*!
+     * \brief Returns true if the field is missing or empty.
+     * \param int index -- index of the field in the current row.
+     */
+    bool isEmpty(int index) const;
+
+private:
+    // field of the current row, pointing into the file. Quotes enclosing the field are already skipped.
+    struct Field {
+        const char *begin;
+        const char *end;
+        bool hasEscapedQuotes;
+    };
+
+    QSharedPointer<QFile> m_file; // the mapping lives as long as the file, so all the parts keep it open.
+    QByteArray m_buffer; // contents of files that cannot be mapped, i.e. compressed resources.
+    const char *m_position = nullptr;
+    const char *m_end = nullptr;
+    QVector<Field> m_fields;
+};
+
+#endif // CSVREADER_H
@@ -0,0 +1,102 @@
+// <copyright company="Scythe Studio Sp. z o.o.">
+//     This file contains proprietary code. Copyright (c) 2021. All rights reserved.
+// </copyright>
+
+#ifndef DOCUMENTRANGE_H
+#define DOCUMENTRANGE_H
+
+#include <QList>
+
+/*!
+ * \brief Class representing a read-only view of consecutive documents of a list sorted by date.
+ * No documents are copied. The view is valid as long as the list it's been created for is not modified.
+ */
+template <typename T>
+class DocumentRange
+{
+public:
+    using const_iterator = typename QList<T>::const_iterator;
+
+    /*!
+     * \brief Constructor of an empty range.
+     */
+    DocumentRange() = default;
+
+    /*!
+     * \brief Constructor.
+     * \param const QList<T> *documents -- list the range refers to.
+     * \param int first -- position of the first document in the range.
+     * \param int last -- position right after the last document in the range.
+     */
+    DocumentRange(const QList<T> *documents, int first, int last)
+        : m_documents(documents)
+        , m_first(first)
+        , m_last(last)
+    {
+    }
+
+    /*!
+     * \brief Returns number of documents in the range.
+     */
+    int size() const
+    {
+        return m_last - m_first;
+    }
+
+    /*!
+     * \brief Returns number of documents in the range.
+     */
+    int count() const
+    {
+        return size();
+    }
+
+    /*!
+     * \brief Returns true if there are no documents in the range. Otherwise false.
+     */
+    bool isEmpty() const
+    {
+        return m_first == m_last;
+    }
+
+    /*!
+     * \brief Returns the document at the given position of the range.
+     * \param int i -- position in the range.
+     */
+    const T &at(int i) const
+    {
+        Q_ASSERT(0 <= i && i < size());
+        return m_documents->at(m_first + i);
+    }
+
+    /*!
+     * \brief Returns position of the first document of the range in the whole list.
+     */
+    int offset() const
+    {
+        return m_first;
+    }
+
+    /*!
+     * \brief Returns an iterator pointing to the first document of the range.
+     */
+    const_iterator begin() const
+    {
+        return m_documents ? m_documents->constBegin() + m_first : const_iterator();
+    }
+
+    /*!
+     * \brief Returns an iterator pointing right after the last document of the range.
+     */
+    const_iterator end() const
+    {
+        return m_documents ? m_documents->constBegin() + m_last : const_iterator();
+    }
+
+private:
+    const QList<T> *m_documents = nullptr;
+    int m_first = 0;
+    int m_last = 0;
+};
+
+#endif // DOCUMENTRANGE_H
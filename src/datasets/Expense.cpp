@@ -3,6 +3,7 @@
 // </copyright>
 
 #include "Expense.h"
+#include "JsonFields.h"
 #include <QDebug>
 
 #define EXPENSE_ID "expense_id"
@@ -11,6 +12,8 @@
 #define CATEGORY "account_name"
 #define PARTY_NAME "vendor_name"
 #define RECURRENCE_FREQUENCY "recurrence_frequency"
+#define REPEAT_EVERY "repeat_every"
+#define END_DATE "end_date"
 #define DATE "date"
 #define NEXT_EXPENSE_DATE "next_expense_date"
 #define CURRENCY_CODE "currency_code"
@@ -28,17 +31,17 @@ QString Expense::expenseId() const
 
 QString Expense::status() const
 {
-    return m_status;
+    return m_status.toString();
 }
 
 QString Expense::category() const
 {
-    return m_category;
+    return m_category.toString();
 }
 
 QString Expense::partyName() const
 {
-    return m_partyName;
+    return m_partyName.toString();
 }
 
 bool Expense::isRecurrent() const
@@ -48,22 +51,44 @@ bool Expense::isRecurrent() const
 
 QString Expense::recurrenceFrequency() const
 {
-    return m_recurrenceFrequency;
+    return m_recurrenceFrequency.toString();
+}
+
+int Expense::repeatEvery() const
+{
+    return m_repeatEvery;
+}
+
+QDate Expense::endDate() const
+{
+    return m_endDate.toDate();
+}
+
+Recurrence Expense::recurrence() const
+{
+    Recurrence recurrence(m_nextExpenseDate.toDate(), m_recurrenceFrequency.frequency(), m_repeatEvery);
+    recurrence.setEndDate(m_endDate.toDate());
+    return recurrence;
 }
 
 QDate Expense::date() const
 {
-    return m_date;
+    return m_date.toDate();
 }
 
 QDate Expense::nextExpenseDate() const
 {
-    return m_nextExpenseDate;
+    return m_nextExpenseDate.toDate();
 }
 
 QString Expense::currencyCode() const
 {
-    return m_currencyCode;
+    return m_currencyCode.toString();
+}
+
+quint16 Expense::currencyId() const
+{
+    return m_currencyCode.code();
 }
 
 double Expense::total() const
@@ -99,12 +124,14 @@ Expense Expense::parseNormalExpense(const QVariantMap &map)
 Expense Expense::parseRecurrentExpense(const QVariantMap &map)
 {
     Expense expense;
-    expense.m_expenseId = map[EXPENSE_ID].toString();
+    expense.m_expenseId = map[RECURRING_EXPENSE_ID].toString();
     expense.m_status = map[STATUS].toString();
     expense.m_category = map[CATEGORY].toString();
     expense.m_partyName = map[PARTY_NAME].toString();
     expense.m_isRecurrent = true;
     expense.m_recurrenceFrequency = map[RECURRENCE_FREQUENCY].toString();
+    expense.m_repeatEvery = qMax(1, map.value(REPEAT_EVERY, 1).toInt());
+    expense.m_endDate = map[END_DATE].toDate();
     expense.m_date = map[DATE].toDate();
     expense.m_nextExpenseDate = map[NEXT_EXPENSE_DATE].toDate();
     expense.m_currencyCode = map[CURRENCY_CODE].toString();
@@ -112,31 +139,100 @@ Expense Expense::parseRecurrentExpense(const QVariantMap &map)
     return expense;
 }
 
-Expense Expense::parseNormalExpense(const QStringList &list)
+Expense Expense::parseNormalExpense(const QJsonObject &object)
 {
     Expense expense;
-    expense.m_expenseId = list.at(0);
-    expense.m_status = list.at(1);
-    expense.m_category = list.at(2);
-    expense.m_partyName = list.at(3);
+    expense.m_expenseId = JsonFields::string(object, QLatin1String(EXPENSE_ID));
+    expense.m_status = JsonFields::string(object, QLatin1String(STATUS));
+    expense.m_category = JsonFields::string(object, QLatin1String(CATEGORY));
+    expense.m_partyName = JsonFields::string(object, QLatin1String(PARTY_NAME));
     expense.m_isRecurrent = false;
-    expense.m_date = QDate::fromString(list.at(6), "d-M-yyyy");
-    expense.m_total = list.at(8).toDouble();
-    expense.m_currencyCode = list.at(9);
+    expense.m_date = JsonFields::date(object, QLatin1String(DATE));
+    expense.m_nextExpenseDate = JsonFields::date(object, QLatin1String(NEXT_EXPENSE_DATE));
+    expense.m_currencyCode = JsonFields::string(object, QLatin1String(CURRENCY_CODE));
+    expense.m_total = JsonFields::number(object, QLatin1String(TOTAL));
     return expense;
 }
 
-Expense Expense::parseRecurrentExpense(const QStringList &list)
+Expense Expense::parseRecurrentExpense(const QJsonObject &object)
 {
     Expense expense;
-    expense.m_expenseId = list.at(0);
-    expense.m_status = list.at(1);
-    expense.m_category = list.at(2);
-    expense.m_partyName = list.at(3);
+    expense.m_expenseId = JsonFields::string(object, QLatin1String(RECURRING_EXPENSE_ID));
+    expense.m_status = JsonFields::string(object, QLatin1String(STATUS));
+    expense.m_category = JsonFields::string(object, QLatin1String(CATEGORY));
+    expense.m_partyName = JsonFields::string(object, QLatin1String(PARTY_NAME));
     expense.m_isRecurrent = true;
-    expense.m_recurrenceFrequency = list.at(5);
-    expense.m_nextExpenseDate = QDate::fromString(list.at(7), "d-M-yyyy");
-    expense.m_total = list.at(8).toDouble();
-    expense.m_currencyCode = list.at(9);
+    expense.m_recurrenceFrequency = JsonFields::string(object, QLatin1String(RECURRENCE_FREQUENCY));
+    expense.m_repeatEvery = qMax(1, int(JsonFields::number(object, QLatin1String(REPEAT_EVERY))));
+    expense.m_endDate = JsonFields::date(object, QLatin1String(END_DATE));
+    expense.m_date = JsonFields::date(object, QLatin1String(DATE));
+    expense.m_nextExpenseDate = JsonFields::date(object, QLatin1String(NEXT_EXPENSE_DATE));
+    expense.m_currencyCode = JsonFields::string(object, QLatin1String(CURRENCY_CODE));
+    expense.m_total = JsonFields::number(object, QLatin1String(TOTAL));
     return expense;
 }
+
+Expense Expense::parseNormalExpense(const CsvReader &row)
+{
+    Expense expense;
+    expense.m_expenseId = row.string(0);
+    expense.m_status = row.string(1);
+    expense.m_category = row.string(2);
+    expense.m_partyName = row.string(3);
+    expense.m_isRecurrent = false;
+    expense.m_date = row.date(6);
+    expense.m_total = row.number(8);
+    expense.m_currencyCode = row.string(9);
+    return expense;
+}
+
+Expense Expense::parseRecurrentExpense(const CsvReader &row)
+{
+    Expense expense;
+    expense.m_expenseId = row.string(0);
+    expense.m_status = row.string(1);
+    expense.m_category = row.string(2);
+    expense.m_partyName = row.string(3);
+    expense.m_isRecurrent = true;
+    expense.m_recurrenceFrequency = row.string(5);
+    expense.m_nextExpenseDate = row.date(7);
+    expense.m_total = row.number(8);
+    expense.m_currencyCode = row.string(9);
+    return expense;
+}
+
+QDataStream &operator<<(QDataStream &stream, const Expense &expense)
+{
+    stream << expense.m_expenseId
+           << expense.m_status
+           << expense.m_category
+           << expense.m_partyName
+           << expense.m_isRecurrent
+           << expense.m_recurrenceFrequency
+           << expense.m_repeatEvery
+           << expense.m_endDate
+           << expense.m_date
+           << expense.m_nextExpenseDate
+           << expense.m_currencyCode
+           << expense.m_total
+           << expense.m_plnTotal;
+    return stream;
+}
+
+QDataStream &operator>>(QDataStream &stream, Expense &expense)
+{
+    stream >> expense.m_expenseId
+           >> expense.m_status
+           >> expense.m_category
+           >> expense.m_partyName
+           >> expense.m_isRecurrent
+           >> expense.m_recurrenceFrequency
+           >> expense.m_repeatEvery
+           >> expense.m_endDate
+           >> expense.m_date
+           >> expense.m_nextExpenseDate
+           >> expense.m_currencyCode
+           >> expense.m_total
+           >> expense.m_plnTotal;
+    return stream;
+}
@@ -7,6 +7,11 @@
 
 #include <QDate>
 #include <QVariant>
+#include <QJsonObject>
+#include <QDataStream>
+#include "CompactFields.h"
+#include "CsvReader.h"
+#include "Recurrence.h"
 
 /*!
  * \brief Class representing an expense entity.
@@ -50,6 +55,21 @@ public:
      */
     QString recurrenceFrequency() const;
 
+    /*!
+     * \brief Returns number of frequency units between recurrences of the expense (i.e. 2 for every second month).
+     */
+    int repeatEvery() const;
+
+    /*!
+     * \brief Returns the date recurrences of the expense end at. Invalid date if they never end.
+     */
+    QDate endDate() const;
+
+    /*!
+     * \brief Returns rule of future recurrences of the expense, starting at the next expense date.
+     */
+    Recurrence recurrence() const;
+
     /*!
      * \brief Returns a date of the expense.
      */
@@ -65,6 +85,11 @@ public:
      */
     QString currencyCode() const;
 
+    /*!
+     * \brief Returns a code of the currency shared by all the documents paid in it, cheaper to compare than the currency code.
+     */
+    quint16 currencyId() const;
+
     /*!
      * \brief Returns a total amount of the bill (no conversion performed).
      */
@@ -94,29 +119,57 @@ public:
     static Expense parseRecurrentExpense(const QVariantMap &map);
 
     /*!
-     * \brief Deserializes QStringList to create a normal (non-recurrent) expense.
-     * \param const QStringList &list -- a list describing an expense objects.
+     * \brief Deserializes QJsonObject to create a normal (non-recurrent) expense. Fields are read directly, without converting to QVariantMap.
+     * \param const QJsonObject &object -- an object describing an expense.
+     */
+    static Expense parseNormalExpense(const QJsonObject &object);
+
+    /*!
+     * \brief Deserializes QJsonObject to create a recurrent expense. Fields are read directly, without converting to QVariantMap.
+     * \param const QJsonObject &object -- an object describing an expense.
      */
-    static Expense parseNormalExpense(const QStringList &list);
+    static Expense parseRecurrentExpense(const QJsonObject &object);
 
     /*!
-     * \brief Deserializes QStringList to create a recurrent expense.
-     * \param const QStringList &list -- a list describing an expense objects.
+     * \brief Deserializes the current row of a CSV file to create a normal expense. Columns follow the layout of the bundled CSV files.
+     * \param const CsvReader &row -- reader positioned at a row describing an expense.
      */
-    static Expense parseRecurrentExpense(const QStringList &list);
+    static Expense parseNormalExpense(const CsvReader &row);
+
+    /*!
+     * \brief Deserializes the current row of a CSV file to create a recurrent expense. Columns follow the layout of the bundled CSV files.
+     * \param const CsvReader &row -- reader positioned at a row describing an expense.
+     */
+    static Expense parseRecurrentExpense(const CsvReader &row);
+
+    /*!
+     * \brief Serializes the expense to a binary stream.
+     * \param QDataStream &stream -- stream to write to.
+     * \param const Expense &expense -- expense to write.
+     */
+    friend QDataStream &operator<<(QDataStream &stream, const Expense &expense);
+
+    /*!
+     * \brief Deserializes the expense from a binary stream.
+     * \param QDataStream &stream -- stream to read from.
+     * \param Expense &expense -- expense to read into.
+     */
+    friend QDataStream &operator>>(QDataStream &stream, Expense &expense);
 
 private:
     QString m_expenseId = "";
-    QString m_status = "";
-    QString m_category = "";
-    QString m_partyName = "";
-    bool m_isRecurrent = false;
-    QString m_recurrenceFrequency = "";
-    QDate m_date = QDate();
-    QDate m_nextExpenseDate = QDate();
-    QString m_currencyCode = "";
+    InternedString m_category;
+    InternedString m_partyName;
     double m_total = 0.0;
     double m_plnTotal = 0.0;
+    int m_repeatEvery = 1;
+    CompactDate m_endDate;
+    CompactDate m_date;
+    CompactDate m_nextExpenseDate;
+    CompactSymbol m_status;
+    CompactSymbol m_currencyCode;
+    CompactFrequency m_recurrenceFrequency;
+    bool m_isRecurrent = false;
 };
 
 #endif // EXPENSE_H
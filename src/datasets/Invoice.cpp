@@ -3,8 +3,10 @@
 // </copyright>
 
 #include "Invoice.h"
+#include "JsonFields.h"
 #include <QDebug>
 
+#define INVOICE_ID "invoice_id"
 #define INVOICE_NUMBER "invoice_number"
 #define PARTY "customer_name"
 #define STATUS "status"
@@ -18,10 +20,14 @@ Invoice::Invoice()
 
 }
 
+QString Invoice::invoiceId() const
+{
+    return m_invoiceId;
+}
 
 QString Invoice::status() const
 {
-    return m_status;
+    return m_status.toString();
 }
 
 QString Invoice::invoiceNumber() const
@@ -31,22 +37,27 @@ QString Invoice::invoiceNumber() const
 
 QString Invoice::party() const
 {
-    return m_party;
+    return m_party.toString();
 }
 
 QDate Invoice::date() const
 {
-    return m_date;
+    return m_date.toDate();
 }
 
 QDate Invoice::dueDate() const
 {
-    return m_dueDate;
+    return m_dueDate.toDate();
 }
 
 QString Invoice::currencyCode() const
 {
-    return m_currencyCode;
+    return m_currencyCode.toString();
+}
+
+quint16 Invoice::currencyId() const
+{
+    return m_currencyCode.code();
 }
 
 double Invoice::total() const
@@ -68,6 +79,7 @@ Invoice Invoice::parseInvoice(const QVariantMap &map)
 {
     Invoice invoice;
 
+    invoice.m_invoiceId = map[INVOICE_ID].toString();
     invoice.m_status = map[STATUS].toString();
     invoice.m_invoiceNumber = map[INVOICE_NUMBER].toString();
     invoice.m_party = map[PARTY].toString();
@@ -78,15 +90,58 @@ Invoice Invoice::parseInvoice(const QVariantMap &map)
     return invoice;
 }
 
-Invoice Invoice::parseInvoice(const QStringList &list)
+Invoice Invoice::parseInvoice(const QJsonObject &object)
+{
+    Invoice invoice;
+    invoice.m_invoiceId = JsonFields::string(object, QLatin1String(INVOICE_ID));
+    invoice.m_status = JsonFields::string(object, QLatin1String(STATUS));
+    invoice.m_invoiceNumber = JsonFields::string(object, QLatin1String(INVOICE_NUMBER));
+    invoice.m_party = JsonFields::string(object, QLatin1String(PARTY));
+    invoice.m_date = JsonFields::date(object, QLatin1String(DATE));
+    invoice.m_dueDate = JsonFields::date(object, QLatin1String(DUE_DATE));
+    invoice.m_currencyCode = JsonFields::string(object, QLatin1String(CURRENCY_CODE));
+    invoice.m_total = JsonFields::number(object, QLatin1String(TOTAL));
+    return invoice;
+}
+
+Invoice Invoice::parseInvoice(const CsvReader &row)
 {
     Invoice invoice;
-    invoice.m_invoiceNumber = list.at(0);
-    invoice.m_party = list.at(1);
-    invoice.m_status = list.at(2);
-    invoice.m_date = QDate::fromString(list.at(3), "d-M-yyyy");
-    invoice.m_dueDate = QDate::fromString(list.at(4), "d-M-yyyy");
-    invoice.m_total = list.at(5).toDouble();
-    invoice.m_currencyCode = list.at(6);
+    invoice.m_invoiceId = row.string(0); // local files have no separate id, number is unique.
+    invoice.m_invoiceNumber = invoice.m_invoiceId;
+    invoice.m_party = row.string(1);
+    invoice.m_status = row.string(2);
+    invoice.m_date = row.date(3);
+    invoice.m_dueDate = row.date(4);
+    invoice.m_total = row.number(5);
+    invoice.m_currencyCode = row.string(6);
     return invoice;
 }
+
+QDataStream &operator<<(QDataStream &stream, const Invoice &invoice)
+{
+    stream << invoice.m_invoiceId
+           << invoice.m_invoiceNumber
+           << invoice.m_party
+           << invoice.m_status
+           << invoice.m_date
+           << invoice.m_dueDate
+           << invoice.m_total
+           << invoice.m_currencyCode
+           << invoice.m_plnTotal;
+    return stream;
+}
+
+QDataStream &operator>>(QDataStream &stream, Invoice &invoice)
+{
+    stream >> invoice.m_invoiceId
+           >> invoice.m_invoiceNumber
+           >> invoice.m_party
+           >> invoice.m_status
+           >> invoice.m_date
+           >> invoice.m_dueDate
+           >> invoice.m_total
+           >> invoice.m_currencyCode
+           >> invoice.m_plnTotal;
+    return stream;
+}
@@ -7,6 +7,10 @@
 
 #include <QDate>
 #include <QVariant>
+#include <QJsonObject>
+#include <QDataStream>
+#include "CompactFields.h"
+#include "CsvReader.h"
 
 /*!
  * \brief Class representing an invoice entity.
@@ -20,6 +24,11 @@ public:
      */
     explicit Invoice();
 
+    /*!
+     * \brief Returns an invoice Id used by Zoho to identify the document.
+     */
+    QString invoiceId() const;
+
     /*!
      * \brief Returns an invoice number.
      */
@@ -55,6 +64,11 @@ public:
      */
     QString currencyCode() const;
 
+    /*!
+     * \brief Returns a code of the currency shared by all the documents paid in it, cheaper to compare than the currency code.
+     */
+    quint16 currencyId() const;
+
     /*!
      * \brief Returns a total amount of the expense in Polish Zlote.
      */
@@ -73,20 +87,41 @@ public:
     static Invoice parseInvoice(const QVariantMap &map);
 
     /*!
-     * \brief Deserializes QStringList to create an invoic.
-     * \param const QStringList &list -- a list describing an invoice objects.
+     * \brief Deserializes QJsonObject to create an invoice. Fields are read directly, without converting to QVariantMap.
+     * \param const QJsonObject &object -- an object describing an invoice.
+     */
+    static Invoice parseInvoice(const QJsonObject &object);
+
+    /*!
+     * \brief Deserializes the current row of a CSV file to create an invoice. Columns follow the layout of the bundled CSV files.
+     * \param const CsvReader &row -- reader positioned at a row describing an invoice.
+     */
+    static Invoice parseInvoice(const CsvReader &row);
+
+    /*!
+     * \brief Serializes the invoice to a binary stream.
+     * \param QDataStream &stream -- stream to write to.
+     * \param const Invoice &invoice -- invoice to write.
+     */
+    friend QDataStream &operator<<(QDataStream &stream, const Invoice &invoice);
+
+    /*!
+     * \brief Deserializes the invoice from a binary stream.
+     * \param QDataStream &stream -- stream to read from.
+     * \param Invoice &invoice -- invoice to read into.
      */
-    static Invoice parseInvoice(const QStringList &list);
+    friend QDataStream &operator>>(QDataStream &stream, Invoice &invoice);
 
 private:
+    QString m_invoiceId = "";
     QString m_invoiceNumber = "";
-    QString m_party = "";
-    QString m_status = "";
-    QDate m_date = QDate();
-    QDate m_dueDate = QDate();
+    InternedString m_party;
     double m_total = 0.0;
-    QString m_currencyCode = "PLN";
     double m_plnTotal = 0.0;
+    CompactDate m_date;
+    CompactDate m_dueDate;
+    CompactSymbol m_status;
+    CompactSymbol m_currencyCode = CompactSymbol(QStringLiteral("PLN"));
 };
 
 #endif // INVOICE_H
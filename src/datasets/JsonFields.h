@@ -0,0 +1,78 @@
+// <copyright company="Scythe Studio Sp. z o.o.">
+//     This file contains proprietary code. Copyright (c) 2021. All rights reserved.
+// </copyright>
+
+#ifndef JSONFIELDS_H
+#define JSONFIELDS_H
+
+#include <QDate>
+#include <QJsonObject>
+#include <QLatin1String>
+
+/*!
+ * \brief Helpers reading typed fields straight out of QJsonObject.
+ * Keys are passed as QLatin1String, so lookups don't allocate, and no QVariant is created on the way.
+ */
+namespace JsonFields {
+
+/*!
+ * \brief Returns a string field or an empty string if there's no such field.
+ * \param const QJsonObject &object -- object to read from.
+ * \param QLatin1String key -- key of the field.
+ */
+inline QString string(const QJsonObject &object, QLatin1String key)
+{
+    return object.value(key).toString();
+}
+
+/*!
+ * \brief Returns a numeric field. Numbers sent as strings are converted as well.
+ * \param const QJsonObject &object -- object to read from.
+ * \param QLatin1String key -- key of the field.
+ */
+inline double number(const QJsonObject &object, QLatin1String key)
+{
+    const QJsonValue &value = object.value(key);
+    return value.isString() ? value.toString().toDouble() : value.toDouble();
+}
+
+/*!
+ * \brief Returns a date field. Invalid date is returned if there's no such field or it's empty.
+ * \param const QJsonObject &object -- object to read from.
+ * \param QLatin1String key -- key of the field.
+ */
+inline QDate date(const QJsonObject &object, QLatin1String key)
+{
+    const QString &text = object.value(key).toString();
+    if (text.isEmpty()) {
+        return QDate();
+    }
+
+    // Zoho sends dates as yyyy-MM-dd, digits are read directly instead of going through the generic date parser.
+    if (text.size() == 10 && text.at(4) == QLatin1Char('-') && text.at(7) == QLatin1Char('-')) {
+        const QChar *data = text.constData();
+        int values[3] = {0, 0, 0};
+        const int starts[3] = {0, 5, 8};
+        const int lengths[3] = {4, 2, 2};
+        bool digitsOnly = true;
+        for (int part = 0; part < 3 && digitsOnly; ++part) {
+            for (int i = starts[part]; i < starts[part] + lengths[part]; ++i) {
+                const ushort digit = data[i].unicode() - '0';
+                if (digit > 9) {
+                    digitsOnly = false;
+                    break;
+                }
+                values[part] = values[part] * 10 + digit;
+            }
+        }
+        if (digitsOnly) {
+            return QDate(values[0], values[1], values[2]);
+        }
+    }
+
+    return QDate::fromString(text, Qt::ISODate);
+}
+
+} // namespace JsonFields
+
+#endif // JSONFIELDS_H
@@ -0,0 +1,149 @@
+// <copyright company="Scythe Studio Sp. z o.o.">
+//     This file contains proprietary code. Copyright (c) 2021. All rights reserved.
+// </copyright>
+
+#include "Recurrence.h"
+
+Recurrence::Recurrence()
+{
+
+}
+
+Recurrence::Recurrence(const QDate &startDate, Frequency frequency, int interval)
+    : m_startDate(startDate)
+    , m_frequency(frequency)
+    , m_interval(qMax(1, interval))
+{
+
+}
+
+Recurrence::Frequency Recurrence::frequencyFromString(const QString &frequency)
+{
+    if (frequency == "days") {
+        return Days;
+    } else if (frequency == "weeks") {
+        return Weeks;
+    } else if (frequency == "months") {
+        return Months;
+    } else if (frequency == "years") {
+        return Years;
+    }
+    return NoFrequency;
+}
+
+QString Recurrence::frequencyToString(Frequency frequency)
+{
+    switch (frequency) {
+    case Days:
+        return "days";
+    case Weeks:
+        return "weeks";
+    case Months:
+        return "months";
+    case Years:
+        return "years";
+    default:
+        return QString();
+    }
+}
+
+bool Recurrence::isValid() const
+{
+    return m_startDate.isValid();
+}
+
+QDate Recurrence::startDate() const
+{
+    return m_startDate;
+}
+
+Recurrence::Frequency Recurrence::frequency() const
+{
+    return m_frequency;
+}
+
+int Recurrence::interval() const
+{
+    return m_interval;
+}
+
+QDate Recurrence::endDate() const
+{
+    return m_endDate;
+}
+
+void Recurrence::setEndDate(const QDate &endDate)
+{
+    m_endDate = endDate;
+}
+
+int Recurrence::count() const
+{
+    return m_count;
+}
+
+void Recurrence::setCount(int count)
+{
+    m_count = qMax(0, count);
+}
+
+QDate Recurrence::occurrence(int index) const
+{
+    switch (m_frequency) {
+    case NoFrequency:
+        return m_startDate;
+    case Days:
+        return m_startDate.addDays(qint64(index) * m_interval);
+    case Weeks:
+        return m_startDate.addDays(qint64(index) * m_interval * 7);
+    case Months:
+        return m_startDate.addMonths(index * m_interval);
+    case Years:
+        return m_startDate.addYears(index * m_interval);
+    }
+    return QDate();
+}
+
+QVector<QDate> Recurrence::occurrences(const QDate &from, const QDate &to) const
+{
+    QVector<QDate> dates;
+    forEachOccurrence(from, to, [&dates](const QDate &date) {
+        dates.append(date);
+    });
+    return dates;
+}
+
+int Recurrence::firstIndexFrom(const QDate &from) const
+{
+    if (m_frequency == NoFrequency || !from.isValid() || from <= m_startDate) {
+        return 0;
+    }
+
+    // index is estimated from the distance, then corrected as months and years differ in length.
+    int index = 0;
+    switch (m_frequency) {
+    case NoFrequency:
+        break;
+    case Days:
+        index = int(m_startDate.daysTo(from) / m_interval);
+        break;
+    case Weeks:
+        index = int(m_startDate.daysTo(from) / (7 * m_interval));
+        break;
+    case Months:
+        index = ((from.year() - m_startDate.year()) * 12 + from.month() - m_startDate.month()) / m_interval;
+        break;
+    case Years:
+        index = (from.year() - m_startDate.year()) / m_interval;
+        break;
+    }
+
+    index = qMax(0, index);
+    while (index > 0 && occurrence(index - 1) >= from) {
+        --index;
+    }
+    while (occurrence(index).isValid() && occurrence(index) < from) {
+        ++index;
+    }
+    return index;
+}
@@ -0,0 +1,155 @@
+// <copyright company="Scythe Studio Sp. z o.o.">
+//     This file contains proprietary code. Copyright (c) 2021. All rights reserved.
+// </copyright>
+
+#ifndef RECURRENCE_H
+#define RECURRENCE_H
+
+#include <QDate>
+#include <QString>
+#include <QVector>
+
+/*!
+ * \brief Class representing a rule of repeating a document, i.e. every 2 weeks until the end of the year.
+ * Occurrences are not stored. They are computed for a requested window of dates, so long horizons cost nothing.
+ */
+class Recurrence
+{
+public:
+
+    /*!
+     * \brief Unit of the interval between occurrences.
+     */
+    enum Frequency {
+        NoFrequency, // single occurrence at the start date.
+        Days,
+        Weeks,
+        Months,
+        Years
+    };
+
+    /*!
+     * \brief Constructor of a rule with no occurrences.
+     */
+    Recurrence();
+
+    /*!
+     * \brief Constructor.
+     * \param const QDate &startDate -- date of the first occurrence.
+     * \param Frequency frequency -- unit of the interval between occurrences.
+     * \param int interval -- number of units between occurrences, i.e. 2 for every second week.
+     */
+    Recurrence(const QDate &startDate, Frequency frequency, int interval = 1);
+
+    /*!
+     * \brief Returns frequency matching Zoho recurrence frequency ("days", "weeks", "months" or "years").
+     * NoFrequency is returned for unknown values.
+     * \param const QString &frequency -- value to convert.
+     */
+    static Frequency frequencyFromString(const QString &frequency);
+
+    /*!
+     * \brief Returns Zoho recurrence frequency matching the given one. Empty string is returned for NoFrequency.
+     * \param Frequency frequency -- value to convert.
+     */
+    static QString frequencyToString(Frequency frequency);
+
+    /*!
+     * \brief Returns true if the rule has a valid start date. Otherwise false.
+     */
+    bool isValid() const;
+
+    /*!
+     * \brief Returns date of the first occurrence.
+     */
+    QDate startDate() const;
+
+    /*!
+     * \brief Returns unit of the interval between occurrences.
+     */
+    Frequency frequency() const;
+
+    /*!
+     * \brief Returns number of units between occurrences.
+     */
+    int interval() const;
+
+    /*!
+     * \brief Returns the last date occurrences may fall on. Invalid date if there's no end date.
+     */
+    QDate endDate() const;
+
+    /*!
+     * \brief Sets the last date occurrences may fall on.
+     * \param const QDate &endDate -- value to set, invalid date for no end date.
+     */
+    void setEndDate(const QDate &endDate);
+
+    /*!
+     * \brief Returns maximal number of occurrences. 0 if the number is not limited.
+     */
+    int count() const;
+
+    /*!
+     * \brief Sets maximal number of occurrences.
+     * \param int count -- value to set, 0 for no limit.
+     */
+    void setCount(int count);
+
+    /*!
+     * \brief Returns date of the occurrence with the given index, counting from 0. Bounds of the rule are not checked.
+     * Dates are always computed from the start date, so i.e. monthly occurrences on the 31st come back to the 31st after shorter months.
+     * \param int index -- index of the occurrence.
+     */
+    QDate occurrence(int index) const;
+
+    /*!
+     * \brief Calls the function with the date of every occurrence between 'from' and 'to' (both inclusive), in order.
+     * Occurrences before 'from' are skipped in constant time.
+     * \param const QDate &from -- first date of the window.
+     * \param const QDate &to -- last date of the window.
+     * \param Function function -- function taking const QDate &.
+     */
+    template <typename Function>
+    void forEachOccurrence(const QDate &from, const QDate &to, Function function) const
+    {
+        if (!isValid()) {
+            return;
+        }
+
+        const QDate &last = m_endDate.isValid() && m_endDate < to ? m_endDate : to;
+        if (m_frequency == NoFrequency) {
+            // the single occurrence may fall on either side of the window.
+            if (from <= m_startDate && m_startDate <= last) {
+                function(m_startDate);
+            }
+            return;
+        }
+
+        for (int index = firstIndexFrom(from); m_count == 0 || index < m_count; ++index) {
+            const QDate &date = occurrence(index);
+            if (!date.isValid() || date > last) {
+                break;
+            }
+            function(date);
+        }
+    }
+
+    /*!
+     * \brief Returns dates of occurrences between 'from' and 'to' (both inclusive).
+     * \param const QDate &from -- first date of the window.
+     * \param const QDate &to -- last date of the window.
+     */
+    QVector<QDate> occurrences(const QDate &from, const QDate &to) const;
+
+private:
+    int firstIndexFrom(const QDate &from) const;
+
+    QDate m_startDate;
+    Frequency m_frequency = NoFrequency;
+    int m_interval = 1;
+    QDate m_endDate;
+    int m_count = 0;
+};
+
+#endif // RECURRENCE_H
@@ -0,0 +1,222 @@
+// <copyright company="Scythe Studio Sp. z o.o.">
+//     This file contains proprietary code. Copyright (c) 2021. All rights reserved.
+// </copyright>
+
+#include "TransactionStore.h"
+#include "ColumnKernels.h"
+#include <algorithm>
+#include <climits>
+
+#define INVALID_DAY INT_MIN
+
+// Dates amounts are booked on. Recurrent documents are expanded from their recurrences instead, if forecasting is enabled.
+static QDate invoiceBookingDate(const Invoice &invoice)
+{
+    return invoice.dueDate().isValid() ? invoice.dueDate() : invoice.date();
+}
+
+static QDate expenseBookingDate(const Expense &expense)
+{
+    return expense.date();
+}
+
+static QDate billBookingDate(const Bill &bill)
+{
+    return bill.dueDate().isValid() ? bill.dueDate() : bill.date();
+}
+
+qint32 TransactionColumns::day(const QDate &date)
+{
+    return date.isValid() ? qint32(date.toJulianDay()) : INVALID_DAY;
+}
+
+QDate TransactionColumns::date(qint32 day)
+{
+    return day == INVALID_DAY ? QDate() : QDate::fromJulianDay(day);
+}
+
+QDate TransactionColumns::invoiceSortDate(const Invoice &invoice)
+{
+    return invoice.dueDate().isValid() ? invoice.dueDate() : invoice.date();
+}
+
+QDate TransactionColumns::expenseSortDate(const Expense &expense)
+{
+    return expense.nextExpenseDate().isValid() ? expense.nextExpenseDate() : expense.date();
+}
+
+QDate TransactionColumns::billSortDate(const Bill &bill)
+{
+    return bill.nextBillDate().isValid() ? bill.nextBillDate() : bill.dueDate().isValid() ? bill.dueDate() : bill.date();
+}
+
+template <typename T>
+TransactionColumns TransactionColumns::fromDocuments(const QList<T> &documents, QDate (*sortDate)(const T &), QDate (*bookingDate)(const T &))
+{
+    TransactionColumns columns;
+    columns.reserve(documents.size());
+    for (const T &document : documents) {
+        columns.append(sortDate(document), bookingDate(document), document.total(), document.plnTotal(), document.currencyId());
+    }
+    return columns;
+}
+
+TransactionColumns TransactionColumns::fromInvoices(const QList<Invoice> &invoices)
+{
+    return fromDocuments(invoices, &invoiceSortDate, &invoiceBookingDate);
+}
+
+TransactionColumns TransactionColumns::fromExpenses(const QList<Expense> &expenses)
+{
+    TransactionColumns columns = fromDocuments(expenses, &expenseSortDate, &expenseBookingDate);
+    for (int i = 0; i < expenses.size(); ++i) {
+        if (expenses.at(i).isRecurrent()) {
+            columns.m_flags[i] |= Recurrent;
+            columns.m_recurrentRows.append(i);
+            columns.m_recurrences.append(expenses.at(i).recurrence());
+        }
+    }
+    return columns;
+}
+
+TransactionColumns TransactionColumns::fromBills(const QList<Bill> &bills)
+{
+    TransactionColumns columns = fromDocuments(bills, &billSortDate, &billBookingDate);
+    for (int i = 0; i < bills.size(); ++i) {
+        if (bills.at(i).isRecurrent()) {
+            columns.m_flags[i] |= Recurrent;
+            columns.m_recurrentRows.append(i);
+            columns.m_recurrences.append(bills.at(i).recurrence());
+        }
+    }
+    return columns;
+}
+
+int TransactionColumns::size() const
+{
+    return m_sortDays.size();
+}
+
+bool TransactionColumns::isEmpty() const
+{
+    return m_sortDays.isEmpty();
+}
+
+const QVector<qint32> &TransactionColumns::sortDays() const
+{
+    return m_sortDays;
+}
+
+const QVector<qint32> &TransactionColumns::bookingDays() const
+{
+    return m_bookingDays;
+}
+
+const QVector<double> &TransactionColumns::amounts() const
+{
+    return m_amounts;
+}
+
+const QVector<double> &TransactionColumns::plnAmounts() const
+{
+    return m_plnAmounts;
+}
+
+const QVector<quint16> &TransactionColumns::currencies() const
+{
+    return m_currencies;
+}
+
+const QVector<quint8> &TransactionColumns::flags() const
+{
+    return m_flags;
+}
+
+const QVector<int> &TransactionColumns::recurrentRows() const
+{
+    return m_recurrentRows;
+}
+
+const QVector<Recurrence> &TransactionColumns::recurrences() const
+{
+    return m_recurrences;
+}
+
+int TransactionColumns::lowerBound(const QDate &date) const
+{
+    return int(std::lower_bound(m_sortDays.constBegin(), m_sortDays.constEnd(), day(date)) - m_sortDays.constBegin());
+}
+
+int TransactionColumns::upperBound(const QDate &date) const
+{
+    return int(std::upper_bound(m_sortDays.constBegin(), m_sortDays.constEnd(), day(date)) - m_sortDays.constBegin());
+}
+
+double TransactionColumns::plnSum(int first, int last) const
+{
+    Q_ASSERT(0 <= first && first <= last && last <= size());
+    return ColumnKernels::sum(m_plnAmounts.constData() + first, last - first);
+}
+
+double TransactionColumns::plnSum(int first, int last, quint8 mask, quint8 value) const
+{
+    Q_ASSERT(0 <= first && first <= last && last <= size());
+    return ColumnKernels::maskedSum(m_plnAmounts.constData() + first, m_flags.constData() + first, mask, value, last - first);
+}
+
+void TransactionColumns::reserve(int size)
+{
+    m_sortDays.reserve(size);
+    m_bookingDays.reserve(size);
+    m_amounts.reserve(size);
+    m_plnAmounts.reserve(size);
+    m_currencies.reserve(size);
+    m_flags.reserve(size);
+}
+
+void TransactionColumns::append(const QDate &sortDate, const QDate &bookingDate, double amount, double plnAmount, quint16 currency)
+{
+    m_sortDays.append(day(sortDate));
+    m_bookingDays.append(day(bookingDate));
+    m_amounts.append(amount);
+    m_plnAmounts.append(plnAmount);
+    m_currencies.append(currency);
+    m_flags.append(0);
+}
+
+const TransactionColumns &TransactionStore::invoices() const
+{
+    return m_invoices;
+}
+
+void TransactionStore::setInvoices(const TransactionColumns &columns)
+{
+    m_invoices = columns;
+}
+
+const TransactionColumns &TransactionStore::expenses() const
+{
+    return m_expenses;
+}
+
+void TransactionStore::setExpenses(const TransactionColumns &columns)
+{
+    m_expenses = columns;
+}
+
+const TransactionColumns &TransactionStore::bills() const
+{
+    return m_bills;
+}
+
+void TransactionStore::setBills(const TransactionColumns &columns)
+{
+    m_bills = columns;
+}
+
+void TransactionStore::clear()
+{
+    m_invoices = TransactionColumns();
+    m_expenses = TransactionColumns();
+    m_bills = TransactionColumns();
+}
@@ -0,0 +1,227 @@
+// <copyright company="Scythe Studio Sp. z o.o.">
+//     This file contains proprietary code. Copyright (c) 2021. All rights reserved.
+// </copyright>
+
+#ifndef TRANSACTIONSTORE_H
+#define TRANSACTIONSTORE_H
+
+#include <QDate>
+#include <QList>
+#include <QVector>
+#include "Bill.h"
+#include "Expense.h"
+#include "Invoice.h"
+#include "Recurrence.h"
+
+/*!
+ * \brief Class representing the numbers of documents of a single kind stored column by column.
+ * Rows are in the order of the sorted list of documents they've been made of, so positions of a DocumentRange
+ * refer to the same rows. Sums, range searches and grouping by day scan contiguous arrays instead of documents.
+ */
+class TransactionColumns
+{
+public:
+
+    /*!
+     * \brief Bits of the flags column.
+     */
+    enum Flag : quint8 {
+        Recurrent = 0x01
+    };
+
+    /*!
+     * \brief Returns the day number stored in day columns. Invalid date is lower than all the valid ones, like QDate.
+     * \param const QDate &date -- date to convert.
+     */
+    static qint32 day(const QDate &date);
+
+    /*!
+     * \brief Returns the date of a day number stored in day columns.
+     * \param qint32 day -- day number to convert.
+     */
+    static QDate date(qint32 day);
+
+    /*!
+     * \brief Returns the date invoices are sorted and picked between 'from date' and 'to date' by.
+     * \param const Invoice &invoice -- invoice.
+     */
+    static QDate invoiceSortDate(const Invoice &invoice);
+
+    /*!
+     * \brief Returns the date expenses are sorted and picked between 'from date' and 'to date' by.
+     * \param const Expense &expense -- expense.
+     */
+    static QDate expenseSortDate(const Expense &expense);
+
+    /*!
+     * \brief Returns the date bills are sorted and picked between 'from date' and 'to date' by.
+     * \param const Bill &bill -- bill.
+     */
+    static QDate billSortDate(const Bill &bill);
+
+    /*!
+     * \brief Returns columns of invoices. Rows keep the order of the list, searching them requires it sorted by invoiceSortDate().
+     * \param const QList<Invoice> &invoices -- list of invoices.
+     */
+    static TransactionColumns fromInvoices(const QList<Invoice> &invoices);
+
+    /*!
+     * \brief Returns columns of expenses. Rows keep the order of the list, searching them requires it sorted by expenseSortDate().
+     * \param const QList<Expense> &expenses -- list of expenses.
+     */
+    static TransactionColumns fromExpenses(const QList<Expense> &expenses);
+
+    /*!
+     * \brief Returns columns of bills. Rows keep the order of the list, searching them requires it sorted by billSortDate().
+     * \param const QList<Bill> &bills -- list of bills.
+     */
+    static TransactionColumns fromBills(const QList<Bill> &bills);
+
+    /*!
+     * \brief Returns number of rows.
+     */
+    int size() const;
+
+    /*!
+     * \brief Returns true if there are no rows. Otherwise false.
+     */
+    bool isEmpty() const;
+
+    /*!
+     * \brief Returns day numbers of the dates rows are sorted by, ascending.
+     */
+    const QVector<qint32> &sortDays() const;
+
+    /*!
+     * \brief Returns day numbers of the dates amounts are booked on, i.e. on the chart.
+     */
+    const QVector<qint32> &bookingDays() const;
+
+    /*!
+     * \brief Returns total amounts, no conversion performed.
+     */
+    const QVector<double> &amounts() const;
+
+    /*!
+     * \brief Returns total amounts in Polish Zlote.
+     */
+    const QVector<double> &plnAmounts() const;
+
+    /*!
+     * \brief Returns ids of the currencies documents were paid in.
+     */
+    const QVector<quint16> &currencies() const;
+
+    /*!
+     * \brief Returns flags of rows, combination of Flag values.
+     */
+    const QVector<quint8> &flags() const;
+
+    /*!
+     * \brief Returns positions of recurrent rows, ascending.
+     */
+    const QVector<int> &recurrentRows() const;
+
+    /*!
+     * \brief Returns recurrences of recurrent rows, in the order of recurrentRows().
+     */
+    const QVector<Recurrence> &recurrences() const;
+
+    /*!
+     * \brief Returns position of the first row sorted at or after the date.
+     * \param const QDate &date -- date to look for.
+     */
+    int lowerBound(const QDate &date) const;
+
+    /*!
+     * \brief Returns position of the first row sorted after the date.
+     * \param const QDate &date -- date to look for.
+     */
+    int upperBound(const QDate &date) const;
+
+    /*!
+     * \brief Returns sum of amounts in Polish Zlote of rows between the positions.
+     * \param int first -- position of the first row.
+     * \param int last -- position right after the last row.
+     */
+    double plnSum(int first, int last) const;
+
+    /*!
+     * \brief Returns sum of amounts in Polish Zlote of rows between the positions having the flags selected by the mask set to the value.
+     * \param int first -- position of the first row.
+     * \param int last -- position right after the last row.
+     * \param quint8 mask -- flags to check.
+     * \param quint8 value -- expected value of the checked flags.
+     */
+    double plnSum(int first, int last, quint8 mask, quint8 value) const;
+
+private:
+    template <typename T>
+    static TransactionColumns fromDocuments(const QList<T> &documents, QDate (*sortDate)(const T &), QDate (*bookingDate)(const T &));
+
+    void reserve(int size);
+    void append(const QDate &sortDate, const QDate &bookingDate, double amount, double plnAmount, quint16 currency);
+
+    QVector<qint32> m_sortDays;
+    QVector<qint32> m_bookingDays;
+    QVector<double> m_amounts;
+    QVector<double> m_plnAmounts;
+    QVector<quint16> m_currencies;
+    QVector<quint8> m_flags;
+
+    QVector<int> m_recurrentRows;
+    QVector<Recurrence> m_recurrences;
+};
+
+/*!
+ * \brief Class representing columns of all the stored invoices, expenses and bills.
+ */
+class TransactionStore
+{
+public:
+
+    /*!
+     * \brief Returns columns of invoices.
+     */
+    const TransactionColumns &invoices() const;
+
+    /*!
+     * \brief Sets columns of invoices.
+     * \param const TransactionColumns &columns -- value to set.
+     */
+    void setInvoices(const TransactionColumns &columns);
+
+    /*!
+     * \brief Returns columns of expenses.
+     */
+    const TransactionColumns &expenses() const;
+
+    /*!
+     * \brief Sets columns of expenses.
+     * \param const TransactionColumns &columns -- value to set.
+     */
+    void setExpenses(const TransactionColumns &columns);
+
+    /*!
+     * \brief Returns columns of bills.
+     */
+    const TransactionColumns &bills() const;
+
+    /*!
+     * \brief Sets columns of bills.
+     * \param const TransactionColumns &columns -- value to set.
+     */
+    void setBills(const TransactionColumns &columns);
+
+    /*!
+     * \brief Removes all the rows.
+     */
+    void clear();
+
+private:
+    TransactionColumns m_invoices;
+    TransactionColumns m_expenses;
+    TransactionColumns m_bills;
+};
+
+#endif // TRANSACTIONSTORE_H
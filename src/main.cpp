@@ -2,16 +2,29 @@
 //     This file contains proprietary code. Copyright (c) 2021. All rights reserved.
 // </copyright>
 
+#include "HeadlessRunner.h"
 #include "MainWindow.h"
 #include <QApplication>
 #include <QChart>
 #include <QMessageBox>
 #include <QScreen>
+#include <QTimer>
 
 QT_CHARTS_USE_NAMESPACE
 
 int main(int argc, char *argv[])
 {
+    // headless mode works without a display, so no widgets can be created.
+    if (HeadlessRunner::isRequested(argc, argv)) {
+        QCoreApplication application(argc, argv);
+        HeadlessRunner runner;
+        if (!runner.parseArguments(application.arguments())) {
+            return 1;
+        }
+        QTimer::singleShot(0, &runner, &HeadlessRunner::start);
+        return application.exec();
+    }
+
     QApplication a(argc, argv);
     a.setApplicationDisplayName("Zoho Books Forecasting");
     a.setStyle("Fusion");
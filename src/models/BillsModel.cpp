@@ -31,32 +31,16 @@ QVariant BillsModel::data(const QModelIndex &index, int role) const
     if (index.row() < m_logicController->rangedBills().size()) {
         if (index.isValid() && role == Qt::DisplayRole) {
             const int row = index.row();
-            // Since the application makes request for all financial history,
-            // we need only those data between from date and to date.
-            const auto &bill = m_logicController->rangedBills().at(row);
-            switch (index.column()) {
-            case NumberColumn:
-                return bill.billNumber().isEmpty() ? "-" : bill.billNumber();
-            case PartyColumn:
-                return bill.party().isEmpty() ? "-" : bill.party();
-            case StatusColumn:
-                return bill.status().isEmpty() ? "-" : bill.status();
-            case RecurrenceFrequency:
-                return bill.recurrence_frequency().isEmpty() ? "-" : bill.recurrence_frequency();
-            case DateColumn:
-                return !bill.date().isValid() ? "-" : bill.date().toString("d/M/yyyy");
-            case DueDateColumn:
-                return !bill.dueDate().isValid() ? "-" : bill.dueDate().toString("d/M/yyyy");
-            case NextBillDate:
-                return !bill.nextBillDate().isValid() ? "-" : bill.nextBillDate().toString("d/M/yyyy");
-            case TotalColumn:
-                // Second parameter of toCurrencyString() method is intentionally " "
-                // in order not to display currency symbol.
-                return QLocale().toCurrencyString(bill.total(), " ") + " " + bill.currencyCode();
-            case PlnTotalColumn:
-                // Second parameter of toCurrencyString() method is intentionally " "
-                // in order not to display currency symbol.
-                return QLocale().toCurrencyString(bill.plnTotal(), " ") + " PLN";
+            // rows are formatted once, on the first paint after the model reset.
+            const QVector<QString> *texts = m_displayStrings.row(row);
+            if (!texts) {
+                // Since the application makes request for all financial history,
+                // we need only those data between from date and to date.
+                texts = &m_displayStrings.insert(row, displayStrings(m_logicController->rangedBills().at(row)));
+            }
+            const QString &text = texts->at(index.column());
+            if (!text.isNull()) {
+                return text;
             }
         } else if (index.isValid() && role == Qt::TextAlignmentRole) {
             switch (index.column()) {
@@ -74,6 +58,30 @@ QVariant BillsModel::data(const QModelIndex &index, int role) const
             if (index.column() == RecurrentColumn) {
                 return bill.isRecurrent() ? Qt::Checked : Qt::Unchecked;
             }
+        } else if (index.isValid() && role == SortRole) {
+            const auto &bill = m_logicController->rangedBills().at(index.row());
+            switch (index.column()) {
+            case NumberColumn:
+                return bill.billNumber();
+            case PartyColumn:
+                return bill.party();
+            case RecurrentColumn:
+                return bill.isRecurrent();
+            case StatusColumn:
+                return bill.status();
+            case RecurrenceFrequency:
+                return bill.recurrence_frequency();
+            case DateColumn:
+                return TransactionColumns::day(bill.date());
+            case DueDateColumn:
+                return TransactionColumns::day(bill.dueDate());
+            case NextBillDate:
+                return TransactionColumns::day(bill.nextBillDate());
+            case TotalColumn:
+                return bill.total();
+            case PlnTotalColumn:
+                return bill.plnTotal();
+            }
         }
     }
     return {};
@@ -109,107 +117,163 @@ QVariant BillsModel::headerData(int section, Qt::Orientation orientation, int ro
     return {};
 }
 
-QList<Bill> BillsModel::rangedBills() const
+DocumentRange<Bill> BillsModel::rangedBills() const
 {
     return m_logicController->rangedBills();
 }
 
+double BillsModel::rangedPlnTotal(bool hideNormal, bool hideRecurring) const
+{
+    const DocumentRange<Bill> &range = rangedBills();
+    const TransactionColumns &columns = m_logicController->transactions().bills();
+    const int first = range.offset();
+    const int last = first + range.size();
+    if (hideNormal && hideRecurring) {
+        return 0;
+    } else if (hideNormal) {
+        return columns.plnSum(first, last, TransactionColumns::Recurrent, TransactionColumns::Recurrent);
+    } else if (hideRecurring) {
+        return columns.plnSum(first, last, TransactionColumns::Recurrent, 0);
+    }
+    return columns.plnSum(first, last);
+}
+
 void BillsModel::loadData()
 {
     beginResetModel();
+    m_displayStrings.clear();
     endResetModel();
 }
 
+QVector<QString> BillsModel::displayStrings(const Bill &bill) const
+{
+    const QLocale &locale = m_displayStrings.locale();
+    QVector<QString> texts(ColumnCount);
+    texts[NumberColumn] = bill.billNumber().isEmpty() ? "-" : bill.billNumber();
+    texts[PartyColumn] = bill.party().isEmpty() ? "-" : bill.party();
+    texts[StatusColumn] = bill.status().isEmpty() ? "-" : bill.status();
+    texts[RecurrenceFrequency] = bill.recurrence_frequency().isEmpty() ? "-" : bill.recurrence_frequency();
+    texts[DateColumn] = !bill.date().isValid() ? "-" : bill.date().toString("d/M/yyyy");
+    texts[DueDateColumn] = !bill.dueDate().isValid() ? "-" : bill.dueDate().toString("d/M/yyyy");
+    texts[NextBillDate] = !bill.nextBillDate().isValid() ? "-" : bill.nextBillDate().toString("d/M/yyyy");
+    // Second parameter of toCurrencyString() method is intentionally " "
+    // in order not to display currency symbol.
+    texts[TotalColumn] = locale.toCurrencyString(bill.total(), " ") + " " + bill.currencyCode();
+    texts[PlnTotalColumn] = locale.toCurrencyString(bill.plnTotal(), " ") + " PLN";
+    return texts;
+}
+
 BillsProxyModel::BillsProxyModel(QObject *parent)
     : QSortFilterProxyModel(parent)
 {
-    m_filteringRegExp.setCaseSensitivity(Qt::CaseInsensitive);
+    // keys and the search index are made again for the new rows.
+    connect(this, &QAbstractItemModel::modelReset, this, [this] {
+        m_sortKeys.clear();
+        m_searchIndex = SearchIndex();
+        m_matchingRowsValid = false;
+        m_filteredTotal.reset(sourceModel()->rowCount());
+        emitFilteredTotal();
+    });
+    connect(this, &QAbstractProxyModel::sourceModelChanged, this, [this] {
+        m_sortKeys.clear();
+        m_searchIndex = SearchIndex();
+        m_matchingRowsValid = false;
+        m_filteredTotal.reset(sourceModel() ? sourceModel()->rowCount() : 0);
+    });
 }
 
 bool BillsProxyModel::lessThan(const QModelIndex &sourceLeft, const QModelIndex &sourceRight) const
 {
-    const QVariant &leftData = sourceModel()->data(sourceLeft);
-    const QVariant &rightData = sourceModel()->data(sourceRight);
-
-    if (sourceLeft.column() == BillsModel::NumberColumn) {
-        if (leftData.userType() == QMetaType::Double) {
-            return leftData.toDouble() < rightData.toDouble();
-        }
-    }
-
-    if (sourceLeft.column() == BillsModel::RecurrentColumn) {
-        BillsModel *billsModel = static_cast<BillsModel*>(sourceModel());
-        bool left = billsModel->rangedBills().at(sourceLeft.row()).isRecurrent();
-        bool right = billsModel->rangedBills().at(sourceRight.row()).isRecurrent();
-        return left < right;
-    }
-
-    if (sourceLeft.column() == BillsModel::TotalColumn || sourceLeft.column() == BillsModel::PlnTotalColumn) {
-        double left = QLocale().toDouble(leftData.toString().split(" ")[1]);
-        double right = QLocale().toDouble(rightData.toString().split(" ")[1]);
-        return left < right;
-    }
+    return m_sortKeys.lessThan(sourceLeft, sourceRight, BillsModel::SortRole);
+}
 
-    if (leftData.userType() == QMetaType::Double) {
-        return leftData.toDouble() < rightData.toDouble();
-    }
+void BillsProxyModel::setFilteringPattern(const QString &pattern)
+{
+    m_filteringPattern = pattern;
+    m_matchingRowsValid = false;
+    applyFilter();
+}
 
-    // In order to represent dates in d/M/yyyy format and use sorting, the following trick has to be applied.
-    if (leftData.userType() == QMetaType::QString) {
-        if (QDate::fromString(leftData.toString(), "d/M/yyyy").isValid()) {
-            return QDate::fromString(leftData.toString(), "d/M/yyyy") < QDate::fromString(rightData.toString(), "d/M/yyyy");
-        } else {
-            return leftData.toString() < rightData.toString();
-        }
+SearchIndex BillsProxyModel::searchIndex() const
+{
+    if (!m_searchIndex.isBuilt()) {
+        // the 'Recurrent' column has no text.
+        const QVector<int> columns = {
+            BillsModel::NumberColumn, BillsModel::PartyColumn, BillsModel::StatusColumn, BillsModel::RecurrenceFrequency,
+            BillsModel::DateColumn, BillsModel::DueDateColumn, BillsModel::NextBillDate, BillsModel::TotalColumn,
+            BillsModel::PlnTotalColumn
+        };
+        m_searchIndex = SearchIndex::build(sourceModel(), columns);
     }
+    return m_searchIndex;
+}
 
-    return QSortFilterProxyModel::lessThan(sourceLeft, sourceRight);
+void BillsProxyModel::setMatchingRows(const QString &pattern, int searchIndexId, const QBitArray &rows)
+{
+    m_filteringPattern = pattern;
+    m_matchingRows = rows;
+    m_matchingRowsValid = m_searchIndex.isBuilt() && m_searchIndex.id() == searchIndexId;
+    applyFilter();
 }
 
-void BillsProxyModel::setFilteringPattern(const QString &pattern)
+const QBitArray &BillsProxyModel::matchingRows() const
 {
-    m_filteringRegExp.setPattern(pattern);
-    invalidateFilter();
+    // rows are searched once per pattern, filterAcceptsRow() only checks the result.
+    if (!m_matchingRowsValid) {
+        m_matchingRows = searchIndex().match(m_filteringPattern);
+        m_matchingRowsValid = true;
+    }
+    return m_matchingRows;
 }
 
 void BillsProxyModel::setHideNormal(bool value)
 {
     m_hideNormal = value;
-    invalidateFilter();
+    applyFilter();
 }
 
 void BillsProxyModel::setHideRecurring(bool value)
 {
     m_hideRecurring = value;
-    invalidateFilter();
+    applyFilter();
 }
 
 bool BillsProxyModel::filterAcceptsRow(int sourceRow, const QModelIndex &) const
 {
-    QString number = sourceModel()->index(sourceRow, 0).data().toString();
-    QString party = sourceModel()->index(sourceRow, 1).data().toString();
-    QString status = sourceModel()->index(sourceRow, 3).data().toString();
-    QString requrrence_frequency = sourceModel()->index(sourceRow, 4).data().toString();
-    QString date = sourceModel()->index(sourceRow, 5).data().toString();
-    QString dueDate = sourceModel()->index(sourceRow, 6).data().toString();
-    QString nextBillDate = sourceModel()->index(sourceRow, 7).data().toString();
-    QString amount = sourceModel()->index(sourceRow, 8).data().toString();
-    QString plnAmount = sourceModel()->index(sourceRow, 9).data().toString();
-
     // Casting is required because delegate is used for 'Recurrent' column,
     // so there's no way to get the data in other way.
     BillsModel *billsModel = static_cast<BillsModel*>(sourceModel());
-    bool billIsRecurrent = billsModel->rangedBills().at(sourceRow).isRecurrent();
+    const Bill &bill = billsModel->rangedBills().at(sourceRow);
+    bool billIsRecurrent = bill.isRecurrent();
 
+    bool accepted = true;
     if (billIsRecurrent && m_hideRecurring) {
-        return false;
+        accepted = false;
     } else if (!billIsRecurrent && m_hideNormal) {
-        return false;
+        accepted = false;
+    } else {
+        accepted = matchingRows().testBit(sourceRow);
+    }
+
+    m_filteredTotal.setAccepted(sourceRow, accepted, bill.plnTotal());
+    return accepted;
+}
+
+void BillsProxyModel::applyFilter()
+{
+    invalidateFilter();
+    emitFilteredTotal();
+}
+
+void BillsProxyModel::emitFilteredTotal()
+{
+    // without a search text only the flags filter rows, so the columns are summed instead of evaluating every row.
+    if (m_filteringPattern.isEmpty()) {
+        emit filteredTotalChanged(static_cast<BillsModel*>(sourceModel())->rangedPlnTotal(m_hideNormal, m_hideRecurring));
+        return;
     }
 
-    return number.contains(m_filteringRegExp)  || party.contains(m_filteringRegExp)||
-           status.contains(m_filteringRegExp)  || date.contains(m_filteringRegExp) ||
-           dueDate.contains(m_filteringRegExp) || nextBillDate.contains(m_filteringRegExp) ||
-           amount.contains(m_filteringRegExp)  || plnAmount.contains(m_filteringRegExp) ||
-           requrrence_frequency.contains(m_filteringRegExp);
+    // rows are filtered lazily, counting them makes sure every row has been accepted or rejected.
+    rowCount();
+    emit filteredTotalChanged(m_filteredTotal.total());
 }
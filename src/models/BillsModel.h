@@ -7,6 +7,12 @@
 
 #include <QAbstractTableModel>
 #include <QSortFilterProxyModel>
+#include "datasets/Bill.h"
+#include "datasets/DocumentRange.h"
+#include "models/DisplayStringCache.h"
+#include "models/FilteredTotal.h"
+#include "models/SearchIndex.h"
+#include "models/SortKeyCache.h"
 
 class LogicController;
 
@@ -32,6 +38,11 @@ public:
      */
     bool filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const override;
 
+    /*!
+     * \brief Returns the index bills are filtered with. It's built on the first call after the rows change.
+     */
+    SearchIndex searchIndex() const;
+
 protected:
     bool lessThan(const QModelIndex &sourceLeft, const QModelIndex &sourceRight) const override;
 
@@ -43,6 +54,15 @@ public slots:
      */
     void setFilteringPattern(const QString &pattern);
 
+    /*!
+     * \brief Sets filtering pattern together with rows found for it, so the rows are not searched again.
+     * Rows found in an index of previous rows are dropped and the pattern is searched in the current one.
+     * \param const QString &pattern -- pattern the rows have been found for.
+     * \param int searchIndexId -- id of the search index the rows have been found in.
+     * \param const QBitArray &rows -- rows matching the pattern.
+     */
+    void setMatchingRows(const QString &pattern, int searchIndexId, const QBitArray &rows);
+
     /*!
      * \brief Sets if normal bills have to be hidden.
      * \param bool value -- value to set.
@@ -55,10 +75,27 @@ public slots:
      */
     void setHideRecurring(bool value);
 
+signals:
+
+    /*!
+     * \brief This signal is emitted when the filter has been applied to all the rows.
+     * \param double total -- sum of amounts in Polish Zlote of the accepted bills.
+     */
+    void filteredTotalChanged(double total);
+
 private:
-    QRegExp m_filteringRegExp;
+    const QBitArray &matchingRows() const;
+    void applyFilter();
+    void emitFilteredTotal();
+
+    QString m_filteringPattern;
+    mutable SearchIndex m_searchIndex; // built on the first filtering after the rows change.
+    mutable QBitArray m_matchingRows;
+    mutable bool m_matchingRowsValid = false;
     bool m_hideNormal = false;
     bool m_hideRecurring = false;
+    mutable SortKeyCache m_sortKeys;
+    mutable FilteredTotal m_filteredTotal; // updated by filterAcceptsRow().
 };
 
 class Bill;
@@ -96,6 +133,13 @@ public:
         ColumnCount
     };
 
+    /*!
+     * \brief Enum representing custom roles of the model.
+     */
+    enum Role {
+        SortRole = Qt::UserRole // typed value a column is sorted by, i.e. an amount or a day number instead of formatted text.
+    };
+
     /*!
      * \brief Returns number of rows of the table the model is used for.
      * \param const QModelIndex &parent -- model index to use for getting row count.
@@ -124,9 +168,16 @@ public:
     QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
 
     /*!
-     * \brief Returns a list of bills between set 'from date' and 'to date'.
+     * \brief Returns a view of bills between set 'from date' and 'to date'.
      */
-    QList<Bill> rangedBills() const;
+    DocumentRange<Bill> rangedBills() const;
+
+    /*!
+     * \brief Returns sum of amounts in Polish Zlote of bills between set 'from date' and 'to date', summed over the columns.
+     * \param bool hideNormal -- true if normal bills are left out.
+     * \param bool hideRecurring -- true if recurring bills are left out.
+     */
+    double rangedPlnTotal(bool hideNormal, bool hideRecurring) const;
 
 public slots:
 
@@ -138,7 +189,10 @@ public slots:
 signals:
 
 private:
+    QVector<QString> displayStrings(const Bill &bill) const;
+
     LogicController *m_logicController = nullptr;
+    mutable DisplayStringCache m_displayStrings; // filled by data(), cleared by loadData().
 };
 
 #endif // BILLSMODEL_H
@@ -0,0 +1,38 @@
+// <copyright company="Scythe Studio Sp. z o.o.">
+//     This file contains proprietary code. Copyright (c) 2021. All rights reserved.
+// </copyright>
+
+#include "DisplayStringCache.h"
+
+DisplayStringCache::DisplayStringCache()
+{
+
+}
+
+void DisplayStringCache::clear()
+{
+    m_locale = QLocale();
+    m_rows.clear();
+}
+
+const QLocale &DisplayStringCache::locale() const
+{
+    return m_locale;
+}
+
+const QVector<QString> *DisplayStringCache::row(int row) const
+{
+    if (row < m_rows.size() && !m_rows.at(row).isEmpty()) {
+        return &m_rows.at(row);
+    }
+    return nullptr;
+}
+
+const QVector<QString> &DisplayStringCache::insert(int row, const QVector<QString> &texts)
+{
+    if (row >= m_rows.size()) {
+        m_rows.resize(row + 1);
+    }
+    m_rows[row] = texts;
+    return m_rows.at(row);
+}
@@ -0,0 +1,54 @@
+// <copyright company="Scythe Studio Sp. z o.o.">
+//     This file contains proprietary code. Copyright (c) 2021. All rights reserved.
+// </copyright>
+
+#ifndef DISPLAYSTRINGCACHE_H
+#define DISPLAYSTRINGCACHE_H
+
+#include <QLocale>
+#include <QString>
+#include <QVector>
+
+/*!
+ * \brief Class keeping texts displayed in the cells of a table model, row by row.
+ * A row is formatted once, on the first access to any of its cells after clear(), with the locale captured by clear().
+ */
+class DisplayStringCache
+{
+public:
+
+    /*!
+     * \brief Constructor.
+     */
+    DisplayStringCache();
+
+    /*!
+     * \brief Removes all the texts and captures the current default locale. Has to be called whenever rows of the model
+     * or the locale change.
+     */
+    void clear();
+
+    /*!
+     * \brief Returns locale the texts have to be formatted with.
+     */
+    const QLocale &locale() const;
+
+    /*!
+     * \brief Returns texts of the row, column by column, or nullptr if the row hasn't been formatted yet.
+     * \param int row -- row of the model.
+     */
+    const QVector<QString> *row(int row) const;
+
+    /*!
+     * \brief Stores texts of the row and returns them.
+     * \param int row -- row of the model.
+     * \param const QVector<QString> &texts -- texts of the row, column by column. Null for cells without text.
+     */
+    const QVector<QString> &insert(int row, const QVector<QString> &texts);
+
+private:
+    QLocale m_locale;
+    QVector<QVector<QString>> m_rows; // empty for rows not formatted yet.
+};
+
+#endif // DISPLAYSTRINGCACHE_H
@@ -29,40 +29,48 @@ QVariant ExpensesModel::data(const QModelIndex &index, int role) const
     if (index.row() < m_logicController->rangedExpenses().size()) {
         if (index.isValid() && role == Qt::DisplayRole) {
             const int row = index.row();
-            // As long as the application makes request for all financial history,
-            // we need only those data between from date and to date.
-            const auto &expense = m_logicController->rangedExpenses().at(row);
+            // rows are formatted once, on the first paint after the model reset.
+            const QVector<QString> *texts = m_displayStrings.row(row);
+            if (!texts) {
+                // As long as the application makes request for all financial history,
+                // we need only those data between from date and to date.
+                texts = &m_displayStrings.insert(row, displayStrings(m_logicController->rangedExpenses().at(row)));
+            }
+            const QString &text = texts->at(index.column());
+            if (!text.isNull()) {
+                return text;
+            }
+        } else if (index.isValid() && role == Qt::CheckStateRole) {
+            if (index.column() == RecurrentColumn) {
+                const int row = index.row();
+                // Since the application makes a request for the whole financial history,
+                // we need the data between 'from date' and 'to date' only.
+                const auto &expense = m_logicController->rangedExpenses().at(row);
+                return expense.isRecurrent() ? Qt::Checked : Qt::Unchecked;
+            }
+        } else if (index.isValid() && role == SortRole) {
+            const auto &expense = m_logicController->rangedExpenses().at(index.row());
             switch (index.column()) {
             case IdColumn:
-                return expense.expenseId().isEmpty() ? "-" : expense.expenseId();
+                return expense.expenseId();
             case StatusColumn:
-                return expense.status().isEmpty() ? "-" : expense.status();
+                return expense.status();
             case CategoryColumn:
-                return expense.category().isEmpty() ? "-" : expense.category();
+                return expense.category();
             case PartyColumn:
-                return expense.partyName().isEmpty() ? "-" : expense.partyName();
+                return expense.partyName();
+            case RecurrentColumn:
+                return expense.isRecurrent();
             case RecurrenceFrequency:
-                return expense.recurrenceFrequency().isEmpty() ? "-" : expense.recurrenceFrequency();
+                return expense.recurrenceFrequency();
             case DateColumn:
-                return !expense.date().isValid() ? "-" : expense.date().toString("d/M/yyyy");
+                return TransactionColumns::day(expense.date());
             case NextExpenseDateColumn:
-                return !expense.nextExpenseDate().isValid() ? "-" : expense.nextExpenseDate().toString("d/M/yyyy");
+                return TransactionColumns::day(expense.nextExpenseDate());
             case TotalColumn:
-                // Second parameter of toCurrencyString() method is intentionally " "
-                // in order not to display currency symbol.
-                return QLocale().toCurrencyString(expense.total(), " ") + " " + expense.currencyCode();
+                return expense.total();
             case PlnTotalColumn:
-                // Second parameter of toCurrencyString() method is intentionally " "
-                // in order not to display currency symbol.
-                return QLocale().toCurrencyString(expense.plnTotal(), " ") + " PLN";
-            }
-        } else if (index.isValid() && role == Qt::CheckStateRole) {
-            if (index.column() == RecurrentColumn) {
-                const int row = index.row();
-                // Since the application makes a request for the whole financial history,
-                // we need the data between 'from date' and 'to date' only.
-                const auto &expense = m_logicController->rangedExpenses().at(row);
-                return expense.isRecurrent() ? Qt::Checked : Qt::Unchecked;
+                return expense.plnTotal();
             }
         } else if (index.isValid() && role == Qt::TextAlignmentRole) {
             switch (index.column()) {
@@ -121,108 +129,163 @@ QVariant ExpensesModel::headerData(int section, Qt::Orientation orientation, int
     return {};
 }
 
-QList<Expense> ExpensesModel::rangedExpenses() const
+DocumentRange<Expense> ExpensesModel::rangedExpenses() const
 {
     return m_logicController->rangedExpenses();
 }
 
+double ExpensesModel::rangedPlnTotal(bool hideNormal, bool hideRecurring) const
+{
+    const DocumentRange<Expense> &range = rangedExpenses();
+    const TransactionColumns &columns = m_logicController->transactions().expenses();
+    const int first = range.offset();
+    const int last = first + range.size();
+    if (hideNormal && hideRecurring) {
+        return 0;
+    } else if (hideNormal) {
+        return columns.plnSum(first, last, TransactionColumns::Recurrent, TransactionColumns::Recurrent);
+    } else if (hideRecurring) {
+        return columns.plnSum(first, last, TransactionColumns::Recurrent, 0);
+    }
+    return columns.plnSum(first, last);
+}
+
 void ExpensesModel::loadData()
 {
     beginResetModel();
+    m_displayStrings.clear();
     endResetModel();
 }
 
+QVector<QString> ExpensesModel::displayStrings(const Expense &expense) const
+{
+    const QLocale &locale = m_displayStrings.locale();
+    QVector<QString> texts(ColumnCount);
+    texts[IdColumn] = expense.expenseId().isEmpty() ? "-" : expense.expenseId();
+    texts[StatusColumn] = expense.status().isEmpty() ? "-" : expense.status();
+    texts[CategoryColumn] = expense.category().isEmpty() ? "-" : expense.category();
+    texts[PartyColumn] = expense.partyName().isEmpty() ? "-" : expense.partyName();
+    texts[RecurrenceFrequency] = expense.recurrenceFrequency().isEmpty() ? "-" : expense.recurrenceFrequency();
+    texts[DateColumn] = !expense.date().isValid() ? "-" : expense.date().toString("d/M/yyyy");
+    texts[NextExpenseDateColumn] = !expense.nextExpenseDate().isValid() ? "-" : expense.nextExpenseDate().toString("d/M/yyyy");
+    // Second parameter of toCurrencyString() method is intentionally " "
+    // in order not to display currency symbol.
+    texts[TotalColumn] = locale.toCurrencyString(expense.total(), " ") + " " + expense.currencyCode();
+    texts[PlnTotalColumn] = locale.toCurrencyString(expense.plnTotal(), " ") + " PLN";
+    return texts;
+}
+
 ExpensesProxyModel::ExpensesProxyModel(QObject *parent)
     : QSortFilterProxyModel(parent)
 {
-    m_filteringRegExp.setCaseSensitivity(Qt::CaseInsensitive);
+    // keys and the search index are made again for the new rows.
+    connect(this, &QAbstractItemModel::modelReset, this, [this] {
+        m_sortKeys.clear();
+        m_searchIndex = SearchIndex();
+        m_matchingRowsValid = false;
+        m_filteredTotal.reset(sourceModel()->rowCount());
+        emitFilteredTotal();
+    });
+    connect(this, &QAbstractProxyModel::sourceModelChanged, this, [this] {
+        m_sortKeys.clear();
+        m_searchIndex = SearchIndex();
+        m_matchingRowsValid = false;
+        m_filteredTotal.reset(sourceModel() ? sourceModel()->rowCount() : 0);
+    });
 }
 
 bool ExpensesProxyModel::filterAcceptsRow(int sourceRow, const QModelIndex &) const
 {
-    QString id = sourceModel()->index(sourceRow, 0).data().toString();
-    QString status = sourceModel()->index(sourceRow, 1).data().toString();
-    QString category = sourceModel()->index(sourceRow, 2).data().toString();
-    QString party = sourceModel()->index(sourceRow, 3).data().toString();
-    QString recurrenceFrequency = sourceModel()->index(sourceRow, 5).data().toString();
-    QString date = sourceModel()->index(sourceRow, 6).data().toString();
-    QString nextExpenseDate = sourceModel()->index(sourceRow, 7).data().toString();
-    QString amount = sourceModel()->index(sourceRow, 8).data().toString();
-    QString currency = sourceModel()->index(sourceRow, 9).data().toString();
-    QString plnAmount = sourceModel()->index(sourceRow, 10).data().toString();
-
     // Casting is required because delegate is used for 'Recurrent' column,
     // so there's no way to get the data in other way.
     ExpensesModel *expensesModel = static_cast<ExpensesModel*>(sourceModel());
-    bool expenseIsRecurrent = expensesModel->rangedExpenses().at(sourceRow).isRecurrent();
+    const Expense &expense = expensesModel->rangedExpenses().at(sourceRow);
+    bool expenseIsRecurrent = expense.isRecurrent();
 
+    bool accepted = true;
     if (expenseIsRecurrent && m_hideRecurring) {
-        return false;
+        accepted = false;
     } else if (!expenseIsRecurrent && m_hideNormal) {
-        return false;
+        accepted = false;
+    } else {
+        accepted = matchingRows().testBit(sourceRow);
     }
 
-    return id.contains(m_filteringRegExp)                  || status.contains(m_filteringRegExp) ||
-           category.contains(m_filteringRegExp)            || party.contains(m_filteringRegExp) ||
-           recurrenceFrequency.contains(m_filteringRegExp) || date.contains(m_filteringRegExp) ||
-           nextExpenseDate.contains(m_filteringRegExp)     || amount.contains(m_filteringRegExp) ||
-           currency.contains(m_filteringRegExp)            || plnAmount.contains(m_filteringRegExp);
+    m_filteredTotal.setAccepted(sourceRow, accepted, expense.plnTotal());
+    return accepted;
 }
 
 void ExpensesProxyModel::setFilteringPattern(const QString &pattern)
 {
-   m_filteringRegExp.setPattern(pattern);
-   invalidateFilter();
+    m_filteringPattern = pattern;
+    m_matchingRowsValid = false;
+    applyFilter();
+}
+
+SearchIndex ExpensesProxyModel::searchIndex() const
+{
+    if (!m_searchIndex.isBuilt()) {
+        // the 'Recurrent' column has no text.
+        const QVector<int> columns = {
+            ExpensesModel::IdColumn, ExpensesModel::StatusColumn, ExpensesModel::CategoryColumn, ExpensesModel::PartyColumn,
+            ExpensesModel::RecurrenceFrequency, ExpensesModel::DateColumn, ExpensesModel::NextExpenseDateColumn,
+            ExpensesModel::TotalColumn, ExpensesModel::PlnTotalColumn
+        };
+        m_searchIndex = SearchIndex::build(sourceModel(), columns);
+    }
+    return m_searchIndex;
+}
+
+void ExpensesProxyModel::setMatchingRows(const QString &pattern, int searchIndexId, const QBitArray &rows)
+{
+    m_filteringPattern = pattern;
+    m_matchingRows = rows;
+    m_matchingRowsValid = m_searchIndex.isBuilt() && m_searchIndex.id() == searchIndexId;
+    applyFilter();
+}
+
+const QBitArray &ExpensesProxyModel::matchingRows() const
+{
+    // rows are searched once per pattern, filterAcceptsRow() only checks the result.
+    if (!m_matchingRowsValid) {
+        m_matchingRows = searchIndex().match(m_filteringPattern);
+        m_matchingRowsValid = true;
+    }
+    return m_matchingRows;
 }
 
 void ExpensesProxyModel::setHideNormal(bool value)
 {
     m_hideNormal = value;
-    invalidateFilter();
+    applyFilter();
 }
 
 void ExpensesProxyModel::setHideRecurring(bool value)
 {
     m_hideRecurring = value;
-    invalidateFilter();
+    applyFilter();
 }
 
 bool ExpensesProxyModel::lessThan(const QModelIndex &sourceLeft, const QModelIndex &sourceRight) const
 {
-    const QVariant &leftData = sourceModel()->data(sourceLeft);
-    const QVariant &rightData = sourceModel()->data(sourceRight);
-
-    if (sourceLeft.column() == ExpensesModel::IdColumn) {
-        if (leftData.userType() == QMetaType::Double) {
-            return leftData.toDouble() < rightData.toDouble();
-        }
-    }
-
-    if (sourceLeft.column() == ExpensesModel::RecurrentColumn) {
-        ExpensesModel *expensesModel = static_cast<ExpensesModel*>(sourceModel());
-        bool left = expensesModel->rangedExpenses().at(sourceLeft.row()).isRecurrent();
-        bool right = expensesModel->rangedExpenses().at(sourceRight.row()).isRecurrent();
-        return left < right;
-    }
-
-    if (sourceLeft.column() == ExpensesModel::TotalColumn || sourceLeft.column() == ExpensesModel::PlnTotalColumn) {
-        double left = QLocale().toDouble(leftData.toString().split(" ")[1]);
-        double right = QLocale().toDouble(rightData.toString().split(" ")[1]);
-        return left < right;
-    }
+    return m_sortKeys.lessThan(sourceLeft, sourceRight, ExpensesModel::SortRole);
+}
 
-    if (leftData.userType() == QMetaType::Double) {
-        return leftData.toDouble() < rightData.toDouble();
-    }
+void ExpensesProxyModel::applyFilter()
+{
+    invalidateFilter();
+    emitFilteredTotal();
+}
 
-    // In order to represent dates in d/M/yyyy format and use sorting, the following trick has to be applied.
-    if (leftData.userType() == QMetaType::QString) {
-        if (QDate::fromString(leftData.toString(), "d/M/yyyy").isValid()) {
-            return QDate::fromString(leftData.toString(), "d/M/yyyy") < QDate::fromString(rightData.toString(), "d/M/yyyy");
-        } else {
-            return leftData.toString() < rightData.toString();
-        }
+void ExpensesProxyModel::emitFilteredTotal()
+{
+    // without a search text only the flags filter rows, so the columns are summed instead of evaluating every row.
+    if (m_filteringPattern.isEmpty()) {
+        emit filteredTotalChanged(static_cast<ExpensesModel*>(sourceModel())->rangedPlnTotal(m_hideNormal, m_hideRecurring));
+        return;
     }
 
-    return QSortFilterProxyModel::lessThan(sourceLeft, sourceRight);
+    // rows are filtered lazily, counting them makes sure every row has been accepted or rejected.
+    rowCount();
+    emit filteredTotalChanged(m_filteredTotal.total());
 }
@@ -7,6 +7,12 @@
 
 #include <QAbstractTableModel>
 #include <QSortFilterProxyModel>
+#include "datasets/Expense.h"
+#include "datasets/DocumentRange.h"
+#include "models/DisplayStringCache.h"
+#include "models/FilteredTotal.h"
+#include "models/SearchIndex.h"
+#include "models/SortKeyCache.h"
 
 class LogicController;
 
@@ -30,12 +36,26 @@ public:
      */
     bool filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const override;
 
+    /*!
+     * \brief Returns the index expenses are filtered with. It's built on the first call after the rows change.
+     */
+    SearchIndex searchIndex() const;
+
 public slots:
     /*!
      * \brief Sets filtering pattern.
      * \param const QString &pattern -- pattern to use for filtering.
      */
     void setFilteringPattern(const QString &pattern);
+
+    /*!
+     * \brief Sets filtering pattern together with rows found for it, so the rows are not searched again.
+     * Rows found in an index of previous rows are dropped and the pattern is searched in the current one.
+     * \param const QString &pattern -- pattern the rows have been found for.
+     * \param int searchIndexId -- id of the search index the rows have been found in.
+     * \param const QBitArray &rows -- rows matching the pattern.
+     */
+    void setMatchingRows(const QString &pattern, int searchIndexId, const QBitArray &rows);
     /*!
      * \brief Sets if normal expenses have to be hidden.
      * \param bool value -- value to set.
@@ -50,10 +70,27 @@ public slots:
 protected:
     bool lessThan(const QModelIndex &sourceLeft, const QModelIndex &sourceRight) const override;
 
+signals:
+
+    /*!
+     * \brief This signal is emitted when the filter has been applied to all the rows.
+     * \param double total -- sum of amounts in Polish Zlote of the accepted expenses.
+     */
+    void filteredTotalChanged(double total);
+
 private:
-    QRegExp m_filteringRegExp;
+    const QBitArray &matchingRows() const;
+    void applyFilter();
+    void emitFilteredTotal();
+
+    QString m_filteringPattern;
+    mutable SearchIndex m_searchIndex; // built on the first filtering after the rows change.
+    mutable QBitArray m_matchingRows;
+    mutable bool m_matchingRowsValid = false;
     bool m_hideNormal = false;
     bool m_hideRecurring = false;
+    mutable SortKeyCache m_sortKeys;
+    mutable FilteredTotal m_filteredTotal; // updated by filterAcceptsRow().
 };
 
 class Expense;
@@ -91,6 +128,13 @@ public:
         ColumnCount
     };
 
+    /*!
+     * \brief Enum representing custom roles of the model.
+     */
+    enum Role {
+        SortRole = Qt::UserRole // typed value a column is sorted by, i.e. an amount or a day number instead of formatted text.
+    };
+
     /*!
      * \brief Returns number of rows of the table the model is used for.
      * \param const QModelIndex &parent -- model index to use for getting row count.
@@ -119,9 +163,16 @@ public:
     QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
 
     /*!
-     * \brief Returns a list of expenses between set 'from date' and 'to date'.
+     * \brief Returns a view of expenses between set 'from date' and 'to date'.
      */
-    QList<Expense> rangedExpenses() const;
+    DocumentRange<Expense> rangedExpenses() const;
+
+    /*!
+     * \brief Returns sum of amounts in Polish Zlote of expenses between set 'from date' and 'to date', summed over the columns.
+     * \param bool hideNormal -- true if normal expenses are left out.
+     * \param bool hideRecurring -- true if recurring expenses are left out.
+     */
+    double rangedPlnTotal(bool hideNormal, bool hideRecurring) const;
 
 public slots:
     /*!
@@ -130,7 +181,10 @@ public slots:
     void loadData();
 
 private:
+    QVector<QString> displayStrings(const Expense &expense) const;
+
     LogicController *m_logicController = nullptr;
+    mutable DisplayStringCache m_displayStrings; // filled by data(), cleared by loadData().
 };
 
 #endif // EXPENSESMODEL_H
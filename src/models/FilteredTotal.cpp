@@ -0,0 +1,38 @@
+// <copyright company="Scythe Studio Sp. z o.o.">
+//     This file contains proprietary code. Copyright (c) 2021. All rights reserved.
+// </copyright>
+
+#include "FilteredTotal.h"
+
+void FilteredTotal::reset(int rowCount)
+{
+    m_acceptedRows = QBitArray(rowCount);
+    m_acceptedCount = 0;
+    m_total = 0;
+}
+
+void FilteredTotal::setAccepted(int row, bool accepted, double amount)
+{
+    if (row >= m_acceptedRows.size()) {
+        m_acceptedRows.resize(row + 1);
+    }
+    if (m_acceptedRows.testBit(row) == accepted) {
+        return;
+    }
+
+    m_acceptedRows.setBit(row, accepted);
+    if (accepted) {
+        ++m_acceptedCount;
+        m_total += amount;
+    } else if (--m_acceptedCount == 0) {
+        // no rounding errors of subtractions are carried over once nothing is accepted.
+        m_total = 0;
+    } else {
+        m_total -= amount;
+    }
+}
+
+double FilteredTotal::total() const
+{
+    return m_total;
+}
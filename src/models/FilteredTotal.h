@@ -0,0 +1,44 @@
+// <copyright company="Scythe Studio Sp. z o.o.">
+//     This file contains proprietary code. Copyright (c) 2021. All rights reserved.
+// </copyright>
+
+#ifndef FILTEREDTOTAL_H
+#define FILTEREDTOTAL_H
+
+#include <QBitArray>
+
+/*!
+ * \brief Class keeping sum of amounts of the rows accepted by a filter.
+ * The sum is updated by every filtering decision, so it's ready as soon as the filter has been applied,
+ * and a row evaluated again only changes the sum if the decision about it has changed.
+ */
+class FilteredTotal
+{
+public:
+
+    /*!
+     * \brief Sets number of rows, all of them rejected. Has to be called whenever rows of the model change.
+     * \param int rowCount -- number of rows.
+     */
+    void reset(int rowCount);
+
+    /*!
+     * \brief Records the filtering decision about a row.
+     * \param int row -- row of the source model.
+     * \param bool accepted -- true if the row has been accepted by the filter. Otherwise false.
+     * \param double amount -- amount of the row.
+     */
+    void setAccepted(int row, bool accepted, double amount);
+
+    /*!
+     * \brief Returns sum of amounts of the accepted rows.
+     */
+    double total() const;
+
+private:
+    QBitArray m_acceptedRows;
+    int m_acceptedCount = 0;
+    double m_total = 0;
+};
+
+#endif // FILTEREDTOTAL_H
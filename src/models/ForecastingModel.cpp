@@ -5,6 +5,7 @@
 #include <QDate>
 #include "ForecastingModel.h"
 #include "LogicController.h"
+#include <algorithm>
 
 ForecastingModel::ForecastingModel(LogicController *logicController, QObject *parent)
     : QAbstractTableModel(parent)
@@ -91,6 +92,7 @@ bool ForecastingModel::setData(const QModelIndex &index, const QVariant &value,
 {
     if (index.isValid() && role == Qt::EditRole) {
         auto& forecast = m_logicController->forecasts()[index.row()];
+        const Forecast previous = forecast;
         switch (index.column()) {
         case Name:
             forecast.name = value.toString();
@@ -99,15 +101,15 @@ bool ForecastingModel::setData(const QModelIndex &index, const QVariant &value,
             forecast.price = value.toDouble();
             break;
         case Date:
-            auto &forecast = m_logicController->forecasts()[index.row()];
             forecast.date = value.toDate();
             break;
         }
         emit dataChanged(index, index, {role});
-        emit modelChanged();
+        emit forecastChanged(previous, forecast);
         return true;
     } else if (index.isValid() && role == Qt::CheckStateRole) {
         auto& forecast = m_logicController->forecasts()[index.row()];
+        const Forecast previous = forecast;
         switch(index.column()) {
         case IsIncome:
             forecast.isIncome = value.toBool();
@@ -117,7 +119,7 @@ bool ForecastingModel::setData(const QModelIndex &index, const QVariant &value,
             break;
         }
         emit dataChanged(index, index, {role});
-        emit modelChanged();
+        emit forecastChanged(previous, forecast);
         return true;
     }
     return false;
@@ -128,7 +130,7 @@ void ForecastingModel::addEntry(const Forecast &forecastEntry)
     beginInsertRows(QModelIndex(), rowCount(), rowCount());
     m_logicController->forecasts().append(forecastEntry);
     endInsertRows();
-    emit modelChanged();
+    emit forecastChanged(Forecast(), forecastEntry);
 }
 
 void ForecastingModel::removeEntry(const Forecast &forecastEntry)
@@ -136,15 +138,15 @@ void ForecastingModel::removeEntry(const Forecast &forecastEntry)
     beginRemoveRows(QModelIndex(), m_logicController->forecasts().indexOf(forecastEntry), m_logicController->forecasts().indexOf(forecastEntry));
     m_logicController->forecasts().removeOne(forecastEntry);
     endRemoveRows();
-    emit modelChanged();
+    emit forecastChanged(forecastEntry, Forecast());
 }
 
 void ForecastingModel::removeEntry(int row)
 {
     beginRemoveRows(QModelIndex(), row, row);
-    m_logicController->forecasts().removeAt(row);
+    const Forecast forecast = m_logicController->forecasts().takeAt(row);
     endRemoveRows();
-    emit modelChanged();
+    emit forecastChanged(forecast, Forecast());
 }
 
 void ForecastingModel::clearEntries()
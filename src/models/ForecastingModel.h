@@ -161,6 +161,13 @@ signals:
      */
     void modelChanged();
 
+    /*!
+     * \brief This signal is emitted after a single forecast has been added, changed or removed.
+     * \param const ForecastingModel::Forecast &previous -- forecast before the change, with an invalid date if it has been added.
+     * \param const ForecastingModel::Forecast &current -- forecast after the change, with an invalid date if it has been removed.
+     */
+    void forecastChanged(const ForecastingModel::Forecast &previous, const ForecastingModel::Forecast &current);
+
 private:
     LogicController *m_logicController = nullptr;
 };
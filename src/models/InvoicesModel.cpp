@@ -31,28 +31,31 @@ QVariant InvoicesModel::data(const QModelIndex &index, int role) const
         if (index.isValid()) {
             if (role == Qt::DisplayRole) {
                 const int row = index.row();
-                // Since the application makes request for all financial history,
-                // we need only those data between from date and to date.
-                const auto &invoice = m_logicController->rangedInvoices().at(row);
+                // rows are formatted once, on the first paint after the model reset.
+                const QVector<QString> *texts = m_displayStrings.row(row);
+                if (!texts) {
+                    // Since the application makes request for all financial history,
+                    // we need only those data between from date and to date.
+                    texts = &m_displayStrings.insert(row, displayStrings(m_logicController->rangedInvoices().at(row)));
+                }
+                return texts->at(index.column());
+            } else if (role == SortRole) {
+                const auto &invoice = m_logicController->rangedInvoices().at(index.row());
                 switch (index.column()) {
                 case NumberColumn:
-                    return invoice.invoiceNumber().isEmpty() ? "-" : invoice.invoiceNumber();
+                    return invoice.invoiceNumber();
                 case PartyColumn:
-                    return invoice.party().isEmpty() ? "-" : invoice.party();
+                    return invoice.party();
                 case StatusColumn:
-                    return invoice.status().isEmpty() ? "-" : invoice.status();
+                    return invoice.status();
                 case DateColumn:
-                    return !invoice.date().isValid() ? "-" : invoice.date().toString("d/M/yyyy");
+                    return TransactionColumns::day(invoice.date());
                 case DueDateColumn:
-                    return !invoice.dueDate().isValid() ? "-" : invoice.dueDate().toString("d/M/yyyy");
+                    return TransactionColumns::day(invoice.dueDate());
                 case TotalColumn:
-                    // Second parameter of toCurrencyString() method is intentionally " "
-                    // in order not to display currency symbol.
-                    return QLocale().toCurrencyString(invoice.total(), " ") + " " + invoice.currencyCode();
+                    return invoice.total();
                 case PlnTotalColumn:
-                    // Since the application makes a request for the whole financial history,
-                    // we need the data between 'from date' and 'to date' only.
-                    return QLocale().toCurrencyString(invoice.plnTotal(), " ") + " PLN";
+                    return invoice.plnTotal();
                 }
             } else if (role == Qt::TextAlignmentRole) {
                 switch (index.column()) {
@@ -92,67 +95,124 @@ QVariant InvoicesModel::headerData(int section, Qt::Orientation orientation, int
     return {};
 }
 
+DocumentRange<Invoice> InvoicesModel::rangedInvoices() const
+{
+    return m_logicController->rangedInvoices();
+}
+
+double InvoicesModel::rangedPlnTotal() const
+{
+    const DocumentRange<Invoice> &range = rangedInvoices();
+    return m_logicController->transactions().invoices().plnSum(range.offset(), range.offset() + range.size());
+}
+
 void InvoicesModel::loadData()
 {
     beginResetModel();
+    m_displayStrings.clear();
     endResetModel();
 }
 
+QVector<QString> InvoicesModel::displayStrings(const Invoice &invoice) const
+{
+    const QLocale &locale = m_displayStrings.locale();
+    QVector<QString> texts(ColumnCount);
+    texts[NumberColumn] = invoice.invoiceNumber().isEmpty() ? "-" : invoice.invoiceNumber();
+    texts[PartyColumn] = invoice.party().isEmpty() ? "-" : invoice.party();
+    texts[StatusColumn] = invoice.status().isEmpty() ? "-" : invoice.status();
+    texts[DateColumn] = !invoice.date().isValid() ? "-" : invoice.date().toString("d/M/yyyy");
+    texts[DueDateColumn] = !invoice.dueDate().isValid() ? "-" : invoice.dueDate().toString("d/M/yyyy");
+    // Second parameter of toCurrencyString() method is intentionally " "
+    // in order not to display currency symbol.
+    texts[TotalColumn] = locale.toCurrencyString(invoice.total(), " ") + " " + invoice.currencyCode();
+    texts[PlnTotalColumn] = locale.toCurrencyString(invoice.plnTotal(), " ") + " PLN";
+    return texts;
+}
+
 InvoicesProxyModel::InvoicesProxyModel(QObject *parent)
     : QSortFilterProxyModel(parent)
 {
-    m_filteringRegExp.setCaseSensitivity(Qt::CaseInsensitive);
+    // keys and the search index are made again for the new rows.
+    connect(this, &QAbstractItemModel::modelReset, this, [this] {
+        m_sortKeys.clear();
+        m_searchIndex = SearchIndex();
+        m_matchingRowsValid = false;
+        m_filteredTotal.reset(sourceModel()->rowCount());
+        emitFilteredTotal();
+    });
+    connect(this, &QAbstractProxyModel::sourceModelChanged, this, [this] {
+        m_sortKeys.clear();
+        m_searchIndex = SearchIndex();
+        m_matchingRowsValid = false;
+        m_filteredTotal.reset(sourceModel() ? sourceModel()->rowCount() : 0);
+    });
 }
 
 bool InvoicesProxyModel::filterAcceptsRow(int sourceRow, const QModelIndex &) const
 {
-    QString number = sourceModel()->index(sourceRow, 0).data().toString();
-    QString party = sourceModel()->index(sourceRow, 1).data().toString();
-    QString status = sourceModel()->index(sourceRow, 2).data().toString();
-    QString date = sourceModel()->index(sourceRow, 3).data().toString();
-    QString dueDate = sourceModel()->index(sourceRow, 4).data().toString();
-    QString amount = sourceModel()->index(sourceRow, 5).data().toString();
-    QString currency = sourceModel()->index(sourceRow, 6).data().toString();
-    QString plnAmount = sourceModel()->index(sourceRow, 7).data().toString();
-
-    return number.contains(m_filteringRegExp) || party.contains(m_filteringRegExp) || status.contains(m_filteringRegExp)
-        || date.contains(m_filteringRegExp) || dueDate.contains(m_filteringRegExp) || amount.contains(m_filteringRegExp)
-        || currency.contains(m_filteringRegExp) || plnAmount.contains(m_filteringRegExp);
+    InvoicesModel *invoicesModel = static_cast<InvoicesModel*>(sourceModel());
+    const bool accepted = matchingRows().testBit(sourceRow);
+    m_filteredTotal.setAccepted(sourceRow, accepted, invoicesModel->rangedInvoices().at(sourceRow).plnTotal());
+    return accepted;
 }
 
 void InvoicesProxyModel::setFilteringPattern(const QString &pattern)
 {
-    m_filteringRegExp.setPattern(pattern);
-    invalidateFilter();
+    m_filteringPattern = pattern;
+    m_matchingRowsValid = false;
+    applyFilter();
 }
 
-bool InvoicesProxyModel::lessThan(const QModelIndex &sourceLeft, const QModelIndex &sourceRight) const
+SearchIndex InvoicesProxyModel::searchIndex() const
 {
-    const QVariant &leftData = sourceModel()->data(sourceLeft);
-    const QVariant &rightData = sourceModel()->data(sourceRight);
-
-    if (sourceLeft.column() == InvoicesModel::NumberColumn) {
-        return leftData.toDouble() < rightData.toDouble();
+    if (!m_searchIndex.isBuilt()) {
+        const QVector<int> columns = {
+            InvoicesModel::NumberColumn, InvoicesModel::PartyColumn, InvoicesModel::StatusColumn, InvoicesModel::DateColumn,
+            InvoicesModel::DueDateColumn, InvoicesModel::TotalColumn, InvoicesModel::PlnTotalColumn
+        };
+        m_searchIndex = SearchIndex::build(sourceModel(), columns);
     }
+    return m_searchIndex;
+}
 
-    if (sourceLeft.column() == InvoicesModel::TotalColumn || sourceLeft.column() == InvoicesModel::PlnTotalColumn) {
-        double left = QLocale().toDouble(leftData.toString().split(" ")[1]);
-        double right = QLocale().toDouble(rightData.toString().split(" ")[1]);
-        return left < right;
-    }
+void InvoicesProxyModel::setMatchingRows(const QString &pattern, int searchIndexId, const QBitArray &rows)
+{
+    m_filteringPattern = pattern;
+    m_matchingRows = rows;
+    m_matchingRowsValid = m_searchIndex.isBuilt() && m_searchIndex.id() == searchIndexId;
+    applyFilter();
+}
 
-    if (leftData.userType() == QMetaType::Double) {
-        return leftData.toDouble() < rightData.toDouble();
+const QBitArray &InvoicesProxyModel::matchingRows() const
+{
+    // rows are searched once per pattern, filterAcceptsRow() only checks the result.
+    if (!m_matchingRowsValid) {
+        m_matchingRows = searchIndex().match(m_filteringPattern);
+        m_matchingRowsValid = true;
     }
+    return m_matchingRows;
+}
 
-    // In order to represent dates in d/M/yyyy format and use sorting, the following trick has to be applied.
-    if (leftData.userType() == QMetaType::QString) {
-        if (QDate::fromString(leftData.toString(), "d/M/yyyy").isValid()) {
-            return QDate::fromString(leftData.toString(), "d/M/yyyy") < QDate::fromString(rightData.toString(), "d/M/yyyy");
-        } else {
-            return leftData.toString() < rightData.toString();
-        }
+bool InvoicesProxyModel::lessThan(const QModelIndex &sourceLeft, const QModelIndex &sourceRight) const
+{
+    return m_sortKeys.lessThan(sourceLeft, sourceRight, InvoicesModel::SortRole);
+}
+
+void InvoicesProxyModel::applyFilter()
+{
+    invalidateFilter();
+    emitFilteredTotal();
+}
+
+void InvoicesProxyModel::emitFilteredTotal()
+{
+    // without a search text all the rows are accepted, so the columns are summed instead of evaluating every row.
+    if (m_filteringPattern.isEmpty()) {
+        emit filteredTotalChanged(static_cast<InvoicesModel*>(sourceModel())->rangedPlnTotal());
+        return;
     }
 
-    return QSortFilterProxyModel::lessThan(sourceLeft, sourceRight);
+    // rows are filtered lazily, counting them makes sure every row has been accepted or rejected.
+    rowCount();
+    emit filteredTotalChanged(m_filteredTotal.total());
 }
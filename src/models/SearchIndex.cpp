@@ -0,0 +1,160 @@
+// <copyright company="Scythe Studio Sp. z o.o.">
+//     This file contains proprietary code. Copyright (c) 2021. All rights reserved.
+// </copyright>
+
+#include "SearchIndex.h"
+#include <QAtomicInt>
+#include <QRegExp>
+#include <algorithm>
+#include <iterator>
+
+#define FIELD_SEPARATOR '\n' // cannot be typed into a line edit, so matches never span two fields.
+#define REGEXP_SPECIAL_CHARACTERS "\\^$.|?*+()[]{}"
+#define TRIGRAM_LENGTH 3
+#define ROWS_BETWEEN_CANCELLATION_CHECKS 4096
+
+// a cancellation is checked every few thousand rows, so checking doesn't cost more than matching.
+static bool cancelledAt(int row, const std::function<bool()> &isCancelled)
+{
+    return row % ROWS_BETWEEN_CANCELLATION_CHECKS == 0 && isCancelled && isCancelled();
+}
+
+SearchIndex SearchIndex::build(const QAbstractItemModel *model, const QVector<int> &columns)
+{
+    static QAtomicInt lastId;
+    SearchIndex index;
+    index.m_isBuilt = true;
+    index.m_id = lastId.fetchAndAddRelaxed(1) + 1;
+
+    const int rowCount = model->rowCount();
+    index.m_rows.reserve(rowCount);
+    for (int row = 0; row < rowCount; ++row) {
+        QString text;
+        for (int column : columns) {
+            if (!text.isEmpty()) {
+                text += QLatin1Char(FIELD_SEPARATOR);
+            }
+            text += model->index(row, column).data().toString().toLower();
+        }
+
+        // rows are added in order, so a row already added to the trigram is the last one.
+        for (int i = 0; i + TRIGRAM_LENGTH <= text.size(); ++i) {
+            const QChar *characters = text.constData() + i;
+            if (characters[0] != QLatin1Char(FIELD_SEPARATOR) && characters[1] != QLatin1Char(FIELD_SEPARATOR)
+                    && characters[2] != QLatin1Char(FIELD_SEPARATOR)) {
+                QVector<int> &rows = index.m_trigrams[trigram(characters)];
+                if (rows.isEmpty() || rows.last() != row) {
+                    rows.append(row);
+                }
+            }
+        }
+        index.m_rows.append(text);
+    }
+    return index;
+}
+
+bool SearchIndex::isBuilt() const
+{
+    return m_isBuilt;
+}
+
+int SearchIndex::rowCount() const
+{
+    return m_rows.size();
+}
+
+int SearchIndex::id() const
+{
+    return m_id;
+}
+
+QBitArray SearchIndex::match(const QString &pattern, const std::function<bool()> &isCancelled) const
+{
+    if (pattern.isEmpty()) {
+        return QBitArray(m_rows.size(), true);
+    }
+    return isRegExp(pattern) ? matchRegExp(pattern, isCancelled) : matchText(pattern.toLower(), isCancelled);
+}
+
+bool SearchIndex::isRegExp(const QString &pattern)
+{
+    for (const QChar &character : pattern) {
+        if (character.unicode() < 128 && qstrchr(REGEXP_SPECIAL_CHARACTERS, char(character.unicode()))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+quint64 SearchIndex::trigram(const QChar *text)
+{
+    return quint64(text[0].unicode()) << 32 | quint64(text[1].unicode()) << 16 | quint64(text[2].unicode());
+}
+
+QBitArray SearchIndex::matchRegExp(const QString &pattern, const std::function<bool()> &isCancelled) const
+{
+    // fields are matched one by one, so anchors refer to the beginning and the end of a field.
+    QBitArray matches(m_rows.size());
+    const QRegExp regExp(pattern, Qt::CaseInsensitive);
+    for (int row = 0; row < m_rows.size(); ++row) {
+        if (cancelledAt(row, isCancelled)) {
+            return QBitArray();
+        }
+        for (const QStringRef &field : m_rows.at(row).splitRef(QLatin1Char(FIELD_SEPARATOR))) {
+            if (regExp.indexIn(field.toString()) != -1) {
+                matches.setBit(row);
+                break;
+            }
+        }
+    }
+    return matches;
+}
+
+QBitArray SearchIndex::matchText(const QString &text, const std::function<bool()> &isCancelled) const
+{
+    QBitArray matches(m_rows.size());
+    if (text.size() < TRIGRAM_LENGTH) {
+        for (int row = 0; row < m_rows.size(); ++row) {
+            if (cancelledAt(row, isCancelled)) {
+                return QBitArray();
+            }
+            if (m_rows.at(row).contains(text)) {
+                matches.setBit(row);
+            }
+        }
+        return matches;
+    }
+
+    // rows containing the text contain all its trigrams. Intersecting from the shortest list keeps candidates few.
+    QVector<const QVector<int> *> lists;
+    for (int i = 0; i + TRIGRAM_LENGTH <= text.size(); ++i) {
+        const auto rows = m_trigrams.constFind(trigram(text.constData() + i));
+        if (rows == m_trigrams.constEnd()) {
+            return matches;
+        }
+        lists.append(&rows.value());
+    }
+    std::sort(lists.begin(), lists.end(), [](const QVector<int> *a, const QVector<int> *b) {
+        return a->size() < b->size();
+    });
+
+    QVector<int> candidates = *lists.first();
+    for (int i = 1; i < lists.size() && !candidates.isEmpty(); ++i) {
+        QVector<int> intersection;
+        std::set_intersection(candidates.constBegin(), candidates.constEnd(), lists.at(i)->constBegin(), lists.at(i)->constEnd(),
+                              std::back_inserter(intersection));
+        candidates.swap(intersection);
+    }
+
+    // trigrams may appear in other order or in other fields, so candidates are checked with the whole text.
+    for (int i = 0; i < candidates.size(); ++i) {
+        if (cancelledAt(i, isCancelled)) {
+            return QBitArray();
+        }
+        const int row = candidates.at(i);
+        if (m_rows.at(row).contains(text)) {
+            matches.setBit(row);
+        }
+    }
+    return matches;
+}
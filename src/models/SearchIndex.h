@@ -0,0 +1,67 @@
+// <copyright company="Scythe Studio Sp. z o.o.">
+//     This file contains proprietary code. Copyright (c) 2021. All rights reserved.
+// </copyright>
+
+#ifndef SEARCHINDEX_H
+#define SEARCHINDEX_H
+
+#include <QAbstractItemModel>
+#include <QBitArray>
+#include <QHash>
+#include <QString>
+#include <QVector>
+#include <functional>
+
+/*!
+ * \brief Class representing an index of texts displayed in rows of a table model, built once for the rows it's been made of.
+ * Plain text is looked up in an index of trigrams of lowercased rows, so only rows containing all the trigrams of the text
+ * are checked. Patterns with special characters are matched as regular expressions against every field instead.
+ * A built index is never modified, so it can be searched from any thread.
+ */
+class SearchIndex
+{
+public:
+
+    /*!
+     * \brief Returns an index of texts displayed in the given columns of all the rows of the model.
+     * \param const QAbstractItemModel *model -- model to read the texts from.
+     * \param const QVector<int> &columns -- columns to search in.
+     */
+    static SearchIndex build(const QAbstractItemModel *model, const QVector<int> &columns);
+
+    /*!
+     * \brief Returns true if the index has been built. Otherwise false.
+     */
+    bool isBuilt() const;
+
+    /*!
+     * \brief Returns number of indexed rows.
+     */
+    int rowCount() const;
+
+    /*!
+     * \brief Returns a number identifying the build of the index. Copies of the index share it.
+     */
+    int id() const;
+
+    /*!
+     * \brief Returns rows containing the pattern, case insensitive. All the rows match an empty pattern.
+     * \param const QString &pattern -- text or, if it contains any of special characters, a regular expression.
+     * \param const std::function<bool()> &isCancelled -- checked every few thousand rows. Empty result is returned once it's true.
+     */
+    QBitArray match(const QString &pattern, const std::function<bool()> &isCancelled = nullptr) const;
+
+private:
+    static bool isRegExp(const QString &pattern);
+    static quint64 trigram(const QChar *text);
+
+    QBitArray matchRegExp(const QString &pattern, const std::function<bool()> &isCancelled) const;
+    QBitArray matchText(const QString &text, const std::function<bool()> &isCancelled) const;
+
+    bool m_isBuilt = false;
+    int m_id = 0;
+    QVector<QString> m_rows; // lowercased fields of rows, separated by new lines.
+    QHash<quint64, QVector<int>> m_trigrams; // ascending rows containing the trigram.
+};
+
+#endif // SEARCHINDEX_H
@@ -0,0 +1,48 @@
+// <copyright company="Scythe Studio Sp. z o.o.">
+//     This file contains proprietary code. Copyright (c) 2021. All rights reserved.
+// </copyright>
+
+#include "SortKeyCache.h"
+
+void SortKeyCache::clear()
+{
+    m_columns.clear();
+}
+
+bool SortKeyCache::lessThan(const QModelIndex &left, const QModelIndex &right, int role)
+{
+    const Keys &columnKeys = keys(left.model(), left.column(), role);
+    if (columnKeys.isNumeric) {
+        return columnKeys.numbers.at(left.row()) < columnKeys.numbers.at(right.row());
+    }
+    return columnKeys.strings.at(left.row()) < columnKeys.strings.at(right.row());
+}
+
+const SortKeyCache::Keys &SortKeyCache::keys(const QAbstractItemModel *model, int column, int role)
+{
+    if (m_columns.size() <= column) {
+        m_columns.resize(column + 1);
+    }
+
+    Keys &columnKeys = m_columns[column];
+    if (columnKeys.isBuilt) {
+        return columnKeys;
+    }
+
+    // the model returns values of the same type for the whole column, so the first one decides how the column is compared.
+    const int rowCount = model->rowCount();
+    columnKeys.isBuilt = true;
+    columnKeys.isNumeric = rowCount == 0 || model->index(0, column).data(role).userType() != QMetaType::QString;
+    if (columnKeys.isNumeric) {
+        columnKeys.numbers.resize(rowCount);
+        for (int row = 0; row < rowCount; ++row) {
+            columnKeys.numbers[row] = model->index(row, column).data(role).toDouble();
+        }
+    } else {
+        columnKeys.strings.resize(rowCount);
+        for (int row = 0; row < rowCount; ++row) {
+            columnKeys.strings[row] = model->index(row, column).data(role).toString();
+        }
+    }
+    return columnKeys;
+}
@@ -0,0 +1,47 @@
+// <copyright company="Scythe Studio Sp. z o.o.">
+//     This file contains proprietary code. Copyright (c) 2021. All rights reserved.
+// </copyright>
+
+#ifndef SORTKEYCACHE_H
+#define SORTKEYCACHE_H
+
+#include <QAbstractItemModel>
+#include <QString>
+#include <QVector>
+
+/*!
+ * \brief Class keeping keys the rows of a table model are sorted by, column by column.
+ * Keys of a column are read from the sort role of the model once, on the first comparison after clear().
+ * Numbers, booleans and dates (as day numbers) are compared as doubles, other values as strings.
+ */
+class SortKeyCache
+{
+public:
+
+    /*!
+     * \brief Removes all the keys. Has to be called whenever rows of the model change.
+     */
+    void clear();
+
+    /*!
+     * \brief Returns true if the key of the left row is lower than the key of the right row.
+     * \param const QModelIndex &left -- index of the left cell of the source model.
+     * \param const QModelIndex &right -- index of the right cell of the source model, in the same column.
+     * \param int role -- role returning the typed value the column is sorted by.
+     */
+    bool lessThan(const QModelIndex &left, const QModelIndex &right, int role);
+
+private:
+    struct Keys {
+        bool isBuilt = false;
+        bool isNumeric = false;
+        QVector<double> numbers;
+        QVector<QString> strings;
+    };
+
+    const Keys &keys(const QAbstractItemModel *model, int column, int role);
+
+    QVector<Keys> m_columns;
+};
+
+#endif // SORTKEYCACHE_H
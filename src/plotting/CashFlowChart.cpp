@@ -4,10 +4,12 @@
 
 #include "CashFlowChart.h"
 #include "LogicController.h"
+#include "plotting/Downsampler.h"
 #include <QLineSeries>
 #include <QtCore>
+#include <algorithm>
 
-#define MAX_NUMBER_OF_FUTURE_EVENTS 400
+#define DEFAULT_PLOT_WIDTH 1000
 
 CashFlowChart::CashFlowChart(LogicController *logicalController, QGraphicsItem *parent, Qt::WindowFlags wFlags)
     : QChart(parent, wFlags)
@@ -19,6 +21,14 @@ CashFlowChart::CashFlowChart(LogicController *logicalController, QGraphicsItem *
     connect(this, &CashFlowChart::axesPrepared, this, [&](){
         setSeriesVisible(true);
     });
+    connect(this, &CashFlowChart::plotAreaChanged, this, [&](){
+        // number of drawn points follows width of the chart.
+        if (m_seriesReady) {
+            showPoints(m_incomeSeries, m_incomePoints);
+            showPoints(m_expensesSeries, m_expensesPoints);
+            showPoints(m_cashFlowSeries, m_cashFlowPoints);
+        }
+    });
     setup();
 }
 
@@ -61,6 +71,7 @@ void CashFlowChart::prepareIncomeSeries(const QList<Invoice> &invoices,
                                         const QList<ForecastingModel::Forecast> &forecasts)
 {
     qDebug() << "Income series";
+    m_seriesReady = false;
     if (m_incomeSeries) {
         delete m_incomeSeries;
     }
@@ -75,93 +86,33 @@ void CashFlowChart::prepareIncomeSeries(const QList<Invoice> &invoices,
      * The idea is to collect all unique dates of the incomes. If some income has the same date as another, no unique points are added.
      * Only the general value of amount on this date is increased.
      */
-
-    QVector<DateAmount> invoicesDateAmounts; //temporary storage of invoices.
-    for (const auto &invoice: invoices) {
-        QDate date = invoice.dueDate().isValid() ? invoice.dueDate() : invoice.date();
-        invoicesDateAmounts.append(DateAmount {date, invoice.plnTotal(), true, false});
-    }
-
-    QDate limit = m_logicController->lastDate() > m_toDate ? m_logicController->lastDate() : m_toDate;
-    QVector<DateAmount> forecastsDateAmounts; //temporary storage of forecasts.
-    if (m_logicController->isForecastingEnabled()) {
-        for (const auto &forecast : forecasts) {
-            if (forecast.date.isValid() && m_logicController->firstDate() <= forecast.date) {
-                if (forecast.isIncome) {
-                    if (forecast.isRecurrent) {
-                        // recurrent incomes follow the same pattern as usual once, but only added every month till the last data.
-                        for (int i = 0; ; ++i) {
-                            if (forecast.date.addMonths(i) > limit) {
-                                forecastsDateAmounts.append(DateAmount {forecast.date.addMonths(i), forecast.price, forecast.isIncome, forecast.isRecurrent});
-                                break;
-                            }
-                            forecastsDateAmounts.append(DateAmount {forecast.date.addMonths(i), forecast.price, forecast.isIncome, forecast.isRecurrent});
-                        }
-                    } else {
-                        forecastsDateAmounts.append(DateAmount {forecast.date, forecast.price, forecast.isIncome, forecast.isRecurrent});
-                    }
-                }
+    updateForecastEngine();
+    m_incomeDays = m_forecastEngine.incomeDays(invoices, forecasts);
+
+    QDate dateAfterLast = m_forecastEngine.firstDate();
+
+    m_incomePoints.clear();
+    m_incomePoints.reserve(m_incomeDays.size() + 2);
+    for (const ForecastEngine::DayAmount &day : m_incomeDays) {
+        m_incomePoints.append(QPointF(day.date.startOfDay().toMSecsSinceEpoch(), day.amount));
+        if (m_fromDate <= day.date && day.date <= m_toDate) {
+            if (day.amount > m_maxValue) {
+               m_maxValue = day.amount;
+            } else if (day.amount < m_minValue) {
+               m_minValue = day.amount;
             }
         }
-    }
 
-    // if main storage of invoices has an entry on this date, increase amount on this date. Otherwise, add new point.
-
-    for (DateAmount &invoiceDateAmount : invoicesDateAmounts) {
-        bool found = false;
-        for (DateAmount &dateAmount : m_dateAmounts) {
-            if (invoiceDateAmount.date == dateAmount.date && invoiceDateAmount.isIncome && dateAmount.isIncome) {
-                dateAmount.amount += invoiceDateAmount.amount;
-                found = true;
-                break;
-            }
-        }
-        if (!found) {
-            m_dateAmounts.append(invoiceDateAmount);
+        if (day.date > dateAfterLast) {
+            dateAfterLast = day.date;
         }
     }
 
-    for (DateAmount &forecastDateAmount : forecastsDateAmounts) {
-        bool found = false;
-        for (DateAmount &dateAmount : m_dateAmounts) {
-            if (forecastDateAmount.date == dateAmount.date && forecastDateAmount.isIncome && dateAmount.isIncome) {
-                dateAmount.amount += forecastDateAmount.amount;
-                found = true;
-                break;
-            }
-        }
-        if (!found) {
-            m_dateAmounts.append(forecastDateAmount);
-        }
-    }
-
-    std::sort(m_dateAmounts.begin(), m_dateAmounts.end(), [](const DateAmount &a, const DateAmount &b) {
-        return a.date < b.date;
-    });
-
-    QDate dateAfterLast = m_logicController->firstDate();
-
-    for (DateAmount &dateAmount : m_dateAmounts) {
-        if (dateAmount.isIncome) {
-            m_incomeSeries->append(dateAmount.date.startOfDay().toMSecsSinceEpoch(), dateAmount.amount);
-            if (m_fromDate <= dateAmount.date && dateAmount.date <= m_toDate) {
-                if (dateAmount.amount > m_maxValue) {
-                   m_maxValue = dateAmount.amount;
-                } else if (dateAmount.amount < m_minValue) {
-                   m_minValue = dateAmount.amount;
-                }
-            }
-
-            if (dateAmount.date > dateAfterLast) {
-                dateAfterLast = dateAmount.date;
-            }
-        }
-    }
-
-    if (m_logicController->isForecastingEnabled()) {
-        m_incomeSeries->append(dateAfterLast.startOfDay().toMSecsSinceEpoch(), 0);
-        m_incomeSeries->append(limit.startOfDay().toMSecsSinceEpoch(), 0);
+    if (m_forecastEngine.isForecastingEnabled()) {
+        m_incomePoints.append(QPointF(dateAfterLast.startOfDay().toMSecsSinceEpoch(), 0));
+        m_incomePoints.append(QPointF(m_forecastEngine.limit().startOfDay().toMSecsSinceEpoch(), 0));
     }
+    showPoints(m_incomeSeries, m_incomePoints);
 
     addSeries(m_incomeSeries);
     m_incomeSeries->setVisible(false);
@@ -176,6 +127,7 @@ void CashFlowChart::prepareExpensesSeries(const QList<Expense> &expenses,
                                           const QList<ForecastingModel::Forecast> &forecasts)
 {
     qDebug() << "Expenses series";
+    m_seriesReady = false;
     if (m_expensesSeries) {
         delete m_expensesSeries;
     }
@@ -189,148 +141,34 @@ void CashFlowChart::prepareExpensesSeries(const QList<Expense> &expenses,
     // The idea is to collect all unique dates of the expenses.
     // If some expense has the same date as another, no unique points are added.
     // Only the general value of amount on this date is increased.
+    updateForecastEngine();
+    m_expensesDays = m_forecastEngine.expensesDays(expenses, bills, forecasts);
 
-    QDate limit = m_logicController->lastDate() > m_toDate ? m_logicController->lastDate() : m_toDate;
-    QVector<DateAmount> expensesDateAmounts; // temporaray storage of expenses.
-    for (const auto &expense : expenses) {
-        if (expense.isRecurrent() && m_logicController->isForecastingEnabled()) {
-            for (int i = 0; ; ++i) {
-                DateAmount dateAmount {expense.nextExpenseDate(), expense.plnTotal(), false, expense.isRecurrent()};
-                if (expense.recurrenceFrequency() == "weeks") { // might some new periods will appear (i.e. days, years etc.)
-                    dateAmount.date = dateAmount.date.addDays(7 * i);
-                } else if (expense.recurrenceFrequency() == "months") {
-                    dateAmount.date = dateAmount.date.addMonths(i);
-                }
-
-                if (dateAmount.date >= limit || i >= MAX_NUMBER_OF_FUTURE_EVENTS) {
-                    break;
-                }
-                expensesDateAmounts.append(dateAmount);
-            }
-        } else {
-            expensesDateAmounts.append(DateAmount {expense.date(), expense.plnTotal(), false, expense.isRecurrent()});
-        }
-    }
-
-    QVector<DateAmount> billsDateAmounts; // temporaray storage of bills.
-    for (const auto &bill : bills) {
-        if (bill.isRecurrent() && m_logicController->isForecastingEnabled()) {
-            for (int i = 0; ; ++i) {
-                DateAmount dateAmount {bill.nextBillDate(), bill.total(), false, bill.isRecurrent()};
-                if (bill.recurrence_frequency() == "weeks") { // might some new periods will appear (i.e. days, years etc.)
-                    dateAmount.date = dateAmount.date.addDays(7 * i);
-                } else if (bill.recurrence_frequency() == "months") {
-                    dateAmount.date = dateAmount.date.addMonths(i);
-                }
-
-                if (dateAmount.date > limit) {
-                    break;
-                }
-                billsDateAmounts.append(dateAmount);
-            }
-        } else {
-            billsDateAmounts.append(DateAmount {bill.dueDate().isValid() ? bill.dueDate() : bill.date(), bill.plnTotal(), false, bill.isRecurrent()});
-        }
-    }
-
-    QVector<DateAmount> forecastsDateAmounts; // temporaray storage of forecasts.
-    if (m_logicController->isForecastingEnabled()) {
-        for (const auto &forecast : forecasts) {
-            if (forecast.date.isValid() && m_logicController->firstDate() <= forecast.date) {
-                if (!forecast.isIncome) {
-                    if (forecast.isRecurrent) {
-                        // recurrent incomes follow the same pattern as usual once, but only added every month till the last data.
-                        for (int i = 0; ; ++i) {
-                            if (forecast.date.addMonths(i) > limit) {
-                                forecastsDateAmounts.append(DateAmount{forecast.date.addMonths(i), forecast.price, forecast.isIncome, forecast.isRecurrent});
-                                break;
-                            }
-                            forecastsDateAmounts.append(DateAmount{forecast.date.addMonths(i), forecast.price, forecast.isIncome, forecast.isRecurrent});
-                        }
-                    } else {
-                        forecastsDateAmounts.append(DateAmount {forecast.date, forecast.price, forecast.isIncome, forecast.isRecurrent});
-                    }
-                }
-            }
-        }
-    }
-
-    // if main storage of expenses and bills has an entry on this date, increase amount on this date. Otherwise, add new point.
-
-    for (DateAmount &expenseDateAmount: expensesDateAmounts) {
-        bool found = false;
-        for (DateAmount &dateAmount : m_dateAmounts) {
-            if (expenseDateAmount.date == dateAmount.date && !expenseDateAmount.isIncome && !dateAmount.isIncome) {
-                dateAmount.amount += expenseDateAmount.amount;
-                found = true;
-                break;
-            }
-        }
-        if (!found) {
-            m_dateAmounts.append(expenseDateAmount);
-        }
-    }
-
-    for (DateAmount &billDateAmount: billsDateAmounts) {
-        bool found = false;
-        for (DateAmount &dateAmount : m_dateAmounts) {
-            if (billDateAmount.date == dateAmount.date && !billDateAmount.isIncome && !dateAmount.isIncome) {
-                dateAmount.amount += billDateAmount.amount;
-                found = true;
-                break;
-            }
-        }
-        if (!found) {
-            m_dateAmounts.append(billDateAmount);
-        }
-    }
+    QDate dateAfterLast = m_forecastEngine.firstDate();
 
-    std::sort(m_dateAmounts.begin(), m_dateAmounts.end(), [](const DateAmount &a, const DateAmount &b) {
-        return a.date < b.date;
-    });
-
-    for (DateAmount &forecastDateAmount: forecastsDateAmounts) {
-        bool found = false;
-        for (DateAmount &dateAmount : m_dateAmounts) {
-            if (forecastDateAmount.date == dateAmount.date && !forecastDateAmount.isIncome && !dateAmount.isIncome) {
-                dateAmount.amount += forecastDateAmount.amount;
-                found = true;
-                break;
+    m_expensesPoints.clear();
+    m_expensesPoints.reserve(m_expensesDays.size() + 2);
+    for (const ForecastEngine::DayAmount &day : m_expensesDays) {
+        m_expensesPoints.append(QPointF(day.date.startOfDay().toMSecsSinceEpoch(), day.amount));
+        // calculating bounds of Y axe.
+        if (m_fromDate <= day.date && day.date <= m_toDate) {
+            if (day.amount > m_maxValue) {
+               m_maxValue = day.amount;
+            } else if (day.amount < m_minValue) {
+               m_minValue = day.amount;
             }
         }
-        if (!found) {
-            m_dateAmounts.append(forecastDateAmount);
-        }
-    }
-
-    std::sort(m_dateAmounts.begin(), m_dateAmounts.end(), [](const DateAmount &a, const DateAmount &b) {
-        return a.date < b.date;
-    });
 
-    QDate dateAfterLast = m_logicController->firstDate();
-
-    for (DateAmount &dateAmount : m_dateAmounts) {
-        if (!dateAmount.isIncome) {
-            m_expensesSeries->append(dateAmount.date.startOfDay().toMSecsSinceEpoch(), dateAmount.amount);
-            // calculating bounds of Y axe.
-            if (m_fromDate <= dateAmount.date && dateAmount.date <= m_toDate) {
-                if (dateAmount.amount > m_maxValue) {
-                   m_maxValue = dateAmount.amount;
-                } else if (dateAmount.amount < m_minValue) {
-                   m_minValue = dateAmount.amount;
-                }
-            }
-
-            if (dateAmount.date > dateAfterLast) {
-                dateAfterLast = dateAmount.date;
-            }
+        if (day.date > dateAfterLast) {
+            dateAfterLast = day.date;
         }
     }
 
-    if (m_logicController->isForecastingEnabled()) {
-        m_expensesSeries->append(dateAfterLast.startOfDay().toMSecsSinceEpoch(), 0);
-        m_expensesSeries->append(limit.startOfDay().toMSecsSinceEpoch(), 0);
+    if (m_forecastEngine.isForecastingEnabled()) {
+        m_expensesPoints.append(QPointF(dateAfterLast.startOfDay().toMSecsSinceEpoch(), 0));
+        m_expensesPoints.append(QPointF(m_forecastEngine.limit().startOfDay().toMSecsSinceEpoch(), 0));
     }
+    showPoints(m_expensesSeries, m_expensesPoints);
 
     addSeries(m_expensesSeries);
     m_expensesSeries->setVisible(false);
@@ -340,6 +178,12 @@ void CashFlowChart::prepareExpensesSeries(const QList<Expense> &expenses,
     qDebug() << "end Expenses series";
 }
 
+void CashFlowChart::updateForecastEngine()
+{
+    m_forecastEngine.setDates(m_logicController->firstDate(), m_logicController->lastDate(), m_fromDate, m_toDate);
+    m_forecastEngine.setForecastingEnabled(m_logicController->isForecastingEnabled());
+}
+
 void CashFlowChart::seriesDrawn()
 {
     if (m_expensesDrawn && m_incomesDrawn) {
@@ -363,27 +207,6 @@ void CashFlowChart::prepareCashFlowSeries()
 
     connect(m_cashFlowSeries, &QLineSeries::hovered, this, &CashFlowChart::seriesHovered);
 
-    // setting balance and cashflow for all periods. First period has balance equal to cashflow as there's no previous operations.
-    int i = 0;
-    for (auto pItr = m_periods.begin(); pItr != m_periods.end(); ++pItr) {
-        for (auto dItr = m_dateAmounts.begin(); dItr != m_dateAmounts.end(); ++dItr) {
-            if (pItr->startDate <= dItr->date && dItr->date <= pItr->endDate) {
-                if (dItr->isIncome) {
-                    pItr->balance += dItr->amount;
-                } else {
-                    pItr->balance -= dItr->amount;
-                }
-            }
-        }
-
-        if (i == 0) {
-            pItr->cashFlow = pItr->balance;
-            ++i;
-        } else {
-            pItr->cashFlow = (pItr-1)->cashFlow + pItr->balance;
-        }
-    }
-
     for (auto it = m_periods.begin(); it != m_periods.end(); ++it) {
         // calculating bounds of Y axe.
         if (m_fromDate <= it->startDate && it->endDate <= m_toDate) {
@@ -395,8 +218,10 @@ void CashFlowChart::prepareCashFlowSeries()
         }
     }
 
+    m_cashFlowPoints.clear();
+    m_cashFlowPoints.reserve(m_periods.size());
     for (auto itr = m_periods.begin(); itr != m_periods.end(); ++itr) {
-        m_cashFlowSeries->append(itr->startDate.startOfDay().addDays(14).toMSecsSinceEpoch(), itr->cashFlow);
+        m_cashFlowPoints.append(cashFlowPoint(*itr));
         // calculating bounds of Y axe.
         if (m_fromDate <= itr->startDate && itr->endDate <= m_toDate) {
             if (itr->cashFlow > m_maxValue) {
@@ -407,9 +232,11 @@ void CashFlowChart::prepareCashFlowSeries()
         }
     }
 
+    showPoints(m_cashFlowSeries, m_cashFlowPoints);
     addSeries(m_cashFlowSeries);
     m_cashFlowSeries->setVisible(false);
-    m_dateAmounts.clear();
+    m_seriesWithForecasts = m_forecastEngine.isForecastingEnabled();
+    m_seriesReady = true;
     emit cashFlowSeriesDrawn();
 }
 
@@ -455,27 +282,171 @@ void CashFlowChart::setCashFlowPointsVisible(bool state) {
 }
 
 void CashFlowChart::setupPeriods() {
-    // creating periods from first date to last date of records. Each period is one month.
-    m_periods.clear();
-    QDate start = m_logicController->firstDate() < m_fromDate ? m_logicController->firstDate() : m_fromDate;
-    QDate limit = m_logicController->lastDate() > m_toDate ? m_logicController->lastDate() : m_toDate;
-    QDate date(start.year(), start.month(), 1);
-    for (int i = 0; ; ++i) {
-        Period period;
-        period.startDate = date;
-        period.endDate = date.addMonths(1).addDays(-1);
-        if (limit <= period.startDate || period.endDate >= limit) {
-            m_periods.append(period);
-            break;
-        }
-        m_periods.append(period);
-        date = period.endDate.addDays(1);
-    }
+    // creating periods from first date to last date of records. Days are sorted by the forecast engine,
+    // so they are binned in a single pass and balance and cash flow of every period come from prefix sums.
+    PeriodEngine periodEngine;
+    periodEngine.setPoints(ForecastEngine::points(m_incomeDays, m_expensesDays));
+    m_periods = periodEngine.periods(m_forecastEngine.start(), m_forecastEngine.limit(), PeriodEngine::Monthly);
 }
 
 void CashFlowChart::setDates(const QDate &fromDate, const QDate &toDate) {
     m_fromDate = fromDate;
     m_toDate = toDate;
+    m_seriesReady = false; // built series cover previous dates.
+}
+
+bool CashFlowChart::updateForecast(const ForecastingModel::Forecast &previous, const ForecastingModel::Forecast &current)
+{
+    if (!m_seriesReady || m_seriesWithForecasts != m_logicController->isForecastingEnabled()) {
+        return false;
+    }
+
+    if (previous.date == current.date && previous.price == current.price
+            && previous.isIncome == current.isIncome && previous.isRecurrent == current.isRecurrent) {
+        return true; // only the name has been changed.
+    }
+
+    // single points are replaced only if series are drawn without downsampling, otherwise the drawn points are picked again.
+    const bool patchCashFlow = m_cashFlowSeries->count() == m_cashFlowPoints.size();
+    int firstPeriod = m_periods.size();
+    applyForecast(previous, -1, firstPeriod);
+    applyForecast(current, 1, firstPeriod);
+
+    // cash flow is cumulative, so every period after the first touched one moves.
+    double cashFlow = firstPeriod > 0 && firstPeriod <= m_periods.size() ? m_periods.at(firstPeriod - 1).cashFlow : 0.0;
+    for (int i = firstPeriod; i < m_periods.size(); ++i) {
+        PeriodEngine::Period &period = m_periods[i];
+        cashFlow += period.balance;
+        period.cashFlow = cashFlow;
+        m_cashFlowPoints[i] = cashFlowPoint(period);
+        if (patchCashFlow) {
+            m_cashFlowSeries->replace(i, m_cashFlowPoints.at(i));
+        }
+        if (m_fromDate <= period.startDate && period.endDate <= m_toDate) {
+            extendYAxeRange(period.balance);
+            extendYAxeRange(period.cashFlow);
+        }
+    }
+
+    if (!patchCashFlow) {
+        showPoints(m_cashFlowSeries, m_cashFlowPoints);
+    }
+    if (m_incomeSeries->count() != m_incomePoints.size()) {
+        showPoints(m_incomeSeries, m_incomePoints);
+    }
+    if (m_expensesSeries->count() != m_expensesPoints.size()) {
+        showPoints(m_expensesSeries, m_expensesPoints);
+    }
+
+    if (m_yValueAxis) {
+        m_yValueAxis->setRange(m_minValue, m_maxValue);
+        m_yValueAxis->applyNiceNumbers();
+    }
+    return true;
+}
+
+void CashFlowChart::applyForecast(const ForecastingModel::Forecast &forecast, int sign, int &firstPeriod)
+{
+    const double amount = sign * forecast.price;
+    for (const QDate &date : m_forecastEngine.forecastOccurrences(forecast)) {
+        if (forecast.isIncome) {
+            addToDay(m_incomeSeries, m_incomePoints, m_incomeDays, ForecastEngine::DayAmount {date, amount, sign});
+        } else {
+            addToDay(m_expensesSeries, m_expensesPoints, m_expensesDays, ForecastEngine::DayAmount {date, amount, sign});
+        }
+
+        auto period = std::upper_bound(m_periods.begin(), m_periods.end(), date, [](const QDate &occurrence, const PeriodEngine::Period &entry) {
+            return occurrence < entry.startDate;
+        });
+        if (period == m_periods.begin() || date > (period - 1)->endDate) {
+            continue; // occurrence is outside of the periods of the chart.
+        }
+        --period;
+        if (forecast.isIncome) {
+            period->incomeSum += amount;
+        } else {
+            period->expensesSum += amount;
+        }
+        period->balance = period->incomeSum - period->expensesSum;
+        firstPeriod = qMin(firstPeriod, int(period - m_periods.begin()));
+    }
+}
+
+void CashFlowChart::addToDay(QLineSeries *series, QVector<QPointF> &points, QVector<ForecastEngine::DayAmount> &days,
+                             const ForecastEngine::DayAmount &change)
+{
+    const bool patchSeries = series->count() == points.size();
+    auto day = std::lower_bound(days.begin(), days.end(), change.date, [](const ForecastEngine::DayAmount &entry, const QDate &date) {
+        return entry.date < date;
+    });
+    const int index = day - days.begin();
+
+    if (day != days.end() && day->date == change.date) {
+        day->amount += change.amount;
+        day->count += change.count;
+        if (day->count <= 0) {
+            days.erase(day);
+            points.remove(index);
+            if (patchSeries) {
+                series->remove(index);
+            }
+        } else {
+            points[index] = QPointF(change.date.startOfDay().toMSecsSinceEpoch(), day->amount);
+            if (patchSeries) {
+                series->replace(index, points.at(index));
+            }
+            if (m_fromDate <= change.date && change.date <= m_toDate) {
+                extendYAxeRange(day->amount);
+            }
+        }
+    } else if (change.count > 0) {
+        days.insert(day, change);
+        points.insert(index, QPointF(change.date.startOfDay().toMSecsSinceEpoch(), change.amount));
+        if (patchSeries) {
+            series->insert(index, points.at(index));
+        }
+        if (m_fromDate <= change.date && change.date <= m_toDate) {
+            extendYAxeRange(change.amount);
+        }
+    }
+
+    // series end with a zero point after the last day and another one at the limit of the chart.
+    QDate dateAfterLast = m_forecastEngine.firstDate();
+    if (!days.isEmpty() && days.last().date > dateAfterLast) {
+        dateAfterLast = days.last().date;
+    }
+    points[days.size()] = QPointF(dateAfterLast.startOfDay().toMSecsSinceEpoch(), 0);
+    if (patchSeries) {
+        series->replace(days.size(), points.at(days.size()));
+    }
+}
+
+void CashFlowChart::showPoints(QLineSeries *series, const QVector<QPointF> &points)
+{
+    if (!series) {
+        return;
+    }
+
+    // a pixel column covers the same time on the whole series, so the part outside of the displayed dates is reduced alike.
+    const double width = plotArea().width() >= 1 ? plotArea().width() : DEFAULT_PLOT_WIDTH;
+    const double columnWidth = m_fromDate.startOfDay().msecsTo(m_toDate.startOfDay()) / width;
+    series->replace(Downsampler::minMaxPerColumn(points, columnWidth));
+}
+
+QPointF CashFlowChart::cashFlowPoint(const PeriodEngine::Period &period) const
+{
+    // points are placed in the middle of their periods.
+    const qint64 middle = period.startDate.daysTo(period.endDate) / 2;
+    return QPointF(period.startDate.startOfDay().addDays(middle).toMSecsSinceEpoch(), period.cashFlow);
+}
+
+void CashFlowChart::extendYAxeRange(double value)
+{
+    if (value > m_maxValue) {
+        m_maxValue = value;
+    } else if (value < m_minValue) {
+        m_minValue = value;
+    }
 }
 
 void CashFlowChart::resetYAxeRanges() {
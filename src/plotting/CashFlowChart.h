@@ -15,6 +15,8 @@
 #include "datasets/Bill.h"
 #include "datasets/Expense.h"
 #include "models/ForecastingModel.h"
+#include "plotting/ForecastEngine.h"
+#include "plotting/PeriodEngine.h"
 
 QT_CHARTS_USE_NAMESPACE
 
@@ -92,6 +94,15 @@ public:
      */
     void setDates(const QDate &fromDate, const QDate &toDate);
 
+    /*!
+     * \brief Applies a change of a single forecast to the built series instead of preparing them again.
+     * Occurrences of the previous forecast are subtracted, occurrences of the current one are added
+     * and only the touched points are replaced. Returns false if series have to be prepared from scratch.
+     * \param const ForecastingModel::Forecast &previous -- forecast before the change, with an invalid date if it has just been added.
+     * \param const ForecastingModel::Forecast &current -- forecast after the change, with an invalid date if it has been removed.
+     */
+    bool updateForecast(const ForecastingModel::Forecast &previous, const ForecastingModel::Forecast &current);
+
     /*!
      * \brief Resets bounds of Y axe.
      */
@@ -139,29 +150,21 @@ private:
     QDateTimeAxis *m_xTimeAxis = nullptr;
     QValueAxis *m_yValueAxis = nullptr;
 
-    struct DateAmount {
-        QDate date;
-        double amount;
-        bool isIncome;
-        bool isRecurrent;
-    };
-
-    QList<DateAmount> m_dateAmounts;
-
-    struct Period {
-        QDate startDate;
-        QDate endDate;
+    ForecastEngine m_forecastEngine; // dates and forecasting state the series have been built with.
+    QVector<ForecastEngine::DayAmount> m_incomeDays; // days of the income series, in the same order as its points.
+    QVector<ForecastEngine::DayAmount> m_expensesDays; // days of the expenses series, in the same order as its points.
 
-        double balance =  0.0;
-        double incomeSum = 0.0;
-        double expensesSum = 0.0;
-        double cashFlow = 0.0;
-    };
+    // all the points of the series, only a part of them is drawn when there are more points than pixels.
+    QVector<QPointF> m_incomePoints;
+    QVector<QPointF> m_expensesPoints;
+    QVector<QPointF> m_cashFlowPoints;
 
-    QList<Period> m_periods;
+    QVector<PeriodEngine::Period> m_periods; // monthly periods of the cash flow series.
 
     bool m_incomesDrawn = false;
     bool m_expensesDrawn = false;
+    bool m_seriesReady = false;
+    bool m_seriesWithForecasts = false;
 
     QDate m_fromDate;
     QDate m_toDate;
@@ -178,6 +181,13 @@ private:
     void seriesDrawn();
     void cashFlowDrawn();
     void setupPeriods();
+    void updateForecastEngine();
+    void applyForecast(const ForecastingModel::Forecast &forecast, int sign, int &firstPeriod);
+    void addToDay(QLineSeries *series, QVector<QPointF> &points, QVector<ForecastEngine::DayAmount> &days,
+                  const ForecastEngine::DayAmount &change);
+    void showPoints(QLineSeries *series, const QVector<QPointF> &points);
+    QPointF cashFlowPoint(const PeriodEngine::Period &period) const;
+    void extendYAxeRange(double value);
 };
 
 #endif // CASHFLOWCHART_H
@@ -0,0 +1,54 @@
+// <copyright company="Scythe Studio Sp. z o.o.">
+//     This file contains proprietary code. Copyright (c) 2021. All rights reserved.
+// </copyright>
+
+#include "Downsampler.h"
+#include <cmath>
+
+#define POINTS_PER_COLUMN 4
+
+QVector<QPointF> Downsampler::minMaxPerColumn(const QVector<QPointF> &points, double columnWidth)
+{
+    if (columnWidth <= 0 || points.size() <= POINTS_PER_COLUMN) {
+        return points;
+    }
+
+    const double origin = points.first().x();
+    const double columns = std::floor((points.last().x() - origin) / columnWidth) + 1;
+    if (points.size() <= columns * POINTS_PER_COLUMN) {
+        return points; // every column has already few enough points.
+    }
+
+    QVector<QPointF> result;
+    result.reserve(int(columns) * POINTS_PER_COLUMN); // smaller than number of points, checked above.
+    int i = 0;
+    while (i < points.size()) {
+        const double column = std::floor((points.at(i).x() - origin) / columnWidth);
+        const int first = i;
+        int lowest = i;
+        int highest = i;
+        for (++i; i < points.size() && std::floor((points.at(i).x() - origin) / columnWidth) == column; ++i) {
+            if (points.at(i).y() < points.at(lowest).y()) {
+                lowest = i;
+            } else if (points.at(i).y() > points.at(highest).y()) {
+                highest = i;
+            }
+        }
+        const int last = i - 1;
+
+        // kept points are appended in order of X values, each of them once.
+        const int middle[] = { qMin(lowest, highest), qMax(lowest, highest) };
+        result.append(points.at(first));
+        int previous = first;
+        for (int index : middle) {
+            if (index != previous && index != last) {
+                result.append(points.at(index));
+                previous = index;
+            }
+        }
+        if (last != first) {
+            result.append(points.at(last));
+        }
+    }
+    return result;
+}
@@ -0,0 +1,28 @@
+// <copyright company="Scythe Studio Sp. z o.o.">
+//     This file contains proprietary code. Copyright (c) 2021. All rights reserved.
+// </copyright>
+
+#ifndef DOWNSAMPLER_H
+#define DOWNSAMPLER_H
+
+#include <QPointF>
+#include <QVector>
+
+/*!
+ * \brief Class reducing number of points of a series to the number of pixel columns they are drawn on.
+ */
+class Downsampler
+{
+public:
+
+    /*!
+     * \brief Returns points to draw instead of the given ones. Points are split into columns of the given width
+     * and only the first, the lowest, the highest and the last point of every column are kept, so peaks stay visible
+     * and lines between the columns are unchanged. Returns the points untouched if nothing could be removed.
+     * \param const QVector<QPointF> &points -- points sorted by X value.
+     * \param double columnWidth -- width of a single pixel column in units of X axe.
+     */
+    static QVector<QPointF> minMaxPerColumn(const QVector<QPointF> &points, double columnWidth);
+};
+
+#endif // DOWNSAMPLER_H
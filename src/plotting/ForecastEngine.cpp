@@ -0,0 +1,172 @@
+// <copyright company="Scythe Studio Sp. z o.o.">
+//     This file contains proprietary code. Copyright (c) 2021. All rights reserved.
+// </copyright>
+
+#include "ForecastEngine.h"
+#include "datasets/Recurrence.h"
+#include <algorithm>
+
+ForecastEngine::ForecastEngine()
+{
+}
+
+void ForecastEngine::setDates(const QDate &firstDate, const QDate &lastDate, const QDate &fromDate, const QDate &toDate)
+{
+    m_firstDate = firstDate;
+    m_lastDate = lastDate;
+    m_fromDate = fromDate;
+    m_toDate = toDate;
+}
+
+bool ForecastEngine::isForecastingEnabled() const
+{
+    return m_forecastingEnabled;
+}
+
+void ForecastEngine::setForecastingEnabled(bool value)
+{
+    m_forecastingEnabled = value;
+}
+
+QDate ForecastEngine::firstDate() const
+{
+    return m_firstDate;
+}
+
+QDate ForecastEngine::start() const
+{
+    return m_firstDate < m_fromDate ? m_firstDate : m_fromDate;
+}
+
+QDate ForecastEngine::limit() const
+{
+    return m_lastDate > m_toDate ? m_lastDate : m_toDate;
+}
+
+QVector<ForecastEngine::DayAmount> ForecastEngine::incomeDays(const QList<Invoice> &invoices,
+                                                              const QList<ForecastingModel::Forecast> &forecasts) const
+{
+    return incomeDays(TransactionColumns::fromInvoices(invoices), forecasts);
+}
+
+QVector<ForecastEngine::DayAmount> ForecastEngine::incomeDays(const TransactionColumns &invoices,
+                                                              const QList<ForecastingModel::Forecast> &forecasts) const
+{
+    QVector<DayAmount> days;
+    days.reserve(invoices.size());
+    appendDocumentDays(invoices, days);
+    appendForecastDays(forecasts, true, days);
+
+    aggregate(days);
+    return days;
+}
+
+QVector<ForecastEngine::DayAmount> ForecastEngine::expensesDays(const QList<Expense> &expenses, const QList<Bill> &bills,
+                                                                const QList<ForecastingModel::Forecast> &forecasts) const
+{
+    return expensesDays(TransactionColumns::fromExpenses(expenses), TransactionColumns::fromBills(bills), forecasts);
+}
+
+QVector<ForecastEngine::DayAmount> ForecastEngine::expensesDays(const TransactionColumns &expenses, const TransactionColumns &bills,
+                                                                const QList<ForecastingModel::Forecast> &forecasts) const
+{
+    QVector<DayAmount> days;
+    days.reserve(expenses.size() + bills.size());
+    appendDocumentDays(expenses, days);
+    appendDocumentDays(bills, days);
+    appendForecastDays(forecasts, false, days);
+
+    aggregate(days);
+    return days;
+}
+
+QVector<QDate> ForecastEngine::forecastOccurrences(const ForecastingModel::Forecast &forecast) const
+{
+    QVector<QDate> dates;
+    if (!m_forecastingEnabled || !forecast.date.isValid() || forecast.date < m_firstDate) {
+        return dates;
+    }
+
+    if (forecast.isRecurrent) {
+        // recurrent forecasts follow the same pattern as usual once, but only added every month till the last data.
+        Recurrence(forecast.date, Recurrence::Months).forEachOccurrence(start(), limit(), [&](const QDate &date) {
+            dates.append(date);
+        });
+    } else {
+        dates.append(forecast.date);
+    }
+    return dates;
+}
+
+QVector<PeriodEngine::Point> ForecastEngine::points(const QVector<DayAmount> &incomeDays, const QVector<DayAmount> &expensesDays)
+{
+    // both lists are sorted, so they are merged instead of sorting the points again.
+    QVector<PeriodEngine::Point> points;
+    points.reserve(incomeDays.size() + expensesDays.size());
+    int income = 0;
+    int expense = 0;
+    while (income < incomeDays.size() || expense < expensesDays.size()) {
+        const bool takeIncome = expense == expensesDays.size()
+                || (income < incomeDays.size() && incomeDays.at(income).date <= expensesDays.at(expense).date);
+        const DayAmount &day = takeIncome ? incomeDays.at(income++) : expensesDays.at(expense++);
+        points.append(PeriodEngine::Point {day.date, day.amount, takeIncome});
+    }
+    return points;
+}
+
+void ForecastEngine::appendDocumentDays(const TransactionColumns &columns, QVector<DayAmount> &days) const
+{
+    // recurrent rows are expanded below, so with forecasting enabled they are skipped in the scan of the columns.
+    const quint8 skipped = m_forecastingEnabled ? TransactionColumns::Recurrent : 0;
+    const qint32 *bookingDays = columns.bookingDays().constData();
+    const double *amounts = columns.plnAmounts().constData();
+    const quint8 *flags = columns.flags().constData();
+    for (int i = 0; i < columns.size(); ++i) {
+        if ((flags[i] & skipped) == 0) {
+            days.append(DayAmount {TransactionColumns::date(bookingDays[i]), amounts[i], 1});
+        }
+    }
+
+    if (!m_forecastingEnabled) {
+        return;
+    }
+
+    // only occurrences of recurrent documents falling within the periods of the chart are generated.
+    for (int i = 0; i < columns.recurrentRows().size(); ++i) {
+        const double amount = amounts[columns.recurrentRows().at(i)];
+        columns.recurrences().at(i).forEachOccurrence(start(), limit(), [&](const QDate &date) {
+            days.append(DayAmount {date, amount, 1});
+        });
+    }
+}
+
+void ForecastEngine::appendForecastDays(const QList<ForecastingModel::Forecast> &forecasts, bool isIncome, QVector<DayAmount> &days) const
+{
+    for (const auto &forecast : forecasts) {
+        if (forecast.isIncome == isIncome) {
+            for (const QDate &date : forecastOccurrences(forecast)) {
+                days.append(DayAmount {date, forecast.price, 1});
+            }
+        }
+    }
+}
+
+void ForecastEngine::aggregate(QVector<DayAmount> &days)
+{
+    // days are sorted, so amounts to be summed up are adjacent and merged in a single pass.
+    std::sort(days.begin(), days.end(), [](const DayAmount &a, const DayAmount &b) {
+        return a.date < b.date;
+    });
+
+    int last = -1;
+    for (int i = 0; i < days.size(); ++i) {
+        const DayAmount &day = days.at(i);
+        if (last >= 0 && days.at(last).date == day.date) {
+            days[last].amount += day.amount;
+            days[last].count += day.count;
+        } else if (++last != i) {
+            days[last] = day;
+        }
+    }
+    days.resize(last + 1);
+}
@@ -0,0 +1,134 @@
+// <copyright company="Scythe Studio Sp. z o.o.">
+//     This file contains proprietary code. Copyright (c) 2021. All rights reserved.
+// </copyright>
+
+#ifndef FORECASTENGINE_H
+#define FORECASTENGINE_H
+
+#include <QDate>
+#include <QList>
+#include <QVector>
+#include "datasets/Invoice.h"
+#include "datasets/Bill.h"
+#include "datasets/Expense.h"
+#include "datasets/TransactionStore.h"
+#include "models/ForecastingModel.h"
+#include "plotting/PeriodEngine.h"
+
+/*!
+ * \brief Class turning invoices, expenses, bills and forecasts into daily incomes and expenses.
+ * Recurrent documents and forecasts are expanded within the dates of the chart. The class has no dependency
+ * on widgets or charts, so it is shared by the chart and by the headless mode.
+ */
+class ForecastEngine
+{
+public:
+
+    /*!
+     * \brief Sum of incomes or expenses of a single day.
+     */
+    struct DayAmount {
+        QDate date;
+        double amount;
+        int count; // number of documents summed up in this day.
+    };
+
+    /*!
+     * \brief Constructor.
+     */
+    ForecastEngine();
+
+    /*!
+     * \brief Sets dates of the financial history and of the displayed part of it.
+     * \param const QDate &firstDate -- first date of the financial history.
+     * \param const QDate &lastDate -- last date of the financial history.
+     * \param const QDate &fromDate -- first displayed date.
+     * \param const QDate &toDate -- last displayed date.
+     */
+    void setDates(const QDate &firstDate, const QDate &lastDate, const QDate &fromDate, const QDate &toDate);
+
+    /*!
+     * \brief Returns true if recurrent documents and forecasts are expanded. Otherwise false.
+     */
+    bool isForecastingEnabled() const;
+
+    /*!
+     * \brief Sets state of the forecasting functionality enabled.
+     * \param bool value -- value to set.
+     */
+    void setForecastingEnabled(bool value);
+
+    /*!
+     * \brief Returns first date of the financial history.
+     */
+    QDate firstDate() const;
+
+    /*!
+     * \brief Returns the earliest date covered by periods, the first date of history or the first displayed one.
+     */
+    QDate start() const;
+
+    /*!
+     * \brief Returns the latest date covered by periods, the last date of history or the last displayed one.
+     */
+    QDate limit() const;
+
+    /*!
+     * \brief Returns incomes of invoices and income forecasts summed up by day, sorted by date.
+     * \param const QList<Invoice> &invoices -- list of invoices.
+     * \param const QList<ForecastingModel::Forecast> &forecasts -- list of forecasts.
+     */
+    QVector<DayAmount> incomeDays(const QList<Invoice> &invoices, const QList<ForecastingModel::Forecast> &forecasts) const;
+
+    /*!
+     * \brief Returns incomes of invoices and income forecasts summed up by day, sorted by date.
+     * \param const TransactionColumns &invoices -- columns of invoices.
+     * \param const QList<ForecastingModel::Forecast> &forecasts -- list of forecasts.
+     */
+    QVector<DayAmount> incomeDays(const TransactionColumns &invoices, const QList<ForecastingModel::Forecast> &forecasts) const;
+
+    /*!
+     * \brief Returns expenses of expenses, bills and expense forecasts summed up by day, sorted by date.
+     * \param const QList<Expense> &expenses -- list of expenses.
+     * \param const QList<Bill> &bills -- list of bills.
+     * \param const QList<ForecastingModel::Forecast> &forecasts -- list of forecasts.
+     */
+    QVector<DayAmount> expensesDays(const QList<Expense> &expenses, const QList<Bill> &bills,
+                                    const QList<ForecastingModel::Forecast> &forecasts) const;
+
+    /*!
+     * \brief Returns expenses of expenses, bills and expense forecasts summed up by day, sorted by date.
+     * \param const TransactionColumns &expenses -- columns of expenses.
+     * \param const TransactionColumns &bills -- columns of bills.
+     * \param const QList<ForecastingModel::Forecast> &forecasts -- list of forecasts.
+     */
+    QVector<DayAmount> expensesDays(const TransactionColumns &expenses, const TransactionColumns &bills,
+                                    const QList<ForecastingModel::Forecast> &forecasts) const;
+
+    /*!
+     * \brief Returns dates the forecast falls on. Recurrent forecasts repeat every month till the limit.
+     * \param const ForecastingModel::Forecast &forecast -- forecast to expand.
+     */
+    QVector<QDate> forecastOccurrences(const ForecastingModel::Forecast &forecast) const;
+
+    /*!
+     * \brief Returns points for PeriodEngine made of incomes and expenses of days, sorted by date.
+     * \param const QVector<DayAmount> &incomeDays -- incomes sorted by date.
+     * \param const QVector<DayAmount> &expensesDays -- expenses sorted by date.
+     */
+    static QVector<PeriodEngine::Point> points(const QVector<DayAmount> &incomeDays, const QVector<DayAmount> &expensesDays);
+
+private:
+    void appendDocumentDays(const TransactionColumns &columns, QVector<DayAmount> &days) const;
+    void appendForecastDays(const QList<ForecastingModel::Forecast> &forecasts, bool isIncome, QVector<DayAmount> &days) const;
+    static void aggregate(QVector<DayAmount> &days);
+
+    QDate m_firstDate;
+    QDate m_lastDate;
+    QDate m_fromDate;
+    QDate m_toDate;
+
+    bool m_forecastingEnabled = true;
+};
+
+#endif // FORECASTENGINE_H
@@ -0,0 +1,155 @@
+// <copyright company="Scythe Studio Sp. z o.o.">
+//     This file contains proprietary code. Copyright (c) 2021. All rights reserved.
+// </copyright>
+
+#include "PeriodEngine.h"
+#include <algorithm>
+
+PeriodEngine::PeriodEngine()
+{
+    clear();
+}
+
+void PeriodEngine::setPoints(const QVector<Point> &points)
+{
+    clear();
+    m_days.reserve(points.size());
+    m_incomePrefixSums.reserve(points.size() + 1);
+    m_expensesPrefixSums.reserve(points.size() + 1);
+
+    for (const Point &point : points) {
+        if (!point.date.isValid()) {
+            continue;
+        }
+
+        const qint64 day = point.date.toJulianDay();
+        Q_ASSERT(m_days.isEmpty() || m_days.last() <= day);
+        if (m_days.isEmpty() || m_days.last() != day) {
+            m_days.append(day);
+            m_incomePrefixSums.append(m_incomePrefixSums.last());
+            m_expensesPrefixSums.append(m_expensesPrefixSums.last());
+        }
+
+        if (point.isIncome) {
+            m_incomePrefixSums.last() += point.amount;
+        } else {
+            m_expensesPrefixSums.last() += point.amount;
+        }
+    }
+}
+
+void PeriodEngine::clear()
+{
+    m_days.clear();
+    m_incomePrefixSums = {0.0};
+    m_expensesPrefixSums = {0.0};
+}
+
+bool PeriodEngine::isEmpty() const
+{
+    return m_days.isEmpty();
+}
+
+double PeriodEngine::incomeSum(const QDate &from, const QDate &to) const
+{
+    const int first = lowerBound(from);
+    const int last = qMax(first, upperBound(to));
+    return m_incomePrefixSums.at(last) - m_incomePrefixSums.at(first);
+}
+
+double PeriodEngine::expensesSum(const QDate &from, const QDate &to) const
+{
+    const int first = lowerBound(from);
+    const int last = qMax(first, upperBound(to));
+    return m_expensesPrefixSums.at(last) - m_expensesPrefixSums.at(first);
+}
+
+double PeriodEngine::balance(const QDate &from, const QDate &to) const
+{
+    return incomeSum(from, to) - expensesSum(from, to);
+}
+
+QVector<PeriodEngine::Period> PeriodEngine::periods(const QDate &start, const QDate &limit, Granularity granularity) const
+{
+    QVector<Period> periods;
+    if (!start.isValid() || !limit.isValid()) {
+        return periods;
+    }
+
+    // periods are consecutive, so days are walked once instead of being searched for every period.
+    QDate date = periodStart(start, granularity);
+    int first = lowerBound(date);
+    double cashFlow = 0.0;
+    for (;;) {
+        Period period;
+        period.startDate = date;
+        period.endDate = nextPeriodStart(date, granularity).addDays(-1);
+
+        const qint64 endDay = period.endDate.toJulianDay();
+        int last = first;
+        while (last < m_days.size() && m_days.at(last) <= endDay) {
+            ++last;
+        }
+
+        period.incomeSum = m_incomePrefixSums.at(last) - m_incomePrefixSums.at(first);
+        period.expensesSum = m_expensesPrefixSums.at(last) - m_expensesPrefixSums.at(first);
+        period.balance = period.incomeSum - period.expensesSum;
+        cashFlow += period.balance;
+        period.cashFlow = cashFlow;
+        periods.append(period);
+
+        if (period.endDate >= limit) {
+            break;
+        }
+        date = period.endDate.addDays(1);
+        first = last;
+    }
+
+    return periods;
+}
+
+QDate PeriodEngine::periodStart(const QDate &date, Granularity granularity)
+{
+    switch (granularity) {
+    case Daily:
+        return date;
+    case Weekly:
+        return date.addDays(1 - date.dayOfWeek());
+    case Monthly:
+        return QDate(date.year(), date.month(), 1);
+    case Quarterly:
+        return QDate(date.year(), (date.month() - 1) / 3 * 3 + 1, 1);
+    }
+    return date;
+}
+
+QDate PeriodEngine::nextPeriodStart(const QDate &start, Granularity granularity)
+{
+    switch (granularity) {
+    case Daily:
+        return start.addDays(1);
+    case Weekly:
+        return start.addDays(7);
+    case Monthly:
+        return start.addMonths(1);
+    case Quarterly:
+        return start.addMonths(3);
+    }
+    return start.addDays(1);
+}
+
+int PeriodEngine::lowerBound(const QDate &date) const
+{
+    if (!date.isValid()) {
+        return 0;
+    }
+    return int(std::lower_bound(m_days.constBegin(), m_days.constEnd(), date.toJulianDay()) - m_days.constBegin());
+}
+
+int PeriodEngine::upperBound(const QDate &date) const
+{
+    if (!date.isValid()) {
+        return m_days.size();
+    }
+    return int(std::upper_bound(m_days.constBegin(), m_days.constEnd(), date.toJulianDay()) - m_days.constBegin());
+}
@@ -0,0 +1,125 @@
+// <copyright company="Scythe Studio Sp. z o.o.">
+//     This file contains proprietary code. Copyright (c) 2021. All rights reserved.
+// </copyright>
+
+#ifndef PERIODENGINE_H
+#define PERIODENGINE_H
+
+#include <QDate>
+#include <QVector>
+
+/*!
+ * \brief Class representing daily incomes and expenses stored as prefix sums.
+ * Sums and balance of any range of dates are answered in O(log n), periods of the chart are built in a single pass.
+ */
+class PeriodEngine
+{
+public:
+
+    /*!
+     * \brief Length of a single period of the cash flow.
+     */
+    enum Granularity {
+        Daily,
+        Weekly, // weeks start on Monday.
+        Monthly,
+        Quarterly
+    };
+
+    /*!
+     * \brief Income or expense of a single day.
+     */
+    struct Point {
+        QDate date;
+        double amount;
+        bool isIncome;
+    };
+
+    /*!
+     * \brief Sums of a single period. Cash flow is the cumulative balance of all the periods up to this one.
+     */
+    struct Period {
+        QDate startDate;
+        QDate endDate;
+
+        double balance = 0.0;
+        double incomeSum = 0.0;
+        double expensesSum = 0.0;
+        double cashFlow = 0.0;
+    };
+
+    /*!
+     * \brief Constructor.
+     */
+    PeriodEngine();
+
+    /*!
+     * \brief Replaces stored points. Points have to be sorted by date, points of the same day are summed up.
+     * \param const QVector<Point> &points -- points to store.
+     */
+    void setPoints(const QVector<Point> &points);
+
+    /*!
+     * \brief Removes all the points.
+     */
+    void clear();
+
+    /*!
+     * \brief Returns true if no points are stored. Otherwise false.
+     */
+    bool isEmpty() const;
+
+    /*!
+     * \brief Returns sum of incomes between 'from' and 'to' (both inclusive).
+     * \param const QDate &from -- first date of the range.
+     * \param const QDate &to -- last date of the range.
+     */
+    double incomeSum(const QDate &from, const QDate &to) const;
+
+    /*!
+     * \brief Returns sum of expenses between 'from' and 'to' (both inclusive).
+     * \param const QDate &from -- first date of the range.
+     * \param const QDate &to -- last date of the range.
+     */
+    double expensesSum(const QDate &from, const QDate &to) const;
+
+    /*!
+     * \brief Returns incomes decreased by expenses between 'from' and 'to' (both inclusive).
+     * \param const QDate &from -- first date of the range.
+     * \param const QDate &to -- last date of the range.
+     */
+    double balance(const QDate &from, const QDate &to) const;
+
+    /*!
+     * \brief Returns consecutive periods covering dates from 'start' to 'limit'. The first period begins
+     * at the beginning of the period containing 'start', the last one contains 'limit'.
+     * \param const QDate &start -- first date to cover.
+     * \param const QDate &limit -- last date to cover.
+     * \param Granularity granularity -- length of periods.
+     */
+    QVector<Period> periods(const QDate &start, const QDate &limit, Granularity granularity) const;
+
+    /*!
+     * \brief Returns the first day of the period containing the given date.
+     * \param const QDate &date -- date to check.
+     * \param Granularity granularity -- length of periods.
+     */
+    static QDate periodStart(const QDate &date, Granularity granularity);
+
+    /*!
+     * \brief Returns the first day of the period following the one starting at the given date.
+     * \param const QDate &start -- first day of a period.
+     * \param Granularity granularity -- length of periods.
+     */
+    static QDate nextPeriodStart(const QDate &start, Granularity granularity);
+
+private:
+    int lowerBound(const QDate &date) const;
+    int upperBound(const QDate &date) const;
+
+    QVector<qint64> m_days; // julian days having any points, ascending.
+    QVector<double> m_incomePrefixSums; // sum of incomes of days before the day at the same position. One item longer than days.
+    QVector<double> m_expensesPrefixSums; // sum of expenses of days before the day at the same position. One item longer than days.
+};
+
+#endif // PERIODENGINE_H
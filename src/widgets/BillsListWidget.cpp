@@ -6,6 +6,7 @@
 #include "ui_BillsListWidget.h"
 #include <models/BillsModel.h>
 #include <delegates/CenteredCheckBoxDelegate.h>
+#include "FilteringController.h"
 #include <QDebug>
 
 BillsListWidget::BillsListWidget(BillsModel *model, QWidget *parent)
@@ -23,24 +24,15 @@ BillsListWidget::BillsListWidget(BillsModel *model, QWidget *parent)
     ui->billsTableView->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
     ui->billsTableView->setSortingEnabled(true);
 
-    connect(ui->searchLineEdit, &QLineEdit::textChanged, proxyModel, &BillsProxyModel::setFilteringPattern);
+    // typing is coalesced and searched in the background, the table is filtered once the rows are found.
+    FilteringController *filteringController = new FilteringController(this);
+    filteringController->setSearchIndexProvider([proxyModel] { return proxyModel->searchIndex(); });
+    connect(ui->searchLineEdit, &QLineEdit::textChanged, filteringController, &FilteringController::setPattern);
+    connect(filteringController, &FilteringController::matchingRowsReady, proxyModel, &BillsProxyModel::setMatchingRows);
+    connect(proxyModel, &BillsProxyModel::filteredTotalChanged, this, &BillsListWidget::filteredTotalChanged);
     connect(ui->hideNormalCheckBox, &QCheckBox::stateChanged, proxyModel, &BillsProxyModel::setHideNormal);
     connect(ui->hideRecurringCheckBox, &QCheckBox::stateChanged, proxyModel, &BillsProxyModel::setHideRecurring);
 
-    connect(ui->hideNormalCheckBox, &QCheckBox::stateChanged, this, [&] {
-       emit filteringApplied(ui->searchLineEdit->text(), ui->hideRecurringCheckBox->isChecked(), ui->hideNormalCheckBox->isChecked());
-    });
-    connect(ui->hideRecurringCheckBox, &QCheckBox::stateChanged, this, [&] {
-       emit filteringApplied(ui->searchLineEdit->text(), ui->hideRecurringCheckBox->isChecked(), ui->hideNormalCheckBox->isChecked());
-    });
-    connect(ui->searchLineEdit, &QLineEdit::textChanged, this, [&] {
-       emit filteringApplied(ui->searchLineEdit->text(), ui->hideRecurringCheckBox->isChecked(), ui->hideNormalCheckBox->isChecked());
-    });
-
-    connect(ui->searchLineEdit, &QLineEdit::textChanged, this, [&](const QString &text) {
-        emit filteringApplied(text, ui->hideRecurringCheckBox->isChecked(), ui->hideNormalCheckBox->isChecked());
-    });
-
     ui->billsTableView->setItemDelegateForColumn(2, new CenteredCheckBoxDelegate(this));
 }
 
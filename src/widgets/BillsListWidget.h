@@ -45,7 +45,11 @@ public:
     void resetCheckBoxesAndClearSearch();
 
 signals:
-    void filteringApplied(const QString &fitleringPattern, bool hideRecurrent, bool hideNormal);
+    /*!
+     * \brief This signal is emitted when the bills shown in the table have changed.
+     * \param double total -- sum of amounts in Polish Zlote of the shown bills.
+     */
+    void filteredTotalChanged(double total);
 
 private:
     Ui::BillsListWidget *ui;
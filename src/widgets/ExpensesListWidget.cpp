@@ -7,6 +7,7 @@
 #include "models/ExpensesModel.h"
 #include <QDebug>
 #include <delegates/CenteredCheckBoxDelegate.h>
+#include "FilteringController.h"
 
 ExpensesListWidget::ExpensesListWidget(ExpensesModel *model, QWidget *parent)
     : QWidget(parent)
@@ -23,24 +24,15 @@ ExpensesListWidget::ExpensesListWidget(ExpensesModel *model, QWidget *parent)
     ui->expensesTableView->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
     ui->expensesTableView->setSortingEnabled(true);
 
-    connect(ui->searchLineEdit, &QLineEdit::textChanged, proxyModel, &ExpensesProxyModel::setFilteringPattern);
+    // typing is coalesced and searched in the background, the table is filtered once the rows are found.
+    FilteringController *filteringController = new FilteringController(this);
+    filteringController->setSearchIndexProvider([proxyModel] { return proxyModel->searchIndex(); });
+    connect(ui->searchLineEdit, &QLineEdit::textChanged, filteringController, &FilteringController::setPattern);
+    connect(filteringController, &FilteringController::matchingRowsReady, proxyModel, &ExpensesProxyModel::setMatchingRows);
+    connect(proxyModel, &ExpensesProxyModel::filteredTotalChanged, this, &ExpensesListWidget::filteredTotalChanged);
     connect(ui->hideNormalCheckBox, &QCheckBox::stateChanged, proxyModel, &ExpensesProxyModel::setHideNormal);
     connect(ui->hideRecurringCheckBox, &QCheckBox::stateChanged, proxyModel, &ExpensesProxyModel::setHideRecurring);
 
-    connect(ui->hideNormalCheckBox, &QCheckBox::stateChanged, this, [&] {
-       emit filteringApplied(ui->searchLineEdit->text(), ui->hideRecurringCheckBox->isChecked(), ui->hideNormalCheckBox->isChecked());
-    });
-    connect(ui->hideRecurringCheckBox, &QCheckBox::stateChanged, this, [&] {
-       emit filteringApplied(ui->searchLineEdit->text(), ui->hideRecurringCheckBox->isChecked(), ui->hideNormalCheckBox->isChecked());
-    });
-    connect(ui->searchLineEdit, &QLineEdit::textChanged, this, [&] {
-       emit filteringApplied(ui->searchLineEdit->text(), ui->hideRecurringCheckBox->isChecked(), ui->hideNormalCheckBox->isChecked());
-    });
-
-    connect(ui->searchLineEdit, &QLineEdit::textChanged, this, [&](const QString &text) {
-        emit filteringApplied(text, ui->hideRecurringCheckBox->isChecked(), ui->hideNormalCheckBox->isChecked());
-    });
-
     ui->expensesTableView->setItemDelegateForColumn(4, new CenteredCheckBoxDelegate(this));
 }
 
@@ -0,0 +1,60 @@
+// <copyright company="Scythe Studio Sp. z o.o.">
+//     This file contains proprietary code. Copyright (c) 2021. All rights reserved.
+// </copyright>
+
+#include "FilteringController.h"
+#include <QFutureWatcher>
+#include <QtConcurrent>
+
+#define FILTERING_DELAY 150 // ms, a little longer than a pause between keystrokes.
+
+FilteringController::FilteringController(QObject *parent)
+    : QObject(parent)
+    , m_latestSearch(new QAtomicInt(0))
+{
+    m_delayTimer.setSingleShot(true);
+    m_delayTimer.setInterval(FILTERING_DELAY);
+    connect(&m_delayTimer, &QTimer::timeout, this, &FilteringController::startSearch);
+}
+
+void FilteringController::setSearchIndexProvider(const std::function<SearchIndex()> &searchIndex)
+{
+    m_searchIndex = searchIndex;
+}
+
+void FilteringController::setDelay(int milliseconds)
+{
+    m_delayTimer.setInterval(milliseconds);
+}
+
+void FilteringController::setPattern(const QString &pattern)
+{
+    m_pattern = pattern;
+    m_latestSearch->fetchAndAddOrdered(1); // searches started before are cancelled.
+    m_delayTimer.start();
+}
+
+void FilteringController::startSearch()
+{
+    if (!m_searchIndex) {
+        return;
+    }
+
+    const SearchIndex searchIndex = m_searchIndex();
+    const QString pattern = m_pattern;
+    const QSharedPointer<QAtomicInt> latestSearch = m_latestSearch;
+    const int search = latestSearch->loadAcquire();
+
+    auto *watcher = new QFutureWatcher<QBitArray>(this);
+    connect(watcher, &QFutureWatcher<QBitArray>::finished, this, [=]() {
+        if (search == latestSearch->loadAcquire()) {
+            emit matchingRowsReady(pattern, searchIndex.id(), watcher->result());
+        }
+        watcher->deleteLater();
+    });
+    watcher->setFuture(QtConcurrent::run([=]() {
+        return searchIndex.match(pattern, [latestSearch, search]() {
+            return search != latestSearch->loadAcquire();
+        });
+    }));
+}
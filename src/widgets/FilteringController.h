@@ -0,0 +1,71 @@
+// <copyright company="Scythe Studio Sp. z o.o.">
+//     This file contains proprietary code. Copyright (c) 2021. All rights reserved.
+// </copyright>
+
+#ifndef FILTERINGCONTROLLER_H
+#define FILTERINGCONTROLLER_H
+
+#include <QObject>
+#include <QBitArray>
+#include <QSharedPointer>
+#include <QAtomicInt>
+#include <QTimer>
+#include <functional>
+#include "models/SearchIndex.h"
+
+/*!
+ * \brief Class representing a controller searching rows of a list for a pattern typed by the user.
+ * Patterns typed in a quick succession are coalesced into a single search, run on a worker thread in a copy of the search index.
+ * A search started for a pattern which has been changed in the meantime is cancelled and its result is never applied.
+ */
+class FilteringController : public QObject
+{
+    Q_OBJECT
+public:
+
+    /*!
+     * \brief Constructor.
+     * \param QObject *parent -- parent.
+     */
+    explicit FilteringController(QObject *parent = nullptr);
+
+    /*!
+     * \brief Sets function returning the search index of current rows. It's called on the thread of the controller.
+     * \param const std::function<SearchIndex()> &searchIndex -- function to set.
+     */
+    void setSearchIndexProvider(const std::function<SearchIndex()> &searchIndex);
+
+    /*!
+     * \brief Sets time the pattern has to stay unchanged for before the search starts.
+     * \param int milliseconds -- value to set.
+     */
+    void setDelay(int milliseconds);
+
+public slots:
+
+    /*!
+     * \brief Sets pattern to search for. The search starts once the pattern stops changing.
+     * \param const QString &pattern -- text or a regular expression.
+     */
+    void setPattern(const QString &pattern);
+
+signals:
+
+    /*!
+     * \brief This signal is emitted when rows matching the latest pattern have been found.
+     * \param const QString &pattern -- pattern the rows have been found for.
+     * \param int searchIndexId -- id of the search index the rows have been found in.
+     * \param const QBitArray &rows -- rows matching the pattern.
+     */
+    void matchingRowsReady(const QString &pattern, int searchIndexId, const QBitArray &rows);
+
+private:
+    void startSearch();
+
+    std::function<SearchIndex()> m_searchIndex;
+    QTimer m_delayTimer;
+    QString m_pattern;
+    QSharedPointer<QAtomicInt> m_latestSearch; // shared with running searches, so they notice they are stale.
+};
+
+#endif // FILTERINGCONTROLLER_H
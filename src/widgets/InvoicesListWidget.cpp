@@ -5,6 +5,7 @@
 #include "InvoicesListWidget.h"
 #include "ui_InvoicesListWidget.h"
 #include "models/InvoicesModel.h"
+#include "FilteringController.h"
 
 InvoicesListWidget::InvoicesListWidget(InvoicesModel *model, QWidget *parent)
     : QWidget(parent)
@@ -21,10 +22,12 @@ InvoicesListWidget::InvoicesListWidget(InvoicesModel *model, QWidget *parent)
     ui->invoicesTableView->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
     ui->invoicesTableView->setSortingEnabled(true);
 
-    connect(ui->searchLineEdit, &QLineEdit::textChanged, proxyModel, &InvoicesProxyModel::setFilteringPattern);
-    connect(ui->searchLineEdit, &QLineEdit::textChanged, this, [&](const QString &text) {
-        emit filteringApplied(text);
-    });
+    // typing is coalesced and searched in the background, the table is filtered once the rows are found.
+    FilteringController *filteringController = new FilteringController(this);
+    filteringController->setSearchIndexProvider([proxyModel] { return proxyModel->searchIndex(); });
+    connect(ui->searchLineEdit, &QLineEdit::textChanged, filteringController, &FilteringController::setPattern);
+    connect(filteringController, &FilteringController::matchingRowsReady, proxyModel, &InvoicesProxyModel::setMatchingRows);
+    connect(proxyModel, &InvoicesProxyModel::filteredTotalChanged, this, &InvoicesListWidget::filteredTotalChanged);
 }
 
 void InvoicesListWidget::updatePLNAmountLabel(const QString& text)
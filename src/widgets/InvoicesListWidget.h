@@ -46,7 +46,11 @@ public:
     void clearSearchLine();
 
 signals:
-    void filteringApplied(const QString &fitleringPattern);
+    /*!
+     * \brief This signal is emitted when the invoices shown in the table have changed.
+     * \param double total -- sum of amounts in Polish Zlote of the shown invoices.
+     */
+    void filteredTotalChanged(double total);
 
 private:
     Ui::InvoicesListWidget *ui;
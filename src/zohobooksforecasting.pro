@@ -2,7 +2,7 @@
 #     This file contains proprietary code. Copyright (c) 2021. All rights reserved.
 #</copyright>
 
-QT += core gui charts network
+QT += core gui charts network concurrent
 
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
@@ -17,51 +17,83 @@ VERSION = 1.0.0
 INCLUDEPATH += $$PWD
 
 SOURCES += \
+    HeadlessRunner.cpp \
     MainWindow.cpp \
     datasets/Bill.cpp \
+    datasets/ColumnKernels.cpp \
+    datasets/CompactFields.cpp \
+    datasets/CsvReader.cpp \
     datasets/Expense.cpp \
     datasets/Invoice.cpp \
+    datasets/Recurrence.cpp \
+    datasets/TransactionStore.cpp \
     LogicController.cpp \
     MainWidget.cpp \
     Settings.cpp \
+    SnapshotStore.cpp \
     WebClient.cpp \
     delegates/CenteredCheckBoxDelegate.cpp \
     delegates/DateEditDelegate.cpp \
     main.cpp \
     models/BillsModel.cpp \
+    models/DisplayStringCache.cpp \
     models/ExpensesModel.cpp \
+    models/FilteredTotal.cpp \
     models/ForecastingModel.cpp \
     models/InvoicesModel.cpp \
+    models/SearchIndex.cpp \
+    models/SortKeyCache.cpp \
     plotting/Callout.cpp \
     plotting/CashFlowChart.cpp \
+    plotting/Downsampler.cpp \
+    plotting/ForecastEngine.cpp \
+    plotting/PeriodEngine.cpp \
     plotting/CashFlowView.cpp \
     widgets/AboutDialog.cpp \
     widgets/BillsListWidget.cpp \
     widgets/ExpensesListWidget.cpp \
+    widgets/FilteringController.cpp \
     widgets/ForecastingWidget.cpp \
     widgets/InvoicesListWidget.cpp
 
 HEADERS += \
+    HeadlessRunner.h \
     MainWindow.h \
     datasets/Bill.h \
+    datasets/ColumnKernels.h \
+    datasets/CompactFields.h \
+    datasets/CsvReader.h \
+    datasets/DocumentRange.h \
     datasets/Expense.h \
     datasets/Invoice.h \
+    datasets/JsonFields.h \
+    datasets/Recurrence.h \
+    datasets/TransactionStore.h \
     LogicController.h \
     MainWidget.h \
     Settings.h \
+    SnapshotStore.h \
     WebClient.h \
     delegates/CenteredCheckBoxDelegate.h \
     delegates/DateEditDelegate.h \
     models/BillsModel.h \
+    models/DisplayStringCache.h \
     models/ExpensesModel.h \
+    models/FilteredTotal.h \
     models/ForecastingModel.h \
     models/InvoicesModel.h \
+    models/SearchIndex.h \
+    models/SortKeyCache.h \
     plotting/Callout.h \
     plotting/CashFlowChart.h \
+    plotting/Downsampler.h \
+    plotting/ForecastEngine.h \
+    plotting/PeriodEngine.h \
     plotting/CashFlowView.h \
     widgets/AboutDialog.h \
     widgets/BillsListWidget.h \
     widgets/ExpensesListWidget.h \
+    widgets/FilteringController.h \
     widgets/ForecastingWidget.h \
     widgets/InvoicesListWidget.h
 